@@ -34,6 +34,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+// forward declaration
+class SampledTargetTrajectories;
+
 /**
  * Pre-Computation base class.
  *
@@ -44,6 +47,9 @@ namespace ocs2 {
  * dynamics, cost and constraint terms, which can make use of the shared pre-computation.
  *
  * If pre-computation is not used, a default constructed PreComputation() can be passed to the getters.
+ *
+ * A solver may also attach a view of the target trajectories which is pre-sampled on its nodes, such that the tracking terms can
+ * look up the reference without an interpolation, see SampledTargetTrajectories.
  */
 class PreComputation {
  public:
@@ -65,9 +71,25 @@ class PreComputation {
   /** Request callback at final time */
   virtual void requestFinal(RequestSet request, scalar_t t, const vector_t& x) {}
 
+  /** Sets the pre-sampled view of the target trajectories, which is not owned. Pass nullptr to detach it. */
+  void setSampledTargetTrajectoriesPtr(const SampledTargetTrajectories* sampledTargetTrajectoriesPtr) {
+    sampledTargetTrajectoriesPtr_ = sampledTargetTrajectoriesPtr;
+    sampleHint_ = 0;
+  }
+
+  /** Gets the pre-sampled view of the target trajectories, or nullptr if it is not attached. */
+  const SampledTargetTrajectories* getSampledTargetTrajectoriesPtr() const { return sampledTargetTrajectoriesPtr_; }
+
+  /** Gets the search hint into the pre-sampled view. It is kept here such that each worker searches from its own last lookup. */
+  size_t& getSampleHint() const { return sampleHint_; }
+
  protected:
-  /** Copy constructor */
-  PreComputation(const PreComputation& other) = default;
+  /** Copy constructor. The pre-sampled view of the target trajectories is not copied. */
+  PreComputation(const PreComputation&) {}
+
+ private:
+  const SampledTargetTrajectories* sampledTargetTrajectoriesPtr_ = nullptr;
+  mutable size_t sampleHint_ = 0;
 };
 
 /** Helper to cast to const reference of derived class. */
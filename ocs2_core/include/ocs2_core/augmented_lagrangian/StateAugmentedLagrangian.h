@@ -65,6 +65,9 @@ class StateAugmentedLagrangian final : public StateAugmentedLagrangianInterface
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
                                                                  const PreComputation& preComp) const override;
 
+  bool isLocallyConstant(scalar_t time, const vector_t& constraint, const Multiplier& multiplier) const override;
+  bool hasLocallyConstantRegion() const override;
+
   std::pair<Multiplier, scalar_t> updateLagrangian(scalar_t time, const vector_t& state, const vector_t& constraint,
                                                    const Multiplier& multiplier) const override;
 
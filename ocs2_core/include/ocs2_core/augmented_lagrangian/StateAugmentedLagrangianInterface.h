@@ -58,6 +58,15 @@ class StateAugmentedLagrangianInterface {
   virtual ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const Multiplier& multiplier,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Checks whether the penalty is locally constant at the given constraint value, i.e., its derivatives vanish. Such terms
+   * contribute only their value to the quadratic approximation and the constraint derivatives can be skipped.
+   */
+  virtual bool isLocallyConstant(scalar_t time, const vector_t& constraint, const Multiplier& multiplier) const { return false; }
+
+  /** Whether isLocallyConstant() can return true, i.e., whether the value-only activity check is worth evaluating. */
+  virtual bool hasLocallyConstantRegion() const { return false; }
+
   /** Update Lagrange/penalty multipliers and the penalty function value. */
   virtual std::pair<Multiplier, scalar_t> updateLagrangian(scalar_t time, const vector_t& state, const vector_t& constraint,
                                                            const Multiplier& multiplier) const = 0;
@@ -62,6 +62,23 @@ class StateInputAugmentedLagrangianCollection : public Collection<StateInputAugm
                                                                          const std::vector<Multiplier>& termsMultiplier,
                                                                          const PreComputation& preComp) const;
 
+  /**
+   * Get the sum of state-input Lagrangian penalties quadratic approximation, reusing the metrics of the terms evaluated at the same
+   * time, state, input, and multipliers (e.g., by computing the problem metrics). The terms whose penalty is locally constant at their
+   * metrics contribute only their penalty value, such that neither their constraint nor its derivatives are evaluated again.
+   */
+  virtual ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                         const std::vector<Multiplier>& termsMultiplier,
+                                                                         const std::vector<LagrangianMetrics>& termsMetrics,
+                                                                         const PreComputation& preComp) const;
+
+  /**
+   * Counts the active terms whose penalty is locally constant at the given metrics (their derivatives are skipped by
+   * getQuadraticApproximation with metrics) and the ones which are fully evaluated. The counts are accumulated into the outputs.
+   */
+  void countLocallyConstantTerms(scalar_t time, const std::vector<LagrangianMetrics>& termsMetrics,
+                                 const std::vector<Multiplier>& termsMultiplier, size_t& numLocallyConstant, size_t& numEvaluated) const;
+
   /** Update Lagrange/penalty multipliers and the penalty value for each active term. */
   virtual void updateLagrangian(scalar_t time, const vector_t& state, const vector_t& input, std::vector<LagrangianMetrics>& termsMetrics,
                                 std::vector<Multiplier>& termsMultiplier) const;
@@ -57,7 +57,14 @@ class QuadraticStateCost : public StateCost {
   QuadraticStateCost(const QuadraticStateCost& rhs) = default;
 
   /** Computes the state deviation for the nominal state.
-   * This method can be overwritten if desiredTrajectory has a different dimensions. */
+   * This method can be overwritten if desiredTrajectory has a different dimensions.
+   * The preComputation may carry a view of the target trajectories which is pre-sampled on the solver's nodes. The default forwards
+   * to the deprecated variant below if this is a derived class, since the derived class may override that one instead. */
+  virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                     const PreComputation& preComputation) const;
+
+  /** Computes the state deviation for the nominal state by interpolating the target trajectories.
+   * @deprecated Override the variant with the PreComputation instead. */
   virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const;
 
  private:
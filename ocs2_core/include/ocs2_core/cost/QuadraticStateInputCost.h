@@ -62,7 +62,15 @@ class QuadraticStateInputCost : public StateInputCost {
   QuadraticStateInputCost(const QuadraticStateInputCost& rhs) = default;
 
   /** Computes the state-input deviation pair around the nominal state and input.
-   * This method can be overwritten if desiredTrajectory has a different dimensions. */
+   * This method can be overwritten if desiredTrajectory has a different dimensions.
+   * The preComputation may carry a view of the target trajectories which is pre-sampled on the solver's nodes. The default forwards
+   * to the deprecated variant below if this is a derived class, since the derived class may override that one instead. */
+  virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                               const TargetTrajectories& targetTrajectories,
+                                                               const PreComputation& preComputation) const;
+
+  /** Computes the state-input deviation pair around the nominal state and input by interpolating the target trajectories.
+   * @deprecated Override the variant with the PreComputation instead. */
   virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                const TargetTrajectories& targetTrajectories) const;
 
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 #include <ocs2_core/automatic_differentiation/Types.h>
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
 
 namespace ocs2 {
 
@@ -63,6 +64,38 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
   void initialize(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
                   bool recompileLibraries = true, bool verbose = true);
 
+  /**
+   * Generates the discretized flow map x_{k+1} = F(t_k, x_k, u_k, dt) of an explicit integration scheme and its sensitivities as a
+   * single model. This replaces the stage-wise linearizations and their chaining in the sensitivity discretization. The function
+   * must be called after initialize(). The flow map parameters are evaluated once at the start of the interval.
+   *
+   * @param integratorType : integration scheme of the discretization.
+   * @param modelName : name of the generate model library
+   * @param modelFolder : folder to save the model library files to
+   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param verbose : print information.
+   */
+  void initializeDiscreteFlowMap(SensitivityIntegratorType integratorType, const std::string& modelName,
+                                 const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
+
+  /** Whether the discretized flow map of the given integration scheme is generated. */
+  bool hasDiscreteFlowMap(SensitivityIntegratorType integratorType) const {
+    return discreteFlowMapADInterfacePtr_ != nullptr && discreteFlowMapIntegratorType_ == integratorType;
+  }
+
+  /**
+   * Computes the generated discretized flow map.
+   * @note This method updates the internal preComputation with the request() callback.
+   */
+  vector_t computeDiscreteFlowMap(scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+  /**
+   * Computes the linear approximation of the generated discretized flow map, i.e., x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}.
+   * The value and the sensitivities are obtained from a single evaluation of the generated Jacobian.
+   * @note This method updates the internal preComputation with the request() callback.
+   */
+  VectorFunctionLinearApproximation discreteFlowMapLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComputation) final;
 
   vector_t computeJumpMap(scalar_t t, const vector_t& x, const PreComputation& preComputation) final;
@@ -171,8 +204,11 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
   std::unique_ptr<CppAdInterface> flowMapADInterfacePtr_;
   std::unique_ptr<CppAdInterface> jumpMapADInterfacePtr_;
   std::unique_ptr<CppAdInterface> guardSurfacesADInterfacePtr_;
+  std::unique_ptr<CppAdInterface> discreteFlowMapADInterfacePtr_;
+  SensitivityIntegratorType discreteFlowMapIntegratorType_ = SensitivityIntegratorType::EULER;
 
   vector_t tapedTimeStateInput_;
+  vector_t tapedTimeStepStateInput_;
   vector_t tapedTimeState_;
 
   /** Cached jacobians for time derivative */
@@ -0,0 +1,169 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <Eigen/LU>
+
+#include <ocs2_core/integration/IntegratorBase.h>
+
+namespace ocs2 {
+
+/**
+ * Fixed-step Runge-Kutta integrator with explicit (Euler, RK4) and implicit (midpoint rule) schemes.
+ *
+ * In contrast to the boost odeint based integrators, the flow map of the OdeBase is called directly from a templated stepping loop
+ * instead of through std::function wrappers. The stage vectors are members of the integrator, such that they are only allocated
+ * when the state dimension changes. The observer storage is reserved based on the number of steps before integrating.
+ *
+ * The adaptive and the time-stamp based integration take fixed steps of size dtInitial and shorten the last step of each interval,
+ * which matches the behavior of the uncontrolled boost odeint steppers.
+ *
+ * The implicit midpoint rule is A-stable and allows step sizes far beyond the stability limit of the explicit schemes for stiff systems.
+ * Note that it is not L-stable: very fast modes stay bounded but are only weakly damped. Since OdeBase only provides the flow map, its
+ * stage equation is solved with simplified Newton iterations on a forward difference Jacobian that is evaluated once per step, and again
+ * at the stage state whenever the residual does not contract. A step without such a refresh costs (stateDim + 2) flow map evaluations
+ * plus one per Newton iteration. If the stage equation is not solved within the maximum number of iterations, the step throws a
+ * std::runtime_error instead of returning an unconverged state.
+ */
+class FixedStepIntegrator : public IntegratorBase {
+ public:
+  /** The Runge-Kutta schemes supported by this integrator. */
+  enum class Scheme { EULER, RK4, IMPLICIT_MIDPOINT };
+
+  /**
+   * Constructor
+   * @param [in] scheme: The Runge-Kutta scheme.
+   * @param [in] eventHandlerPtr: The integration event function.
+   */
+  explicit FixedStepIntegrator(Scheme scheme, std::shared_ptr<SystemEventHandler> eventHandlerPtr = nullptr)
+      : IntegratorBase(std::move(eventHandlerPtr)), scheme_(scheme) {}
+
+  ~FixedStepIntegrator() override = default;
+
+  void integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                      scalar_t dt, int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  void integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime, scalar_t finalTime,
+                         scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
+                         int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  void integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
+                      typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                      scalar_t dtInitial = 0.01, scalar_t AbsTol = 1e-6, scalar_t RelTol = 1e-3,
+                      int maxNumSteps = std::numeric_limits<int>::max()) override;
+
+  /**
+   * Takes a single step of the scheme in-place, without observation and event handling. This allows to advance many states on a
+   * common time grid.
+   *
+   * @param [in] system: System dynamics.
+   * @param [in] t: Current time.
+   * @param [in] dt: Step size.
+   * @param [in,out] x: Current state, replaced by the next state.
+   */
+  void integrateStep(OdeBase& system, scalar_t t, scalar_t dt, vector_t& x);
+
+ private:
+  void runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                         scalar_t finalTime, scalar_t dt) override;
+
+  void runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState, scalar_t startTime,
+                            scalar_t finalTime, scalar_t dtInitial, scalar_t AbsTol, scalar_t RelTol) override;
+
+  void runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                         typename scalar_array_t::const_iterator beginTimeItr, typename scalar_array_t::const_iterator endTimeItr,
+                         scalar_t dtInitial, scalar_t AbsTol, scalar_t RelTol) override;
+
+  /**
+   * Equidistant steps from startTime while the next step does not pass finalTime. The state is observed before each step and at the
+   * end. This matches boost::numeric::odeint::integrate_const for simple steppers.
+   *
+   * @tparam SystemFunc: Callable with signature void(const vector_t& x, vector_t& dxdt, scalar_t t).
+   * @tparam ObserverFunc: Callable with signature void(const vector_t& x, scalar_t t).
+   * @param [in] system: System function.
+   * @param [in] observer: Observer callback.
+   * @param [in,out] x: Initial state, replaced by the state at the returned time.
+   * @param [in] startTime: Initial time.
+   * @param [in] finalTime: Final time.
+   * @param [in] dt: Time step.
+   * @return The time of the last observation.
+   */
+  template <typename SystemFunc, typename ObserverFunc>
+  scalar_t constSteps(SystemFunc& system, ObserverFunc& observer, vector_t& x, scalar_t startTime, scalar_t finalTime, scalar_t dt);
+
+  /**
+   * Integrates through the given time stamps with steps of at most dt and observes the state only at the time stamps.
+   *
+   * @tparam SystemFunc: Callable with signature void(const vector_t& x, vector_t& dxdt, scalar_t t).
+   * @tparam ObserverFunc: Callable with signature void(const vector_t& x, scalar_t t).
+   * @param [in] system: System function.
+   * @param [in] observer: Observer callback.
+   * @param [in,out] x: Initial state, replaced by the state at the last time stamp.
+   * @param [in] beginTimeItr: The iterator to the beginning of the time stamp trajectory.
+   * @param [in] endTimeItr: The iterator to the end of the time stamp trajectory.
+   * @param [in] dt: Maximum time step.
+   */
+  template <typename SystemFunc, typename ObserverFunc>
+  void timeStampSteps(SystemFunc& system, ObserverFunc& observer, vector_t& x, typename scalar_array_t::const_iterator beginTimeItr,
+                      typename scalar_array_t::const_iterator endTimeItr, scalar_t dt);
+
+  /**
+   * Performs one step of the scheme in-place.
+   *
+   * @param [in] system: System function.
+   * @param [in] t: Current time.
+   * @param [in] dt: Step size.
+   * @param [in,out] x: Current state, replaced by the next state.
+   */
+  template <typename SystemFunc>
+  void step(SystemFunc& system, scalar_t t, scalar_t dt, vector_t& x);
+
+  /**
+   * Computes and factorizes the Newton matrix Id - dt/2 * dfdx of the implicit midpoint step with forward differences at xStage_.
+   *
+   * @param [in] system: System function.
+   * @param [in] midTime: The time of the stage.
+   * @param [in] halfDt: Half of the step size.
+   * @note k2_ must hold the flow map at xStage_, and k3_ is overwritten.
+   */
+  template <typename SystemFunc>
+  void updateNewtonMatrix(SystemFunc& system, scalar_t midTime, scalar_t halfDt);
+
+  Scheme scheme_;
+
+  /** Preallocated stage derivatives and intermediate state of the Runge-Kutta step. */
+  vector_t k1_, k2_, k3_, k4_, xStage_;
+
+  /** Preallocated Newton matrix and its factorization of the implicit step. */
+  matrix_t newtonMatrix_;
+  Eigen::PartialPivLU<matrix_t> newtonMatrixLu_;
+};
+
+}  // namespace ocs2
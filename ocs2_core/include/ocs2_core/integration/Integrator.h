@@ -49,7 +49,10 @@ enum class IntegratorType {
   MODIFIED_MIDPOINT,
   RK4,
   RK5_VARIABLE,
-  ADAMS_BASHFORTH_MOULTON
+  ADAMS_BASHFORTH_MOULTON,
+  EULER_OCS2,
+  RK4_OCS2,
+  IMPLICIT_MIDPOINT_OCS2
 };
 
 namespace integrator_type {
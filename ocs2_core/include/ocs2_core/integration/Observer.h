@@ -58,6 +58,12 @@ class Observer {
    */
   void observe(const vector_t& state, scalar_t time);
 
+  /**
+   * Reserves storage for a number of additional observations such that observe() does not reallocate the containers.
+   * @param [in] numObservations: Expected number of additional observations.
+   */
+  void reserve(size_t numObservations);
+
  private:
   scalar_array_t* timeTrajectoryPtr_;
   vector_array_t* stateTrajectoryPtr_;
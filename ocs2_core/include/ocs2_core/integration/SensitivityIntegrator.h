@@ -34,7 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
-enum class SensitivityIntegratorType { EULER, RK2, RK4 };
+enum class SensitivityIntegratorType { EULER, RK2, RK4, IMPLICIT_MIDPOINT };
 
 namespace sensitivity_integrator {
 
@@ -64,7 +64,8 @@ SensitivityIntegratorType fromString(const std::string& name);
 using DynamicsDiscretizer = std::function<vector_t(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t)>;
 
 /**
- * Select available integrator based on enum
+ * Select available integrator based on enum. For a SystemDynamicsBaseAD with a generated discrete flow map of the same
+ * integrator type, the generated model is evaluated instead.
  */
 DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integratorType);
 
@@ -83,7 +84,8 @@ using DynamicsSensitivityDiscretizer =
     std::function<VectorFunctionLinearApproximation(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t)>;
 
 /**
- * Select available integrator based on enum
+ * Select available integrator based on enum. For a SystemDynamicsBaseAD with a generated discrete flow map of the same
+ * integrator type, the generated model and its Jacobian are evaluated instead.
  */
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType);
 
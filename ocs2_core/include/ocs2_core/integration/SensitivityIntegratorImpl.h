@@ -76,4 +76,23 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Computes the discretized dynamics. Uses the implicit midpoint rule, which is A-stable and therefore remains stable for stiff
+ * dynamics at step sizes where the explicit schemes diverge. The stage equation k = f(t + dt/2, x + dt/2 * k, u) is solved with
+ * Newton iterations based on the Jacobians of the system's linearApproximation. Throws std::runtime_error if they do not converge.
+ * Returns x_{k+1} = x_{k} + dt * k
+ */
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses the implicit midpoint rule.
+ * The sensitivities follow from the implicit function theorem at the converged stage:
+ *      A_{k} = Id + dt * (Id - dt/2 * dfdx)^{-1} * dfdx
+ *      B_{k} = dt * (Id - dt/2 * dfdx)^{-1} * dfdu
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt);
+
 }  // namespace ocs2
\ No newline at end of file
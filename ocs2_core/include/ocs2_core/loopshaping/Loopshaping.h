@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <ocs2_core/loopshaping/LoopshapingApproximation.h>
 #include <ocs2_core/loopshaping/LoopshapingDefinition.h>
 #include <ocs2_core/loopshaping/LoopshapingPreComputation.h>
 #include <ocs2_core/loopshaping/LoopshapingPropertyTree.h>
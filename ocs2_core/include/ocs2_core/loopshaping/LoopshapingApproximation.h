@@ -0,0 +1,64 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/loopshaping/LoopshapingDefinition.h>
+
+namespace ocs2 {
+namespace loopshaping {
+
+/**
+ * Transforms the quadratic approximation of a scalar function of the system state and input to the augmented state and input of
+ * the eliminate pattern, where the system input is u = C * x_filter + D * v. Only the blocks depending on the system approximation
+ * are computed. For diagonal filters, C and D are applied as row and column scalings.
+ *
+ * @param [in] definition: The loopshaping definition.
+ * @param [in] L_system: The quadratic approximation w.r.t. the system state and input.
+ * @param [out] L: The quadratic approximation w.r.t. the augmented state and input. Its memory is reused if it has the correct size.
+ */
+void eliminatePatternQuadraticApproximation(const LoopshapingDefinition& definition, const ScalarFunctionQuadraticApproximation& L_system,
+                                            ScalarFunctionQuadraticApproximation& L);
+
+/**
+ * Transforms the linear approximation of a vector function of the system state and input to the augmented state and input of the
+ * eliminate pattern, i.e., dfdx = [dfdx_system, dfdu_system * C] and dfdu = dfdu_system * D.
+ *
+ * @param [in] definition: The loopshaping definition.
+ * @param [in] dfdx_system: The derivative w.r.t. the system state.
+ * @param [in] dfdu_system: The derivative w.r.t. the system input.
+ * @param [out] dfdx: The derivative w.r.t. the augmented state. Its memory is reused if it has the correct size.
+ * @param [out] dfdu: The derivative w.r.t. the augmented input. Its memory is reused if it has the correct size.
+ */
+void eliminatePatternLinearApproximation(const LoopshapingDefinition& definition, const matrix_t& dfdx_system, const matrix_t& dfdu_system,
+                                         matrix_t& dfdx, matrix_t& dfdu);
+
+}  // namespace loopshaping
+}  // namespace ocs2
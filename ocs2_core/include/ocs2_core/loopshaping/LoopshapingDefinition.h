@@ -69,7 +69,15 @@ class LoopshapingDefinition {
   scalar_t loopshapingCost(const vector_t& filteredInput) const { return 0.5 * filteredInput.dot(R_ * filteredInput); }
 
   /** Get the quadratic cost matrix for the filtered inputs */
-  matrix_t& costMatrix() { return R_; }
+  const matrix_t& costMatrix() const { return R_; }
+
+  /**
+   * Get the constant Hessian blocks of the filtered input cost w.r.t. the filter state and the input through the filter output
+   * y = C * x_filter + D * u, i.e., C' * R * C, D' * R * C, and D' * R * D. They are computed once at construction.
+   */
+  const matrix_t& costMatrixFilterStateFilterState() const { return CtRC_; }
+  const matrix_t& costMatrixInputFilterState() const { return DtRC_; }
+  const matrix_t& costMatrixInputInput() const { return DtRD_; }
 
   /** Display details of the LoopshapingDefinition  */
   void print() const;
@@ -148,6 +156,7 @@ class LoopshapingDefinition {
   LoopshapingType loopshapingType_;
   bool diagonal_;
   matrix_t R_;
+  matrix_t CtRC_, DtRC_, DtRD_;
 };
 
 }  // namespace ocs2
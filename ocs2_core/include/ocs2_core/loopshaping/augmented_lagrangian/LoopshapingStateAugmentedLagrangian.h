@@ -55,6 +55,14 @@ class LoopshapingStateAugmentedLagrangian final : public StateAugmentedLagrangia
                                                                  const std::vector<Multiplier>& termsMultiplier,
                                                                  const PreComputation& preComp) const override;
 
+  /** The metrics are of the system state, therefore all the terms are evaluated on the loopshaping state. */
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& x,
+                                                                 const std::vector<Multiplier>& termsMultiplier,
+                                                                 const std::vector<LagrangianMetrics>& termsMetrics,
+                                                                 const PreComputation& preComp) const override {
+    return getQuadraticApproximation(t, x, termsMultiplier, preComp);
+  }
+
   void updateLagrangian(scalar_t t, const vector_t& x, std::vector<LagrangianMetrics>& termsMetrics,
                         std::vector<Multiplier>& termsMultiplier) const override;
 
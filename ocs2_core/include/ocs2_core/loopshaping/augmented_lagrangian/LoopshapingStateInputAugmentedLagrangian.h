@@ -46,6 +46,16 @@ class LoopshapingStateInputAugmentedLagrangian : public StateInputAugmentedLagra
   std::vector<LagrangianMetrics> getValue(scalar_t t, const vector_t& x, const vector_t& u, const std::vector<Multiplier>& termsMultiplier,
                                           const PreComputation& preComp) const final override;
 
+  using StateInputAugmentedLagrangianCollection::getQuadraticApproximation;
+
+  /** The metrics are of the system state and input, therefore all the terms are evaluated by the loopshaping pattern. */
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                 const std::vector<Multiplier>& termsMultiplier,
+                                                                 const std::vector<LagrangianMetrics>& termsMetrics,
+                                                                 const PreComputation& preComp) const final override {
+    return getQuadraticApproximation(t, x, u, termsMultiplier, preComp);
+  }
+
   void updateLagrangian(scalar_t t, const vector_t& x, const vector_t& u, std::vector<LagrangianMetrics>& termsMetrics,
                         std::vector<Multiplier>& termsMultiplier) const final override;
 
@@ -160,6 +160,23 @@ void computeConstraintProjection(const matrix_t& Dm, const DerivedInputMatrix& R
   computeConstraintProjection(Dm, matrix_t(RmInvUmUmT), DmDagger, DmDaggerTRmDmDaggerUUT, RmInvConstrainedUUT);
 }
 
+/**
+ * Accumulates the weighted Gram terms of a vector-valued function h(x, u) with the linear approximation (dhdx, dhdu):
+ *   dfdx += dhdx^T * w,  dfdu += dhdu^T * w,
+ *   dfdxx += dhdx^T * diag(W) * dhdx,  dfdux += dhdu^T * diag(W) * dhdx,  dfduu += dhdu^T * diag(W) * dhdu.
+ *
+ * The symmetric blocks are computed with rank-k updates of their lower triangles, and the rows with zero Hessian weight
+ * (e.g., inactive inequality constraints) are skipped. The value f of the accumulator is not modified.
+ *
+ * @param [in] dhdx: The state derivative of h.
+ * @param [in] dhdu: The input derivative of h. In the state-only case, it should have zero columns.
+ * @param [in] gradientWeights: The weights w of the gradient terms.
+ * @param [in] hessianWeights: The diagonal weights W of the Hessian terms.
+ * @param [in, out] accumulator: The quadratic approximation to add the terms to. It should be correctly sized and its Hessians symmetric.
+ */
+void accumulateWeightedGram(const matrix_t& dhdx, const matrix_t& dhdu, const vector_t& gradientWeights, const vector_t& hessianWeights,
+                            ScalarFunctionQuadraticApproximation& accumulator);
+
 /** Computes the rank of a matrix */
 template <typename Derived>
 int rank(const Derived& A) {
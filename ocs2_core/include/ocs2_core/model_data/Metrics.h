@@ -62,6 +62,8 @@ struct LagrangianMetricsConstRef {
  * stateIneqLagrangian : An array of state inequality constraint terms handled by Lagrangian method.
  * stateInputEqLagrangian : An array of state-input equality constraint terms handled by Lagrangian method.
  * stateInputIneqLagrangian : An array of state-input inequality constraint terms handled by Lagrangian method.
+ * numSkippedIneqTerms : The number of active inequality terms whose penalty is locally constant, i.e., their derivatives are skipped.
+ * numEvaluatedIneqTerms : The number of active inequality terms whose derivatives are evaluated.
  */
 struct MetricsCollection {
   // Cost
@@ -77,6 +79,10 @@ struct MetricsCollection {
   std::vector<LagrangianMetrics> stateInputEqLagrangian;
   std::vector<LagrangianMetrics> stateInputIneqLagrangian;
 
+  // Inequality active-set statistics
+  size_t numSkippedIneqTerms = 0;
+  size_t numEvaluatedIneqTerms = 0;
+
   /** Exchanges the values of MetricsCollection */
   void swap(MetricsCollection& other) {
     // Cost
@@ -89,6 +95,9 @@ struct MetricsCollection {
     stateIneqLagrangian.swap(other.stateIneqLagrangian);
     stateInputEqLagrangian.swap(other.stateInputEqLagrangian);
     stateInputIneqLagrangian.swap(other.stateInputIneqLagrangian);
+    // Inequality active-set statistics
+    std::swap(numSkippedIneqTerms, other.numSkippedIneqTerms);
+    std::swap(numEvaluatedIneqTerms, other.numEvaluatedIneqTerms);
   }
 
   /** Clears the value of the MetricsCollection */
@@ -103,6 +112,9 @@ struct MetricsCollection {
     stateIneqLagrangian.clear();
     stateInputEqLagrangian.clear();
     stateInputIneqLagrangian.clear();
+    // Inequality active-set statistics
+    numSkippedIneqTerms = 0;
+    numEvaluatedIneqTerms = 0;
   }
 };
 
@@ -0,0 +1,164 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+#include "ocs2_core/misc/LinearInterpolation.h"
+#include "ocs2_core/model_data/Multiplier.h"
+
+namespace ocs2 {
+
+/**
+ * A trajectory of MultiplierCollections packed in one contiguous buffer.
+ *
+ * Each node is stored in the serialized format of toVector() for its stateEq, stateIneq, stateInputEq and stateInputIneq terms,
+ * one after another. The term sizes and offsets of a node are described by a Layout, which is computed once and shared by all the
+ * nodes with the same constraint structure (typically all the nodes of a mode). This allows zero-copy access to the multipliers of
+ * a node, interpolation of two nodes with a single pass over their packed data, and shifting the trajectory with one memmove.
+ */
+class MultiplierTrajectory {
+ public:
+  /** The constraint term types of a MultiplierCollection in their packing order. */
+  enum class TermType : size_t { StateEq = 0, StateIneq = 1, StateInputEq = 2, StateInputIneq = 3 };
+  static constexpr size_t numTermTypes = 4;
+
+  /** The sizes and offsets of the constraint terms of a packed MultiplierCollection. */
+  struct Layout {
+    explicit Layout(const MultiplierCollection& multiplierCollection);
+
+    /** Whether the given MultiplierCollection has the same term sizes as this layout. */
+    bool hasSameSizes(const MultiplierCollection& multiplierCollection) const;
+
+    /** The lagrangian size of each term per term type. */
+    std::array<size_array_t, numTermTypes> termSizes;
+    /** The offset of the penalty of each term per term type, w.r.t. the beginning of the node. The lagrangian follows the penalty. */
+    std::array<size_array_t, numTermTypes> termOffsets;
+    /** The packed size of the node. */
+    size_t size = 0;
+  };
+
+  /** Default constructor */
+  MultiplierTrajectory() = default;
+
+  /** Constructor which packs a trajectory of MultiplierCollections */
+  explicit MultiplierTrajectory(const std::vector<MultiplierCollection>& multiplierCollectionTrajectory);
+
+  /** Number of nodes. */
+  size_t size() const { return nodeOffsets_.size(); }
+
+  /** Whether the trajectory is empty. */
+  bool empty() const { return nodeOffsets_.empty(); }
+
+  /** Clears the trajectory while keeping the allocated memory. */
+  void clear();
+
+  /** Repacks a trajectory of MultiplierCollections while reusing the allocated memory. */
+  void assign(const std::vector<MultiplierCollection>& multiplierCollectionTrajectory);
+
+  /**
+   * Reserves memory.
+   *
+   * @param [in] numNodes: The number of nodes.
+   * @param [in] bufferSize: The total packed size of the nodes.
+   */
+  void reserve(size_t numNodes, size_t bufferSize);
+
+  /** Packs a MultiplierCollection at the end of the trajectory. */
+  void push_back(const MultiplierCollection& multiplierCollection);
+
+  /** The layout of a node. */
+  const Layout& layout(size_t index) const { return layouts_[nodeLayoutIndices_[index]]; }
+
+  /** Zero-copy view of the packed multipliers of a node. */
+  Eigen::Map<const vector_t> node(size_t index) const { return {buffer_.data() + nodeOffsets_[index], nodeSize(index)}; }
+  Eigen::Map<vector_t> node(size_t index) { return {buffer_.data() + nodeOffsets_[index], nodeSize(index)}; }
+
+  /** The penalty of a constraint term at a node. */
+  scalar_t penalty(size_t index, TermType type, size_t termIndex) const {
+    return buffer_[nodeOffsets_[index] + layout(index).termOffsets[static_cast<size_t>(type)][termIndex]];
+  }
+
+  /** Zero-copy view of the Lagrange multiplier of a constraint term at a node. */
+  Eigen::Map<const vector_t> lagrangian(size_t index, TermType type, size_t termIndex) const {
+    const auto& l = layout(index);
+    const auto t = static_cast<size_t>(type);
+    return {buffer_.data() + nodeOffsets_[index] + l.termOffsets[t][termIndex] + 1, static_cast<Eigen::Index>(l.termSizes[t][termIndex])};
+  }
+
+  /**
+   * Unpacks a node. The memory of the output is reused if the term sizes match.
+   *
+   * @param [in] index: The node index.
+   * @param [out] multiplierCollection: The MultiplierCollection of the node.
+   */
+  void get(size_t index, MultiplierCollection& multiplierCollection) const;
+
+  /** Unpacks a node. */
+  MultiplierCollection get(size_t index) const {
+    MultiplierCollection multiplierCollection;
+    get(index, multiplierCollection);
+    return multiplierCollection;
+  }
+
+  /**
+   * Linearly interpolates the trajectory. If the two nodes have the same layout, their packed data is interpolated in one pass.
+   * Otherwise, it snaps to the nearest node, consistent with LinearInterpolation::interpolate of MultiplierCollections. The memory
+   * of the output is reused if the term sizes match.
+   *
+   * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair.
+   * @param [out] multiplierCollection: The interpolated MultiplierCollection.
+   */
+  void interpolate(const LinearInterpolation::index_alpha_t& indexAlpha, MultiplierCollection& multiplierCollection) const;
+
+  /**
+   * Removes the first nodes of the trajectory, e.g. to shift a warm start in MPC. The remaining packed data is moved to the front
+   * of the buffer with a single memmove and no reallocation.
+   *
+   * @param [in] numNodes: The number of nodes to remove.
+   */
+  void shift(size_t numNodes);
+
+ private:
+  Eigen::Index nodeSize(size_t index) const { return static_cast<Eigen::Index>(layout(index).size); }
+
+  /** Unpacks alpha * lhs + (1 - alpha) * rhs where lhs and rhs are packed nodes with the given layout. */
+  static void unpack(const Layout& layout, const scalar_t* lhs, const scalar_t* rhs, scalar_t alpha,
+                     MultiplierCollection& multiplierCollection);
+
+  std::vector<scalar_t> buffer_;
+  size_array_t nodeOffsets_;
+  size_array_t nodeLayoutIndices_;
+  std::vector<Layout> layouts_;
+};
+
+}  // namespace ocs2
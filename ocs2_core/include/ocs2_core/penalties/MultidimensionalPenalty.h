@@ -103,6 +103,18 @@ class MultidimensionalPenalty final {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t t, const VectorFunctionQuadraticApproximation& h,
                                                                  const vector_t* l = nullptr) const;
 
+  /**
+   * Checks whether the penalty of all the constraints is locally constant, i.e., the derivatives of the penalty vanish.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] h: Vector of inequality constraint values.
+   * @return true if the penalty is locally constant.
+   */
+  bool isLocallyConstant(scalar_t t, const vector_t& h, const vector_t* l = nullptr) const;
+
+  /** Whether the penalty can be locally constant for some constraint values. */
+  bool hasLocallyConstantRegion() const;
+
   /**
    * Updates the Lagrange multipliers.
    *
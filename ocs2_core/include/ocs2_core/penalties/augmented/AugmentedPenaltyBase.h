@@ -85,6 +85,62 @@ class AugmentedPenaltyBase {
    */
   virtual scalar_t getSecondDerivative(scalar_t t, scalar_t l, scalar_t h) const = 0;
 
+  /**
+   * Checks whether the penalty is locally constant at a certain constraint value, i.e., its derivatives vanish in a neighborhood of h.
+   * This allows skipping the constraint derivatives of inactive inequality constraints. The default implementation returns false.
+   *
+   * @param [in] t: The time that the constraint is evaluated.
+   * @param [in] l: The Lagrange multiplier.
+   * @param [in] h: Constraint value.
+   * @return true if the penalty is locally constant.
+   */
+  virtual bool isLocallyConstant(scalar_t t, scalar_t l, scalar_t h) const { return false; }
+
+  /** Whether isLocallyConstant() can return true for any constraint value. */
+  virtual bool hasLocallyConstantRegion() const { return false; }
+
+  /**
+   * Compute the sum of the penalty values for a vector of constraint values.
+   * The default implementation calls getValue() per element. Penalties with a closed form override it with an array expression.
+   *
+   * @param [in] t: The time that the constraints are evaluated.
+   * @param [in] l: The Lagrange multipliers. If it is nullptr, the multipliers are zero.
+   * @param [in] h: Constraint values.
+   * @return sum of the penalty costs.
+   */
+  virtual scalar_t getTotalValue(scalar_t t, const vector_t* l, const vector_t& h) const {
+    scalar_t penalty = 0.0;
+    for (int i = 0; i < h.size(); i++) {
+      penalty += getValue(t, (l == nullptr) ? 0.0 : (*l)(i), h(i));
+    }
+    return penalty;
+  }
+
+  /**
+   * Compute the sum of the penalty values and the element-wise first and second derivatives for a vector of constraint values.
+   * The default implementation calls the scalar methods per element. Penalties with a closed form override it with array expressions.
+   *
+   * @param [in] t: The time that the constraints are evaluated.
+   * @param [in] l: The Lagrange multipliers. If it is nullptr, the multipliers are zero.
+   * @param [in] h: Constraint values.
+   * @param [out] derivative: The penalty derivatives with respect to the constraint values.
+   * @param [out] secondDerivative: The penalty second derivatives with respect to the constraint values.
+   * @return sum of the penalty costs.
+   */
+  virtual scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t* l, const vector_t& h, vector_t& derivative,
+                                             vector_t& secondDerivative) const {
+    derivative.resize(h.size());
+    secondDerivative.resize(h.size());
+    scalar_t penalty = 0.0;
+    for (int i = 0; i < h.size(); i++) {
+      const scalar_t li = (l == nullptr) ? 0.0 : (*l)(i);
+      penalty += getValue(t, li, h(i));
+      derivative(i) = getDerivative(t, li, h(i));
+      secondDerivative(i) = getSecondDerivative(t, li, h(i));
+    }
+    return penalty;
+  }
+
   /**
    * Updates the Lagrange multiplier.
    *
@@ -84,6 +84,20 @@ class QuadraticPenalty final : public AugmentedPenaltyBase {
   scalar_t getDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return -l + config_.scale * h; }
   scalar_t getSecondDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return config_.scale; }
 
+  scalar_t getTotalValue(scalar_t t, const vector_t* l, const vector_t& h) const override {
+    const scalar_t penalty = 0.5 * config_.scale * h.squaredNorm();
+    return (l == nullptr) ? penalty : penalty - l->dot(h);
+  }
+  scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t* l, const vector_t& h, vector_t& derivative,
+                                     vector_t& secondDerivative) const override {
+    derivative.noalias() = config_.scale * h;
+    if (l != nullptr) {
+      derivative -= *l;
+    }
+    secondDerivative.setConstant(h.size(), config_.scale);
+    return getTotalValue(t, l, h);
+  }
+
   scalar_t updateMultiplier(scalar_t t, scalar_t l, scalar_t h) const override { return l - config_.stepSize * config_.scale * h; }
   scalar_t initializeMultiplier() const override { return 0.0; }
 
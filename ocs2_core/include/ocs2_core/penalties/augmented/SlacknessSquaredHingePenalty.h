@@ -90,6 +90,9 @@ class SlacknessSquaredHingePenalty final : public AugmentedPenaltyBase {
   }
   scalar_t getSecondDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return (h < l / config_.scale) ? config_.scale : 0.0; }
 
+  bool isLocallyConstant(scalar_t t, scalar_t l, scalar_t h) const override { return h > l / config_.scale; }
+  bool hasLocallyConstantRegion() const override { return true; }
+
   scalar_t updateMultiplier(scalar_t t, scalar_t l, scalar_t h) const override {
     return std::max(0.0, std::max(l - config_.stepSize * config_.scale * h, (1.0 - config_.stepSize) * l));
   }
@@ -95,6 +95,24 @@ class SmoothAbsolutePenalty final : public AugmentedPenaltyBase {
     return config_.scale * deltaSquare / pow(h * h + deltaSquare, 1.5);
   }
 
+  scalar_t getTotalValue(scalar_t t, const vector_t* l, const vector_t& h) const override {
+    const scalar_t penalty = config_.scale * (h.array().square() + config_.relaxation * config_.relaxation).sqrt().sum();
+    return (l == nullptr) ? penalty : penalty - l->dot(h);
+  }
+  scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t* l, const vector_t& h, vector_t& derivative,
+                                     vector_t& secondDerivative) const override {
+    const scalar_t deltaSquare = config_.relaxation * config_.relaxation;
+    const Eigen::Array<scalar_t, Eigen::Dynamic, 1> smoothAbs = (h.array().square() + deltaSquare).sqrt();
+    derivative = (config_.scale * h.array() / smoothAbs).matrix();
+    secondDerivative = (config_.scale * deltaSquare / smoothAbs.cube()).matrix();
+    if (l == nullptr) {
+      return config_.scale * smoothAbs.sum();
+    } else {
+      derivative -= *l;
+      return config_.scale * smoothAbs.sum() - l->dot(h);
+    }
+  }
+
   scalar_t updateMultiplier(scalar_t t, scalar_t l, scalar_t h) const override { return l - config_.stepSize * config_.scale * h; }
   scalar_t initializeMultiplier() const override { return 0.0; }
 
@@ -67,6 +67,22 @@ class DoubleSidedPenalty final : public PenaltyBase {
     return penaltyPtr_->getSecondDerivative(t, h - lowerBound_) + penaltyPtr_->getSecondDerivative(t, upperBound_ - h);
   }
 
+  scalar_t getTotalValue(scalar_t t, const vector_t& h) const override {
+    const vector_t lowerSlack = h.array() - lowerBound_;
+    const vector_t upperSlack = upperBound_ - h.array();
+    return penaltyPtr_->getTotalValue(t, lowerSlack) + penaltyPtr_->getTotalValue(t, upperSlack);
+  }
+  scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t& h, vector_t& derivative, vector_t& secondDerivative) const override {
+    const vector_t lowerSlack = h.array() - lowerBound_;
+    const vector_t upperSlack = upperBound_ - h.array();
+    vector_t upperDerivative, upperSecondDerivative;
+    const scalar_t penalty = penaltyPtr_->getTotalValue1stDev2ndDev(t, lowerSlack, derivative, secondDerivative) +
+                             penaltyPtr_->getTotalValue1stDev2ndDev(t, upperSlack, upperDerivative, upperSecondDerivative);
+    derivative -= upperDerivative;
+    secondDerivative += upperSecondDerivative;
+    return penalty;
+  }
+
  private:
   DoubleSidedPenalty(const DoubleSidedPenalty& other)
       : lowerBound_(other.lowerBound_), upperBound_(other.upperBound_), penaltyPtr_(other.penaltyPtr_->clone()) {}
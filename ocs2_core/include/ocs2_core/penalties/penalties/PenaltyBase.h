@@ -80,6 +80,44 @@ class PenaltyBase {
    */
   virtual scalar_t getSecondDerivative(scalar_t t, scalar_t h) const = 0;
 
+  /**
+   * Compute the sum of the penalty values for a vector of constraint values.
+   * The default implementation calls getValue() per element. Penalties with a closed form override it with an array expression.
+   *
+   * @param [in] t: The time that the constraints are evaluated.
+   * @param [in] h: Constraint values.
+   * @return sum of the penalty costs.
+   */
+  virtual scalar_t getTotalValue(scalar_t t, const vector_t& h) const {
+    scalar_t penalty = 0.0;
+    for (int i = 0; i < h.size(); i++) {
+      penalty += getValue(t, h(i));
+    }
+    return penalty;
+  }
+
+  /**
+   * Compute the sum of the penalty values and the element-wise first and second derivatives for a vector of constraint values.
+   * The default implementation calls the scalar methods per element. Penalties with a closed form override it with array expressions.
+   *
+   * @param [in] t: The time that the constraints are evaluated.
+   * @param [in] h: Constraint values.
+   * @param [out] derivative: The penalty derivatives with respect to the constraint values.
+   * @param [out] secondDerivative: The penalty second derivatives with respect to the constraint values.
+   * @return sum of the penalty costs.
+   */
+  virtual scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t& h, vector_t& derivative, vector_t& secondDerivative) const {
+    derivative.resize(h.size());
+    secondDerivative.resize(h.size());
+    scalar_t penalty = 0.0;
+    for (int i = 0; i < h.size(); i++) {
+      penalty += getValue(t, h(i));
+      derivative(i) = getDerivative(t, h(i));
+      secondDerivative(i) = getSecondDerivative(t, h(i));
+    }
+    return penalty;
+  }
+
  protected:
   PenaltyBase(const PenaltyBase& other) = default;
 };
@@ -58,6 +58,13 @@ class QuadraticPenalty final : public PenaltyBase {
   scalar_t getDerivative(scalar_t t, scalar_t h) const override { return scale_ * h; }
   scalar_t getSecondDerivative(scalar_t t, scalar_t h) const override { return scale_; }
 
+  scalar_t getTotalValue(scalar_t t, const vector_t& h) const override { return 0.5 * scale_ * h.squaredNorm(); }
+  scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t& h, vector_t& derivative, vector_t& secondDerivative) const override {
+    derivative.noalias() = scale_ * h;
+    secondDerivative.setConstant(h.size(), scale_);
+    return 0.5 * scale_ * h.squaredNorm();
+  }
+
  private:
   QuadraticPenalty(const QuadraticPenalty& other) = default;
 
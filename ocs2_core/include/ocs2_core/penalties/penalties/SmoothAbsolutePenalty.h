@@ -79,6 +79,17 @@ class SmoothAbsolutePenalty final : public PenaltyBase {
     return config_.scale * deltaSquare / pow(h * h + deltaSquare, 1.5);
   }
 
+  scalar_t getTotalValue(scalar_t t, const vector_t& h) const override {
+    return config_.scale * (h.array().square() + config_.relaxation * config_.relaxation).sqrt().sum();
+  }
+  scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t& h, vector_t& derivative, vector_t& secondDerivative) const override {
+    const scalar_t deltaSquare = config_.relaxation * config_.relaxation;
+    const Eigen::Array<scalar_t, Eigen::Dynamic, 1> smoothAbs = (h.array().square() + deltaSquare).sqrt();
+    derivative = (config_.scale * h.array() / smoothAbs).matrix();
+    secondDerivative = (config_.scale * deltaSquare / smoothAbs.cube()).matrix();
+    return config_.scale * smoothAbs.sum();
+  }
+
  private:
   SmoothAbsolutePenalty(const SmoothAbsolutePenalty& other) = default;
 
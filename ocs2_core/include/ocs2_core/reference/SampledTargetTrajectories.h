@@ -0,0 +1,122 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include "ocs2_core/PreComputation.h"
+#include "ocs2_core/Types.h"
+#include "ocs2_core/reference/TargetTrajectories.h"
+
+namespace ocs2 {
+
+/**
+ * A read-only view of TargetTrajectories which is pre-sampled on a time grid, e.g. the nodes of a solver's transcription. Queries at
+ * exactly these times are served by an indexed access instead of an interpolation, while the other queries fall back to the
+ * interpolation of the viewed TargetTrajectories.
+ *
+ * The view refers to the sampled TargetTrajectories, which must outlive it and must not be modified while it is in use. Solvers build
+ * it from the reference manager's target trajectories once per run and pass it to the cost terms through the PreComputation of each
+ * worker, see getDesiredState(scalar_t, const TargetTrajectories&, const PreComputation&). The view is detached at the end of the
+ * run, since the reference manager swaps new target trajectories into the same object.
+ */
+class SampledTargetTrajectories {
+ public:
+  /** Default constructor, which creates an empty view. */
+  SampledTargetTrajectories() = default;
+
+  /** Constructor which samples the target trajectories on the time grid. */
+  SampledTargetTrajectories(const TargetTrajectories& targetTrajectories, const scalar_array_t& timeGrid);
+
+  /**
+   * Samples the desired state and input on the time grid.
+   *
+   * @param [in] targetTrajectories: The viewed target trajectories.
+   * @param [in] timeGrid: The non-decreasing sampling times.
+   */
+  void update(const TargetTrajectories& targetTrajectories, const scalar_array_t& timeGrid);
+
+  /** Clears the view. */
+  void clear();
+
+  /** Whether this view samples the given target trajectories. */
+  bool isViewOf(const TargetTrajectories& targetTrajectories) const { return targetTrajectoriesPtr_ == &targetTrajectories; }
+
+  /**
+   * Gets the desired state at the given time.
+   *
+   * @param [in] time: The query time.
+   * @param [in, out] hint: The index of the previous lookup of the caller, which is updated to this lookup.
+   */
+  vector_t getDesiredState(scalar_t time, size_t& hint) const;
+
+  /**
+   * Gets the desired input at the given time.
+   *
+   * @param [in] time: The query time.
+   * @param [in, out] hint: The index of the previous lookup of the caller, which is updated to this lookup.
+   */
+  vector_t getDesiredInput(scalar_t time, size_t& hint) const;
+
+ private:
+  /** Returns the index of the sample at the given time, or the number of samples if the time is not sampled. */
+  size_t findSample(scalar_t time, size_t& hint) const;
+
+  const TargetTrajectories* targetTrajectoriesPtr_ = nullptr;
+  scalar_array_t sampleTimes_;
+  vector_array_t sampledStates_;
+  vector_array_t sampledInputs_;
+};
+
+/**
+ * Gets the desired state at the given time. The pre-sampled view of the PreComputation is used if it views the given target
+ * trajectories, otherwise the target trajectories are interpolated.
+ */
+inline vector_t getDesiredState(scalar_t time, const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) {
+  const auto* sampledTargetTrajectoriesPtr = preComputation.getSampledTargetTrajectoriesPtr();
+  if (sampledTargetTrajectoriesPtr != nullptr && sampledTargetTrajectoriesPtr->isViewOf(targetTrajectories)) {
+    return sampledTargetTrajectoriesPtr->getDesiredState(time, preComputation.getSampleHint());
+  } else {
+    return targetTrajectories.getDesiredState(time);
+  }
+}
+
+/**
+ * Gets the desired input at the given time. The pre-sampled view of the PreComputation is used if it views the given target
+ * trajectories, otherwise the target trajectories are interpolated.
+ */
+inline vector_t getDesiredInput(scalar_t time, const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) {
+  const auto* sampledTargetTrajectoriesPtr = preComputation.getSampledTargetTrajectoriesPtr();
+  if (sampledTargetTrajectoriesPtr != nullptr && sampledTargetTrajectoriesPtr->isViewOf(targetTrajectories)) {
+    return sampledTargetTrajectoriesPtr->getDesiredInput(time, preComputation.getSampleHint());
+  } else {
+    return targetTrajectories.getDesiredInput(time);
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Adapts the number of threads that a parallel task is distributed on. The duration of the task is measured for the current
+ * thread count and the count is reduced as long as removing a thread does not slow down the task by more than a given ratio.
+ * Since the scaling changes with the problem and the load of the machine, a larger thread count is periodically probed again.
+ *
+ * Usage: run the parallel task on get() threads, then pass its duration to update().
+ */
+class AdaptiveThreadCount {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] maxNumThreads: The maximum number of threads, which is also the initial thread count.
+   * @param [in] numSamples: The number of measured durations which are averaged before a thread count is assessed.
+   * @param [in] minImprovement: The minimum relative reduction of the duration that justifies an extra thread.
+   * @param [in] reprobePeriod: The number of assessments after which a larger thread count is probed again.
+   */
+  explicit AdaptiveThreadCount(size_t maxNumThreads, size_t numSamples = 10, scalar_t minImprovement = 0.05, size_t reprobePeriod = 50);
+
+  /** Gets the number of threads that the task should be distributed on. */
+  size_t get() const { return numThreads_; }
+
+  /** Gets the maximum number of threads. */
+  size_t getMaxNumThreads() const { return maxNumThreads_; }
+
+  /**
+   * Records the duration of the task executed on get() threads.
+   *
+   * @param [in] duration: The measured duration.
+   */
+  void update(scalar_t duration);
+
+  /** Restarts the adaptation from the maximum number of threads. */
+  void reset();
+
+ private:
+  /** Starts a downward search of the thread count at the given number of threads. */
+  void startSearch(size_t numThreads);
+
+  const size_t maxNumThreads_;
+  const size_t numSamples_;
+  const scalar_t minImprovement_;
+  const size_t reprobePeriod_;
+
+  size_t numThreads_;
+  scalar_t durationSum_ = 0.0;
+  size_t numDurations_ = 0;
+
+  bool searching_ = true;
+  size_t referenceNumThreads_ = 0;  // the accepted thread count during the search, zero if not yet assessed
+  scalar_t referenceDuration_ = 0.0;
+  size_t numAssessmentsSinceSearch_ = 0;
+};
+
+}  // namespace ocs2
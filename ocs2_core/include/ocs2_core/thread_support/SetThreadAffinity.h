@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ocs2 {
+
+/**
+ * Parses a CPU list as used in the task files. The list is either empty (no affinity), the keyword "physical" for one
+ * logical CPU per physical core (see getPhysicalCores), or a comma separated list of CPU ids and ranges, e.g. "0,2,4-7".
+ *
+ * @param [in] cpuList: The CPU list.
+ * @return The CPU ids.
+ */
+std::vector<int> parseCpuList(const std::string& cpuList);
+
+/**
+ * Returns one logical CPU per physical core, i.e. the hyper-thread siblings are skipped. The cores are ordered by their
+ * package (socket) such that taking the first N entries keeps the threads on the same socket when possible.
+ * Falls back to all the available CPUs if the topology of the system cannot be read.
+ */
+std::vector<int> getPhysicalCores();
+
+/**
+ * Sets the CPU affinity of the input thread. An empty CPU list leaves the affinity unchanged.
+ *
+ * @param cpus: The CPU ids on which the thread is allowed to run.
+ * @param thread: A reference to the tread.
+ */
+void setThreadAffinity(const std::vector<int>& cpus, pthread_t thread);
+
+/**
+ * Sets the CPU affinity of the input thread. An empty CPU list leaves the affinity unchanged.
+ *
+ * @param cpus: The CPU ids on which the thread is allowed to run.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpus, std::thread& thread) {
+  setThreadAffinity(cpus, thread.native_handle());
+}
+
+/**
+ * Sets the CPU affinity of the thread this function is called from. An empty CPU list leaves the affinity unchanged.
+ *
+ * @param cpus: The CPU ids on which the thread is allowed to run.
+ */
+inline void setThisThreadAffinity(const std::vector<int>& cpus) {
+  setThreadAffinity(cpus, pthread_self());
+}
+
+}  // namespace ocs2
@@ -48,8 +48,10 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] cpus: The CPU ids to pin the workers on. Worker i runs on cpus[i % cpus.size()]. An empty list leaves the
+   *                   workers unpinned.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, const std::vector<int>& cpus = {});
 
   /**
    * Destructor
@@ -100,6 +100,20 @@ ScalarFunctionQuadraticApproximation StateAugmentedLagrangian::getQuadraticAppro
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateAugmentedLagrangian::isLocallyConstant(scalar_t time, const vector_t& constraint, const Multiplier& multiplier) const {
+  return penalty_.isLocallyConstant(time, constraint, &multiplier.lagrangian);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateAugmentedLagrangian::hasLocallyConstantRegion() const {
+  return penalty_.hasLocallyConstantRegion();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
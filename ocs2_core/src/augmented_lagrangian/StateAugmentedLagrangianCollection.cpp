@@ -74,29 +74,57 @@ std::vector<LagrangianMetrics> StateAugmentedLagrangianCollection::getValue(scal
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation StateAugmentedLagrangianCollection::getQuadraticApproximation(
     scalar_t time, const vector_t& state, const std::vector<Multiplier>& termsMultiplier, const PreComputation& preComp) const {
-  const auto firstActiveItr =
-      std::find_if(terms_.begin(), terms_.end(),
-                   [time](const std::unique_ptr<StateAugmentedLagrangianInterface>& costTerm) { return costTerm->isActive(time); });
+  auto penalty = ScalarFunctionQuadraticApproximation::Zero(state.size(), 0);
 
-  // no active terms (or terms is empty).
-  if (firstActiveItr == terms_.end()) {
-    return ScalarFunctionQuadraticApproximation::Zero(state.size(), 0);
+  for (size_t i = 0; i < terms_.size(); i++) {
+    if (terms_[i]->isActive(time)) {
+      penalty += terms_[i]->getQuadraticApproximation(time, state, termsMultiplier[i], preComp);
+    }
   }
 
-  // initialize with first active term
-  const size_t firstActiveInd = std::distance(terms_.begin(), firstActiveItr);
-  auto penalty = (*firstActiveItr)->getQuadraticApproximation(time, state, termsMultiplier[firstActiveInd], preComp);
+  return penalty;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation StateAugmentedLagrangianCollection::getQuadraticApproximation(
+    scalar_t time, const vector_t& state, const std::vector<Multiplier>& termsMultiplier,
+    const std::vector<LagrangianMetrics>& termsMetrics, const PreComputation& preComp) const {
+  assert(termsMetrics.size() == terms_.size());
+  auto penalty = ScalarFunctionQuadraticApproximation::Zero(state.size(), 0);
 
-  // accumulate terms
-  for (size_t i = firstActiveInd + 1; i < terms_.size(); i++) {
+  for (size_t i = 0; i < terms_.size(); i++) {
     if (terms_[i]->isActive(time)) {
-      penalty += terms_[i]->getQuadraticApproximation(time, state, termsMultiplier[i], preComp);
+      // locally constant terms contribute only their value, which is already in the metrics
+      if (terms_[i]->hasLocallyConstantRegion() && terms_[i]->isLocallyConstant(time, termsMetrics[i].constraint, termsMultiplier[i])) {
+        penalty.f += termsMetrics[i].penalty;
+      } else {
+        penalty += terms_[i]->getQuadraticApproximation(time, state, termsMultiplier[i], preComp);
+      }
     }
   }
 
   return penalty;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateAugmentedLagrangianCollection::countLocallyConstantTerms(scalar_t time, const std::vector<LagrangianMetrics>& termsMetrics,
+                                                                   const std::vector<Multiplier>& termsMultiplier,
+                                                                   size_t& numLocallyConstant, size_t& numEvaluated) const {
+  for (size_t i = 0; i < terms_.size(); i++) {
+    if (terms_[i]->isActive(time)) {
+      if (terms_[i]->hasLocallyConstantRegion() && terms_[i]->isLocallyConstant(time, termsMetrics[i].constraint, termsMultiplier[i])) {
+        numLocallyConstant++;
+      } else {
+        numEvaluated++;
+      }
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -101,6 +101,20 @@ ScalarFunctionQuadraticApproximation StateInputAugmentedLagrangian::getQuadratic
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateInputAugmentedLagrangian::isLocallyConstant(scalar_t time, const vector_t& constraint, const Multiplier& multiplier) const {
+  return penalty_.isLocallyConstant(time, constraint, &multiplier.lagrangian);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool StateInputAugmentedLagrangian::hasLocallyConstantRegion() const {
+  return penalty_.hasLocallyConstantRegion();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -29,6 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/cost/QuadraticStateCost.h>
 
+#include <typeinfo>
+
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -47,8 +51,8 @@ QuadraticStateCost* QuadraticStateCost::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
-                                      const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+                                      const PreComputation& preComp) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories, preComp);
   return 0.5 * xDeviation.dot(Q_ * xDeviation);
 }
 
@@ -57,8 +61,8 @@ scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, cons
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                    const TargetTrajectories& targetTrajectories,
-                                                                                   const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+                                                                                   const PreComputation& preComp) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories, preComp);
 
   ScalarFunctionQuadraticApproximation Phi;
   Phi.dfdxx = Q_;
@@ -67,6 +71,18 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
   return Phi;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                               const PreComputation& preComputation) const {
+  if (typeid(*this) == typeid(QuadraticStateCost)) {
+    return state - getDesiredState(time, targetTrajectories, preComputation);
+  } else {
+    return getStateDeviation(time, state, targetTrajectories);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -29,6 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
 
+#include <typeinfo>
+
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -53,9 +57,9 @@ QuadraticStateInputCost* QuadraticStateInputCost::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state, const vector_t& input,
-                                           const TargetTrajectories& targetTrajectories, const PreComputation&) const {
+                                           const TargetTrajectories& targetTrajectories, const PreComputation& preComp) const {
   vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories, preComp);
 
   if (P_.size() == 0) {
     return 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation);
@@ -71,9 +75,9 @@ scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state,
 ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                         const vector_t& input,
                                                                                         const TargetTrajectories& targetTrajectories,
-                                                                                        const PreComputation&) const {
+                                                                                        const PreComputation& preComp) const {
   vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories, preComp);
 
   ScalarFunctionQuadraticApproximation L;
   L.dfdxx = Q_;
@@ -96,6 +100,21 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
   return L;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                              const TargetTrajectories& targetTrajectories,
+                                                                              const PreComputation& preComputation) const {
+  if (typeid(*this) == typeid(QuadraticStateInputCost)) {
+    const vector_t stateDeviation = state - getDesiredState(time, targetTrajectories, preComputation);
+    const vector_t inputDeviation = input - getDesiredInput(time, targetTrajectories, preComputation);
+    return {stateDeviation, inputDeviation};
+  } else {
+    return getStateInputDeviation(time, state, input, targetTrajectories);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
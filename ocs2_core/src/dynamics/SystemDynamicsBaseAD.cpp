@@ -44,7 +44,12 @@ SystemDynamicsBaseAD::SystemDynamicsBaseAD(const SystemDynamicsBaseAD& rhs)
       flowMapADInterfacePtr_(new CppAdInterface(*rhs.flowMapADInterfacePtr_)),
       jumpMapADInterfacePtr_(new CppAdInterface(*rhs.jumpMapADInterfacePtr_)),
       guardSurfacesADInterfacePtr_(new CppAdInterface(*rhs.guardSurfacesADInterfacePtr_)),
+      discreteFlowMapADInterfacePtr_(rhs.discreteFlowMapADInterfacePtr_ != nullptr
+                                         ? new CppAdInterface(*rhs.discreteFlowMapADInterfacePtr_)
+                                         : nullptr),
+      discreteFlowMapIntegratorType_(rhs.discreteFlowMapIntegratorType_),
       tapedTimeStateInput_(rhs.tapedTimeStateInput_.size()),
+      tapedTimeStepStateInput_(rhs.tapedTimeStepStateInput_.size()),
       tapedTimeState_(rhs.tapedTimeState_.size()),
       flowJacobian_(rhs.flowJacobian_.rows(), rhs.flowJacobian_.cols()),
       jumpJacobian_(rhs.jumpJacobian_.rows(), rhs.jumpJacobian_.cols()),
@@ -93,6 +98,97 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBaseAD::initializeDiscreteFlowMap(SensitivityIntegratorType integratorType, const std::string& modelName,
+                                                     const std::string& modelFolder, bool recompileLibraries, bool verbose) {
+  if (tapedTimeState_.size() == 0) {
+    throw std::runtime_error("[SystemDynamicsBaseAD::initializeDiscreteFlowMap] initialize() should be called first!");
+  }
+  const size_t stateDim = tapedTimeState_.size() - 1;
+  const size_t inputDim = tapedTimeStateInput_.size() - tapedTimeState_.size();
+  tapedTimeStepStateInput_.resize(3 + stateDim + inputDim);
+
+  // x = [t, dt, state, input, scale]. The map is multiplied by the scale, which is always one, such that the Jacobian column of
+  // the scale is the value of the map and the linear approximation needs a single evaluation of the generated model.
+  auto discreteFlowMap = [this, stateDim, inputDim, integratorType](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    const ad_scalar_t t = x(0);
+    const ad_scalar_t dt = x(1);
+    const ad_vector_t state = x.segment(2, stateDim);
+    const ad_vector_t input = x.segment(2 + stateDim, inputDim);
+    const ad_scalar_t scale = x(2 + stateDim + inputDim);
+    switch (integratorType) {
+      case SensitivityIntegratorType::EULER: {
+        y = state + dt * this->systemFlowMap(t, state, input, p);
+        break;
+      }
+      case SensitivityIntegratorType::RK2: {
+        const ad_scalar_t dt_halve = dt / 2.0;
+        const ad_vector_t k1 = this->systemFlowMap(t, state, input, p);
+        const ad_vector_t k2 = this->systemFlowMap(t + dt, state + dt * k1, input, p);
+        y = state + dt_halve * k1 + dt_halve * k2;
+        break;
+      }
+      case SensitivityIntegratorType::RK4: {
+        const ad_scalar_t dt_halve = dt / 2.0;
+        const ad_scalar_t dt_sixth = dt / 6.0;
+        const ad_scalar_t dt_third = dt / 3.0;
+        const ad_vector_t k1 = this->systemFlowMap(t, state, input, p);
+        const ad_vector_t k2 = this->systemFlowMap(t + dt_halve, state + dt_halve * k1, input, p);
+        const ad_vector_t k3 = this->systemFlowMap(t + dt_halve, state + dt_halve * k2, input, p);
+        const ad_vector_t k4 = this->systemFlowMap(t + dt, state + dt * k3, input, p);
+        y = state + dt_sixth * k1 + dt_third * k2 + dt_third * k3 + dt_sixth * k4;
+        break;
+      }
+      default:
+        throw std::runtime_error("[SystemDynamicsBaseAD] Integrator of type " + sensitivity_integrator::toString(integratorType) +
+                                 " not supported.");
+    }
+    y *= scale;
+  };
+  const std::string discreteModelName = modelName + "_discrete_flow_map_" + sensitivity_integrator::toString(integratorType);
+  discreteFlowMapADInterfacePtr_.reset(
+      new CppAdInterface(discreteFlowMap, 3 + stateDim + inputDim, getNumFlowMapParameters(), discreteModelName, modelFolder));
+  discreteFlowMapIntegratorType_ = integratorType;
+
+  if (recompileLibraries) {
+    discreteFlowMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+  } else {
+    discreteFlowMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t SystemDynamicsBaseAD::computeDiscreteFlowMap(scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  assert(discreteFlowMapADInterfacePtr_ != nullptr);
+  preCompPtr_->request(Request::Dynamics, t, x, u);
+  tapedTimeStepStateInput_ << t, dt, x, u, 1.0;
+  const vector_t parameters = getFlowMapParameters(t, *preCompPtr_);
+  return discreteFlowMapADInterfacePtr_->getFunctionValue(tapedTimeStepStateInput_, parameters);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation SystemDynamicsBaseAD::discreteFlowMapLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                                                           scalar_t dt) {
+  assert(discreteFlowMapADInterfacePtr_ != nullptr);
+  preCompPtr_->request(Request::Dynamics + Request::Approximation, t, x, u);
+  tapedTimeStepStateInput_ << t, dt, x, u, 1.0;
+  const vector_t parameters = getFlowMapParameters(t, *preCompPtr_);
+  const matrix_t jacobian = discreteFlowMapADInterfacePtr_->getJacobian(tapedTimeStepStateInput_, parameters);
+
+  // the derivative w.r.t. the unit scale is the value of the map
+  VectorFunctionLinearApproximation approximation;
+  approximation.dfdx = jacobian.middleCols(2, x.rows());
+  approximation.dfdu = jacobian.middleCols(2 + x.rows(), u.rows());
+  approximation.f = jacobian.rightCols<1>();
+  return approximation;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,312 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <ocs2_core/integration/FixedStepIntegrator.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Helper less comparison for both positive and negative dt case. */
+bool lessWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t2 - t1 > std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t1 - t2 > std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Helper less or equal comparison for both positive and negative dt case. */
+bool lessEqualWithSign(scalar_t t1, scalar_t t2, scalar_t dt) {
+  if (dt > 0) {
+    return t1 - t2 <= std::numeric_limits<scalar_t>::epsilon();
+  } else {
+    return t2 - t1 <= std::numeric_limits<scalar_t>::epsilon();
+  }
+}
+
+/** Newton iteration settings of the implicit midpoint step */
+constexpr size_t implicitMidpointMaxNumIterations = 10;
+constexpr scalar_t implicitMidpointTolerance = 1e-9;
+
+/** Number of observations of an equidistant integration, used to reserve the observer storage. */
+size_t numConstObservations(scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  const scalar_t numSteps = std::floor((finalTime - startTime) / dt);
+  return numSteps > 0.0 ? static_cast<size_t>(numSteps) + 1 : 1;
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::integrateConst(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
+                                         scalar_t finalTime, scalar_t dt, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
+  auto systemFunc = [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) {
+    dxdt = system.computeFlowMap(t, x);
+    checkNumFunctionCalls(system, maxNumSteps, t, x);
+  };
+  auto observerFunc = [&](const vector_t& x, scalar_t t) {
+    observer.observe(x, t);
+    handleEvent(system, t, x);
+  };
+
+  // Ensure that finalTime is included by adding a fraction of dt such that: N * dt <= finalTime < (N + 1) * dt.
+  finalTime += 0.1 * dt;
+  observer.reserve(numConstObservations(startTime, finalTime, dt));
+
+  vector_t x = initialState;
+  constSteps(systemFunc, observerFunc, x, startTime, finalTime, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::integrateAdaptive(OdeBase& system, Observer& observer, const vector_t& initialState, scalar_t startTime,
+                                            scalar_t finalTime, scalar_t dtInitial /*= 0.01*/, scalar_t AbsTol /*= 1e-6*/,
+                                            scalar_t RelTol /*= 1e-3*/, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
+  auto systemFunc = [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) {
+    dxdt = system.computeFlowMap(t, x);
+    checkNumFunctionCalls(system, maxNumSteps, t, x);
+  };
+  auto observerFunc = [&](const vector_t& x, scalar_t t) {
+    observer.observe(x, t);
+    handleEvent(system, t, x);
+  };
+
+  observer.reserve(numConstObservations(startTime, finalTime, dtInitial) + 1);
+
+  vector_t x = initialState;
+  const scalar_t t = constSteps(systemFunc, observerFunc, x, startTime, finalTime, dtInitial);
+  // make a last step to end exactly at finalTime
+  if (lessWithSign(t, finalTime, dtInitial)) {
+    step(systemFunc, t, finalTime - t, x);
+    observerFunc(x, finalTime);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::integrateTimes(OdeBase& system, Observer& observer, const vector_t& initialState,
+                                         typename scalar_array_t::const_iterator beginTimeItr,
+                                         typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial /*= 0.01*/,
+                                         scalar_t AbsTol /*= 1e-6*/, scalar_t RelTol /*= 1e-3*/,
+                                         int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
+  auto systemFunc = [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) {
+    dxdt = system.computeFlowMap(t, x);
+    checkNumFunctionCalls(system, maxNumSteps, t, x);
+  };
+  auto observerFunc = [&](const vector_t& x, scalar_t t) {
+    observer.observe(x, t);
+    handleEvent(system, t, x);
+  };
+
+  observer.reserve(std::distance(beginTimeItr, endTimeItr));
+
+  vector_t x = initialState;
+  timeStampSteps(systemFunc, observerFunc, x, beginTimeItr, endTimeItr, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::integrateStep(OdeBase& system, scalar_t t, scalar_t dt, vector_t& x) {
+  auto systemFunc = [&system](const vector_t& x, vector_t& dxdt, scalar_t t) { dxdt = system.computeFlowMap(t, x); };
+  step(systemFunc, t, dt, x);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::runIntegrateConst(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                            scalar_t startTime, scalar_t finalTime, scalar_t dt) {
+  vector_t x = initialState;
+  constSteps(system, observer, x, startTime, finalTime + 0.1 * dt, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::runIntegrateAdaptive(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                               scalar_t startTime, scalar_t finalTime, scalar_t dtInitial, scalar_t AbsTol,
+                                               scalar_t RelTol) {
+  vector_t x = initialState;
+  const scalar_t t = constSteps(system, observer, x, startTime, finalTime, dtInitial);
+  if (lessWithSign(t, finalTime, dtInitial)) {
+    step(system, t, finalTime - t, x);
+    observer(x, finalTime);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FixedStepIntegrator::runIntegrateTimes(system_func_t system, observer_func_t observer, const vector_t& initialState,
+                                            typename scalar_array_t::const_iterator beginTimeItr,
+                                            typename scalar_array_t::const_iterator endTimeItr, scalar_t dtInitial, scalar_t AbsTol,
+                                            scalar_t RelTol) {
+  vector_t x = initialState;
+  timeStampSteps(system, observer, x, beginTimeItr, endTimeItr, dtInitial);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc, typename ObserverFunc>
+scalar_t FixedStepIntegrator::constSteps(SystemFunc& system, ObserverFunc& observer, vector_t& x, scalar_t startTime, scalar_t finalTime,
+                                         scalar_t dt) {
+  scalar_t t = startTime;
+  size_t numSteps = 0;
+  while (lessEqualWithSign(t + dt, finalTime, dt)) {
+    observer(x, t);
+    step(system, t, dt, x);
+    numSteps++;
+    // direct computation of the time avoids accumulation of round-off errors
+    t = startTime + numSteps * dt;
+  }
+  observer(x, t);
+  return t;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc, typename ObserverFunc>
+void FixedStepIntegrator::timeStampSteps(SystemFunc& system, ObserverFunc& observer, vector_t& x,
+                                         typename scalar_array_t::const_iterator beginTimeItr,
+                                         typename scalar_array_t::const_iterator endTimeItr, scalar_t dt) {
+  if (beginTimeItr == endTimeItr) {
+    return;
+  }
+
+  scalar_t t = *beginTimeItr;
+  observer(x, t);
+  for (auto timeItr = std::next(beginTimeItr); timeItr != endTimeItr; ++timeItr) {
+    while (lessWithSign(t, *timeItr, dt)) {
+      const scalar_t stepSize = (dt > 0) ? std::min(dt, *timeItr - t) : std::max(dt, *timeItr - t);
+      step(system, t, stepSize, x);
+      t += stepSize;
+    }
+    observer(x, *timeItr);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc>
+void FixedStepIntegrator::step(SystemFunc& system, scalar_t t, scalar_t dt, vector_t& x) {
+  switch (scheme_) {
+    case Scheme::EULER: {
+      system(x, k1_, t);
+      x += dt * k1_;
+      break;
+    }
+    case Scheme::RK4: {
+      // the stage state is assigned in-place and only allocates if the state dimension changes
+      const scalar_t halfDt = 0.5 * dt;
+      system(x, k1_, t);
+      xStage_ = x + halfDt * k1_;
+      system(xStage_, k2_, t + halfDt);
+      xStage_ = x + halfDt * k2_;
+      system(xStage_, k3_, t + halfDt);
+      xStage_ = x + dt * k3_;
+      system(xStage_, k4_, t + dt);
+      x += (dt / 6.0) * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+      break;
+    }
+    case Scheme::IMPLICIT_MIDPOINT: {
+      // stage equation k = f(t + dt/2, x + dt/2 * k), initialized with the explicit Euler slope
+      const scalar_t halfDt = 0.5 * dt;
+      const scalar_t midTime = t + halfDt;
+      system(x, k1_, t);
+
+      // Newton matrix at the current state
+      xStage_ = x;
+      system(xStage_, k2_, midTime);
+      updateNewtonMatrix(system, midTime, halfDt);
+
+      // simplified Newton iterations, the Newton matrix is only refreshed at the stage state if the residual does not contract
+      scalar_t previousResidualNorm = std::numeric_limits<scalar_t>::infinity();
+      for (size_t i = 0;; i++) {
+        xStage_ = x + halfDt * k1_;
+        system(xStage_, k2_, midTime);
+        k4_ = k1_ - k2_;  // residual
+        const scalar_t residualNorm = k4_.norm();
+        if (residualNorm <= implicitMidpointTolerance * (1.0 + k1_.norm())) {
+          break;
+        }
+        if (i == implicitMidpointMaxNumIterations) {
+          throw std::runtime_error("[FixedStepIntegrator] The implicit midpoint stage did not converge at time " + std::to_string(t) +
+                                   " with the step size " + std::to_string(dt) + ", the residual norm is " +
+                                   std::to_string(residualNorm) + ".");
+        }
+        if (residualNorm > 0.5 * previousResidualNorm) {
+          updateNewtonMatrix(system, midTime, halfDt);
+        }
+        previousResidualNorm = residualNorm;
+        k1_ -= newtonMatrixLu_.solve(k4_);
+      }
+      x += dt * k1_;
+      break;
+    }
+    default:
+      throw std::runtime_error("[FixedStepIntegrator] Unknown scheme.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename SystemFunc>
+void FixedStepIntegrator::updateNewtonMatrix(SystemFunc& system, scalar_t midTime, scalar_t halfDt) {
+  // Id - dt/2 * dfdx from forward differences, where xStage_ is restored after each perturbation
+  const auto stateDim = xStage_.size();
+  newtonMatrix_.resize(stateDim, stateDim);
+  for (int j = 0; j < stateDim; j++) {
+    const scalar_t xj = xStage_(j);
+    const scalar_t h = std::sqrt(std::numeric_limits<scalar_t>::epsilon()) * std::max(1.0, std::abs(xj));
+    xStage_(j) += h;
+    system(xStage_, k3_, midTime);
+    newtonMatrix_.col(j) = (-halfDt / h) * (k3_ - k2_);
+    xStage_(j) = xj;
+  }
+  newtonMatrix_.diagonal().array() += 1.0;  // plus Identity()
+  newtonMatrixLu_.compute(newtonMatrix_);
+}
+
+}  // namespace ocs2
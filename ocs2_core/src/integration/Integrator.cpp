@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 #include <unordered_map>
 
+#include <ocs2_core/integration/FixedStepIntegrator.h>
 #include <ocs2_core/integration/Integrator.h>
 #include <ocs2_core/integration/RungeKuttaDormandPrince5.h>
 #include <ocs2_core/integration/implementation/Integrator.h>
@@ -49,7 +50,10 @@ std::string toString(IntegratorType integratorType) {
       {IntegratorType::MODIFIED_MIDPOINT, "MODIFIED_MIDPOINT"},
       {IntegratorType::RK4, "RK4"},
       {IntegratorType::RK5_VARIABLE, "RK5_VARIABLE"},
-      {IntegratorType::ADAMS_BASHFORTH_MOULTON, "ADAMS_BASHFORTH_MOULTON"}};
+      {IntegratorType::ADAMS_BASHFORTH_MOULTON, "ADAMS_BASHFORTH_MOULTON"},
+      {IntegratorType::EULER_OCS2, "EULER_OCS2"},
+      {IntegratorType::RK4_OCS2, "RK4_OCS2"},
+      {IntegratorType::IMPLICIT_MIDPOINT_OCS2, "IMPLICIT_MIDPOINT_OCS2"}};
 
   return integratorMap.at(integratorType);
 }
@@ -67,7 +71,10 @@ IntegratorType fromString(const std::string& name) {
       {"MODIFIED_MIDPOINT", IntegratorType::MODIFIED_MIDPOINT},
       {"RK4", IntegratorType::RK4},
       {"RK5_VARIABLE", IntegratorType::RK5_VARIABLE},
-      {"ADAMS_BASHFORTH_MOULTON", IntegratorType::ADAMS_BASHFORTH_MOULTON}};
+      {"ADAMS_BASHFORTH_MOULTON", IntegratorType::ADAMS_BASHFORTH_MOULTON},
+      {"EULER_OCS2", IntegratorType::EULER_OCS2},
+      {"RK4_OCS2", IntegratorType::RK4_OCS2},
+      {"IMPLICIT_MIDPOINT_OCS2", IntegratorType::IMPLICIT_MIDPOINT_OCS2}};
 
   return integratorMap.at(name);
 }
@@ -99,6 +106,12 @@ std::unique_ptr<IntegratorBase> newIntegrator(IntegratorType integratorType, con
     case (IntegratorType::ADAMS_BASHFORTH_MOULTON):
       return std::unique_ptr<IntegratorBase>(new IntegratorAdamsBashforthMoulton<1>(eventHandlerPtr));
 #endif
+    case (IntegratorType::EULER_OCS2):
+      return std::unique_ptr<IntegratorBase>(new FixedStepIntegrator(FixedStepIntegrator::Scheme::EULER, eventHandlerPtr));
+    case (IntegratorType::RK4_OCS2):
+      return std::unique_ptr<IntegratorBase>(new FixedStepIntegrator(FixedStepIntegrator::Scheme::RK4, eventHandlerPtr));
+    case (IntegratorType::IMPLICIT_MIDPOINT_OCS2):
+      return std::unique_ptr<IntegratorBase>(new FixedStepIntegrator(FixedStepIntegrator::Scheme::IMPLICIT_MIDPOINT, eventHandlerPtr));
     default:
       throw std::runtime_error("Integrator of type " + integrator_type::toString(integratorType) + " not supported.");
   }
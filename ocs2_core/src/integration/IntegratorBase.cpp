@@ -47,16 +47,23 @@ IntegratorBase::IntegratorBase(std::shared_ptr<SystemEventHandler> eventHandlerP
 IntegratorBase::system_func_t IntegratorBase::systemFunction(OdeBase& system, int maxNumSteps) const {
   return [&system, maxNumSteps](const vector_t& x, vector_t& dxdt, scalar_t t) {
     dxdt = system.computeFlowMap(t, x);
-    // max number of function calls
-    if (system.incrementNumFunctionCalls() > maxNumSteps) {
-      std::stringstream msg;
-      msg << "Integration terminated since the maximum number of function calls is reached. State at termination time " << t << ":\n["
-          << x.transpose() << "]\n";
-      throw std::runtime_error(msg.str());
-    }
+    checkNumFunctionCalls(system, maxNumSteps, t, x);
   };
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IntegratorBase::checkNumFunctionCalls(OdeBase& system, int maxNumSteps, scalar_t t, const vector_t& x) {
+  // max number of function calls
+  if (system.incrementNumFunctionCalls() > maxNumSteps) {
+    std::stringstream msg;
+    msg << "Integration terminated since the maximum number of function calls is reached. State at termination time " << t << ":\n["
+        << x.transpose() << "]\n";
+    throw std::runtime_error(msg.str());
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -64,7 +71,7 @@ void IntegratorBase::integrateConst(OdeBase& system, Observer& observer, const v
                                     scalar_t finalTime, scalar_t dt, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
   observer_func_t callback = [&](const vector_t& x, scalar_t t) {
     observer.observe(x, t);
-    eventHandlerPtr_->handleEvent(system, t, x);
+    handleEvent(system, t, x);
   };
   runIntegrateConst(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dt);
 }
@@ -77,7 +84,7 @@ void IntegratorBase::integrateAdaptive(OdeBase& system, Observer& observer, cons
                                        scalar_t RelTol /*= 1e-3*/, int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
   observer_func_t callback = [&](const vector_t& x, scalar_t t) {
     observer.observe(x, t);
-    eventHandlerPtr_->handleEvent(system, t, x);
+    handleEvent(system, t, x);
   };
   runIntegrateAdaptive(systemFunction(system, maxNumSteps), callback, initialState, startTime, finalTime, dtInitial, AbsTol, RelTol);
 }
@@ -92,7 +99,7 @@ void IntegratorBase::integrateTimes(OdeBase& system, Observer& observer, const v
                                     int maxNumSteps /*= std::numeric_limits<int>::max()*/) {
   observer_func_t callback = [&](const vector_t& x, scalar_t t) {
     observer.observe(x, t);
-    eventHandlerPtr_->handleEvent(system, t, x);
+    handleEvent(system, t, x);
   };
   runIntegrateTimes(systemFunction(system, maxNumSteps), callback, initialState, beginTimeItr, endTimeItr, dtInitial, AbsTol, RelTol);
 }
@@ -27,10 +27,25 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
+
 #include <ocs2_core/integration/Observer.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** Reserves space for numObservations more elements. Grows at least geometrically, since rollouts concatenate many short intervals. */
+template <typename Container>
+void reserveAdditional(Container& trajectory, size_t numObservations) {
+  const size_t requiredCapacity = trajectory.size() + numObservations;
+  if (trajectory.capacity() < requiredCapacity) {
+    trajectory.reserve(std::max(requiredCapacity, 2 * trajectory.size()));
+  }
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -50,4 +65,16 @@ void Observer::observe(const vector_t& state, scalar_t time) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void Observer::reserve(size_t numObservations) {
+  if (stateTrajectoryPtr_ != nullptr) {
+    reserveAdditional(*stateTrajectoryPtr_, numObservations);
+  }
+  if (timeTrajectoryPtr_ != nullptr) {
+    reserveAdditional(*timeTrajectoryPtr_, numObservations);
+  }
+}
+
 }  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <unordered_map>
 
+#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
 #include <ocs2_core/integration/SensitivityIntegratorImpl.h>
 
 namespace ocs2 {
@@ -39,32 +40,67 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integratorType) {
+  DynamicsDiscretizer discretizer;
   switch (integratorType) {
     case SensitivityIntegratorType::EULER:
-      return eulerDiscretization;
+      discretizer = eulerDiscretization;
+      break;
     case SensitivityIntegratorType::RK2:
-      return rk2Discretization;
+      discretizer = rk2Discretization;
+      break;
     case SensitivityIntegratorType::RK4:
-      return rk4Discretization;
+      discretizer = rk4Discretization;
+      break;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      discretizer = implicitMidpointDiscretization;
+      break;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
+
+  // use the generated discrete flow map if available
+  return [integratorType, discretizer](SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+    auto* systemAD = dynamic_cast<SystemDynamicsBaseAD*>(&system);
+    if (systemAD != nullptr && systemAD->hasDiscreteFlowMap(integratorType)) {
+      return systemAD->computeDiscreteFlowMap(t, x, u, dt);
+    } else {
+      return discretizer(system, t, x, u, dt);
+    }
+  };
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType) {
+  DynamicsSensitivityDiscretizer sensitivityDiscretizer;
   switch (integratorType) {
     case SensitivityIntegratorType::EULER:
-      return eulerSensitivityDiscretization;
+      sensitivityDiscretizer = eulerSensitivityDiscretization;
+      break;
     case SensitivityIntegratorType::RK2:
-      return rk2SensitivityDiscretization;
+      sensitivityDiscretizer = rk2SensitivityDiscretization;
+      break;
     case SensitivityIntegratorType::RK4:
-      return rk4SensitivityDiscretization;
+      sensitivityDiscretizer = rk4SensitivityDiscretization;
+      break;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      sensitivityDiscretizer = implicitMidpointSensitivityDiscretization;
+      break;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
+
+  // use the generated discrete flow map and its sensitivities if available
+  return [integratorType, sensitivityDiscretizer](SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                                  scalar_t dt) {
+    auto* systemAD = dynamic_cast<SystemDynamicsBaseAD*>(&system);
+    if (systemAD != nullptr && systemAD->hasDiscreteFlowMap(integratorType)) {
+      return systemAD->discreteFlowMapLinearApproximation(t, x, u, dt);
+    } else {
+      return sensitivityDiscretizer(system, t, x, u, dt);
+    }
+  };
 }
 
 namespace sensitivity_integrator {
@@ -74,7 +110,10 @@ namespace sensitivity_integrator {
 /******************************************************************************************************/
 std::string toString(SensitivityIntegratorType integratorType) {
   static const std::unordered_map<SensitivityIntegratorType, std::string> integratorMap = {
-      {SensitivityIntegratorType::EULER, "EULER"}, {SensitivityIntegratorType::RK2, "RK2"}, {SensitivityIntegratorType::RK4, "RK4"}};
+      {SensitivityIntegratorType::EULER, "EULER"},
+      {SensitivityIntegratorType::RK2, "RK2"},
+      {SensitivityIntegratorType::RK4, "RK4"},
+      {SensitivityIntegratorType::IMPLICIT_MIDPOINT, "IMPLICIT_MIDPOINT"}};
 
   return integratorMap.at(integratorType);
 }
@@ -84,7 +123,10 @@ std::string toString(SensitivityIntegratorType integratorType) {
 /******************************************************************************************************/
 SensitivityIntegratorType fromString(const std::string& name) {
   static const std::unordered_map<std::string, SensitivityIntegratorType> integratorMap = {
-      {"EULER", SensitivityIntegratorType::EULER}, {"RK2", SensitivityIntegratorType::RK2}, {"RK4", SensitivityIntegratorType::RK4}};
+      {"EULER", SensitivityIntegratorType::EULER},
+      {"RK2", SensitivityIntegratorType::RK2},
+      {"RK4", SensitivityIntegratorType::RK4},
+      {"IMPLICIT_MIDPOINT", SensitivityIntegratorType::IMPLICIT_MIDPOINT}};
 
   return integratorMap.at(name);
 }
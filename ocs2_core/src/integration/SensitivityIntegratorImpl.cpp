@@ -29,8 +29,56 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegratorImpl.h"
 
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/LU>
+
 namespace ocs2 {
 
+namespace {
+
+/** Newton iteration settings for the implicit midpoint stage equation */
+constexpr size_t implicitMidpointMaxNumIterations = 10;
+constexpr scalar_t implicitMidpointTolerance = 1e-9;
+
+/**
+ * Solves the implicit midpoint stage equation k = f(t + dt/2, x + dt/2 * k, u) with Newton iterations, starting from the explicit
+ * Euler slope. For linear dynamics a single Newton step is exact.
+ *
+ * @param [out] k: The stage slope.
+ * @return The linear approximation of the flow map at the midpoint state x + dt/2 * k.
+ * @throw std::runtime_error if the stage equation is not solved within the maximum number of iterations.
+ */
+VectorFunctionLinearApproximation solveImplicitMidpointStage(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                                             scalar_t dt, vector_t& k) {
+  const scalar_t dt_halve = dt / 2.0;
+  const scalar_t t_mid = t + dt_halve;
+
+  k = system.computeFlowMap(t, x, u);
+  VectorFunctionLinearApproximation stage = system.linearApproximation(t_mid, x + dt_halve * k, u);
+  matrix_t newtonMatrix;
+  for (size_t i = 0;; i++) {
+    // residual: k - f(x + dt/2 * k), Jacobian: Id - dt/2 * dfdx
+    const vector_t residual = k - stage.f;
+    const scalar_t residualNorm = residual.norm();
+    if (residualNorm <= implicitMidpointTolerance * (1.0 + k.norm())) {
+      return stage;
+    }
+    if (i == implicitMidpointMaxNumIterations) {
+      throw std::runtime_error("[solveImplicitMidpointStage] The stage equation did not converge at time " + std::to_string(t) +
+                               " with the step size " + std::to_string(dt) + ", the residual norm is " + std::to_string(residualNorm) +
+                               ".");
+    }
+    newtonMatrix = -dt_halve * stage.dfdx;
+    newtonMatrix.diagonal().array() += 1.0;  // plus Identity()
+    k -= newtonMatrix.partialPivLu().solve(residual);
+    stage = system.linearApproximation(t_mid, x + dt_halve * k, u);
+  }
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -168,4 +216,36 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   return k1;
 }
 
-}  // namespace ocs2
\ No newline at end of file
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  vector_t k;
+  solveImplicitMidpointStage(system, t, x, u, dt, k);
+  k = x + dt * k;
+  return k;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt) {
+  vector_t k;
+  VectorFunctionLinearApproximation stage = solveImplicitMidpointStage(system, t, x, u, dt, k);
+
+  // Differentiating k = f(x + dt/2 * k, u) gives (Id - dt/2 * dfdx) dk = dfdx dx + dfdu du
+  matrix_t newtonMatrix = -(dt / 2.0) * stage.dfdx;
+  newtonMatrix.diagonal().array() += 1.0;  // plus Identity()
+  const Eigen::PartialPivLU<matrix_t> lu(newtonMatrix);
+
+  // Assemble discrete approximation
+  // Re-use stage to collect the result
+  stage.dfdx = dt * lu.solve(stage.dfdx);
+  stage.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  stage.dfdu = dt * lu.solve(stage.dfdu);
+  stage.f = x + dt * k;
+  return stage;
+}
+
+}  // namespace ocs2
@@ -44,6 +44,7 @@
 #include <ocs2_core/initialization/OperatingPoints.h>
 
 // Integration
+#include <ocs2_core/integration/FixedStepIntegrator.h>
 #include <ocs2_core/integration/Integrator.h>
 #include <ocs2_core/integration/IntegratorBase.h>
 #include <ocs2_core/integration/Observer.h>
@@ -55,6 +56,7 @@
 
 // Logic
 #include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
 
 // Loopshaping
@@ -71,7 +73,9 @@
 #include <ocs2_core/misc/randomMatrices.h>
 
 // thread_support
+#include <ocs2_core/thread_support/AdaptiveThreadCount.h>
 #include <ocs2_core/thread_support/BufferedValue.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/Synchronized.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
@@ -79,6 +83,7 @@
 // model_data
 #include <ocs2_core/model_data/ModelData.h>
 #include <ocs2_core/model_data/ModelDataLinearInterpolation.h>
+#include <ocs2_core/model_data/MultiplierTrajectory.h>
 
 // soft_constraint
 #include <ocs2_core/soft_constraint/StateInputSoftConstraint.h>
@@ -0,0 +1,117 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/loopshaping/LoopshapingApproximation.h"
+
+namespace ocs2 {
+namespace loopshaping {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eliminatePatternQuadraticApproximation(const LoopshapingDefinition& definition, const ScalarFunctionQuadraticApproximation& L_system,
+                                            ScalarFunctionQuadraticApproximation& L) {
+  const auto& s_filter = definition.getInputFilter();
+  const auto sysStateDim = L_system.dfdx.rows();
+  const auto filtStateDim = static_cast<Eigen::Index>(s_filter.getNumStates());
+  const auto stateDim = sysStateDim + filtStateDim;
+  const auto inputDim = static_cast<Eigen::Index>(s_filter.getNumInputs());
+
+  L.f = L_system.f;
+  L.dfdx.resize(stateDim);
+  L.dfdxx.resize(stateDim, stateDim);
+  L.dfdux.resize(inputDim, stateDim);
+
+  // system blocks
+  L.dfdx.head(sysStateDim) = L_system.dfdx;
+  L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
+
+  if (definition.isDiagonal()) {
+    const auto& c = s_filter.getCdiag();
+    const auto& d = s_filter.getDdiag();
+
+    // dfdx & dfdu
+    L.dfdx.tail(filtStateDim) = c.diagonal().cwiseProduct(L_system.dfdu);
+    L.dfdu = d.diagonal().cwiseProduct(L_system.dfdu);
+
+    // dfdxx
+    L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).noalias() = c * L_system.dfdux;
+    L.dfdxx.topRightCorner(sysStateDim, filtStateDim) = L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).transpose();
+    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim) = s_filter.getScalingCdiagCdiag().cwiseProduct(L_system.dfduu);
+
+    // dfduu & dfdux
+    L.dfduu = s_filter.getScalingDdiagDdiag().cwiseProduct(L_system.dfduu);
+    L.dfdux.leftCols(sysStateDim).noalias() = d * L_system.dfdux;
+    L.dfdux.rightCols(filtStateDim) = s_filter.getScalingDdiagCdiag().cwiseProduct(L_system.dfduu);
+
+  } else {
+    const auto& C = s_filter.getC();
+    const auto& D = s_filter.getD();
+
+    // dfdx & dfdu
+    L.dfdx.tail(filtStateDim).noalias() = C.transpose() * L_system.dfdu;
+    L.dfdu.noalias() = D.transpose() * L_system.dfdu;
+
+    // dfdxx
+    const matrix_t dfduu_C = L_system.dfduu * C;
+    L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).noalias() = C.transpose() * L_system.dfdux;
+    L.dfdxx.topRightCorner(sysStateDim, filtStateDim) = L.dfdxx.bottomLeftCorner(filtStateDim, sysStateDim).transpose();
+    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim).noalias() = C.transpose() * dfduu_C;
+
+    // dfduu & dfdux
+    const matrix_t dfduu_D = L_system.dfduu * D;
+    L.dfduu.noalias() = D.transpose() * dfduu_D;
+    L.dfdux.leftCols(sysStateDim).noalias() = D.transpose() * L_system.dfdux;
+    L.dfdux.rightCols(filtStateDim).noalias() = D.transpose() * dfduu_C;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eliminatePatternLinearApproximation(const LoopshapingDefinition& definition, const matrix_t& dfdx_system, const matrix_t& dfdu_system,
+                                         matrix_t& dfdx, matrix_t& dfdu) {
+  const auto& s_filter = definition.getInputFilter();
+  const auto numRows = dfdx_system.rows();
+  const auto sysStateDim = dfdx_system.cols();
+  const auto filtStateDim = static_cast<Eigen::Index>(s_filter.getNumStates());
+
+  dfdx.resize(numRows, sysStateDim + filtStateDim);
+  dfdx.leftCols(sysStateDim) = dfdx_system;
+  if (definition.isDiagonal()) {
+    dfdx.rightCols(filtStateDim).noalias() = dfdu_system * s_filter.getCdiag();
+    dfdu.noalias() = dfdu_system * s_filter.getDdiag();
+  } else {
+    dfdx.rightCols(filtStateDim).noalias() = dfdu_system * s_filter.getC();
+    dfdu.noalias() = dfdu_system * s_filter.getD();
+  }
+}
+
+}  // namespace loopshaping
+}  // namespace ocs2
@@ -47,6 +47,13 @@ LoopshapingDefinition::LoopshapingDefinition(LoopshapingType loopshapingType, Fi
   if (R_.size() == 0) {  // No cost provided
     R_.setIdentity(filter_.getNumInputs(), filter_.getNumInputs());
   }
+
+  // Constant blocks of the cost on the filter output
+  const matrix_t RC = R_ * filter_.getC();
+  const matrix_t RD = R_ * filter_.getD();
+  CtRC_.noalias() = filter_.getC().transpose() * RC;
+  DtRC_.noalias() = filter_.getD().transpose() * RC;
+  DtRD_.noalias() = filter_.getD().transpose() * RD;
 }
 
 void LoopshapingDefinition::print() const {
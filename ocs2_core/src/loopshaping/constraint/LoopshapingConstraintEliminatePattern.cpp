@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/loopshaping/LoopshapingApproximation.h>
 #include <ocs2_core/loopshaping/LoopshapingPreComputation.h>
 #include <ocs2_core/loopshaping/constraint/LoopshapingConstraintEliminatePattern.h>
 
@@ -42,38 +43,17 @@ VectorFunctionLinearApproximation LoopshapingConstraintEliminatePattern::getLine
     return VectorFunctionLinearApproximation::Zero(0, x.rows(), u.rows());
   }
 
-  const bool isDiagonal = loopshapingDefinition_->isDiagonal();
-  const auto& s_filter = loopshapingDefinition_->getInputFilter();
   const auto& preCompLS = cast<LoopshapingPreComputation>(preComp);
   const auto& preComp_system = preCompLS.getSystemPreComputation();
   const auto& x_system = preCompLS.getSystemState();
   const auto& u_system = preCompLS.getSystemInput();
-  const auto stateDim = x.rows();
-  const auto sysStateDim = x_system.rows();
-  const auto filtStateDim = s_filter.getNumStates();
 
   // Not const so we can move
   auto g_system = StateInputConstraintCollection::getLinearApproximation(t, x_system, u_system, preComp_system);
-  const auto numConstraints = g_system.f.rows();
 
   VectorFunctionLinearApproximation g;
   g.f = std::move(g_system.f);
-
-  // dfdx
-  g.dfdx.resize(numConstraints, stateDim);
-  g.dfdx.leftCols(sysStateDim) = g_system.dfdx;
-  if (isDiagonal) {
-    g.dfdx.rightCols(filtStateDim).noalias() = g_system.dfdu * s_filter.getCdiag();
-  } else {
-    g.dfdx.rightCols(filtStateDim).noalias() = g_system.dfdu * s_filter.getC();
-  }
-
-  // dfdu
-  if (isDiagonal) {
-    g.dfdu.noalias() = g_system.dfdu * s_filter.getDdiag();
-  } else {
-    g.dfdu.noalias() = g_system.dfdu * s_filter.getD();
-  }
+  loopshaping::eliminatePatternLinearApproximation(*loopshapingDefinition_, g_system.dfdx, g_system.dfdu, g.dfdx, g.dfdu);
 
   return g;
 }
@@ -107,15 +87,7 @@ VectorFunctionQuadraticApproximation LoopshapingConstraintEliminatePattern::getQ
   VectorFunctionQuadraticApproximation h;
   h.f = std::move(h_system.f);
 
-  h.dfdx.resize(numConstraints, stateDim);
-  h.dfdx.leftCols(sysStateDim) = h_system.dfdx;
-  if (isDiagonal) {
-    h.dfdx.rightCols(filtStateDim).noalias() = h_system.dfdu * s_filter.getCdiag();
-    h.dfdu.noalias() = h_system.dfdu * s_filter.getDdiag();
-  } else {
-    h.dfdx.rightCols(filtStateDim).noalias() = h_system.dfdu * s_filter.getC();
-    h.dfdu.noalias() = h_system.dfdu * s_filter.getD();
-  }
+  loopshaping::eliminatePatternLinearApproximation(*loopshapingDefinition_, h_system.dfdx, h_system.dfdu, h.dfdx, h.dfdu);
 
   h.dfdxx.resize(numConstraints);
   h.dfduu.resize(numConstraints);
@@ -62,44 +62,31 @@ ScalarFunctionQuadraticApproximation LoopshapingCostOutputPattern::getQuadraticA
   ScalarFunctionQuadraticApproximation L;
   L.f = L_system.f + 0.5 * u_filter.dot(Ru_filter);
 
+  // dfdx & dfdu
+  L.dfdx.resize(stateDim);
+  L.dfdx.head(sysStateDim) = L_system.dfdx;
+  L.dfdu = std::move(L_system.dfdu);
   if (isDiagonal) {
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
     L.dfdx.tail(filtStateDim) = r_filter.getCdiag().diagonal().cwiseProduct(Ru_filter);
-
-    L.dfdxx.setZero(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim) = r_filter.getScalingCdiagCdiag().cwiseProduct(Rfilter);
-
-    L.dfdu = L_system.dfdu + r_filter.getDdiag().diagonal().cwiseProduct(Ru_filter);
-    L.dfduu = L_system.dfduu + r_filter.getScalingDdiagDdiag().cwiseProduct(Rfilter);
-
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim) = L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim) = r_filter.getScalingDdiagCdiag().cwiseProduct(Rfilter);
-
-    return L;
+    L.dfdu += r_filter.getDdiag().diagonal().cwiseProduct(Ru_filter);
   } else {
-    L.dfdx.resize(stateDim);
-    L.dfdx.head(sysStateDim) = L_system.dfdx;
     L.dfdx.tail(filtStateDim).noalias() = r_filter.getC().transpose() * Ru_filter;
+    L.dfdu.noalias() += r_filter.getD().transpose() * Ru_filter;
+  }
 
-    L.dfdxx.setZero(stateDim, stateDim);
-    L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
-    const matrix_t dfduu_C = Rfilter * r_filter.getC();
-    L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim).noalias() = r_filter.getC().transpose() * dfduu_C;
+  // second order derivatives: the filter blocks are constant
+  L.dfdxx.setZero(stateDim, stateDim);
+  L.dfdxx.topLeftCorner(sysStateDim, sysStateDim) = L_system.dfdxx;
+  L.dfdxx.bottomRightCorner(filtStateDim, filtStateDim) = loopshapingDefinition_->costMatrixFilterStateFilterState();
 
-    L.dfdu = std::move(L_system.dfdu);
-    L.dfdu.noalias() += r_filter.getD().transpose() * Ru_filter;
-    L.dfduu = std::move(L_system.dfduu);
-    L.dfduu.noalias() += r_filter.getD().transpose() * Rfilter * r_filter.getD();
+  L.dfduu = std::move(L_system.dfduu);
+  L.dfduu += loopshapingDefinition_->costMatrixInputInput();
 
-    L.dfdux.resize(inputDim, stateDim);
-    L.dfdux.leftCols(sysStateDim) = L_system.dfdux;
-    L.dfdux.rightCols(filtStateDim).noalias() = r_filter.getD().transpose() * dfduu_C;
+  L.dfdux.resize(inputDim, stateDim);
+  L.dfdux.leftCols(sysStateDim) = L_system.dfdux;
+  L.dfdux.rightCols(filtStateDim) = loopshapingDefinition_->costMatrixInputFilterState();
 
-    return L;
-  }
+  return L;
 }
 
 }  // namespace ocs2
@@ -61,23 +61,27 @@ VectorFunctionLinearApproximation LoopshapingDynamicsEliminatePattern::linearApp
   VectorFunctionLinearApproximation dynamics;
   dynamics.f = loopshapingDefinition_->concatenateSystemAndFilterState(dynamics_system.f, filterFlowmap(x_filter, u_filter, u_system));
 
+  // constant filter blocks
   dynamics.dfdx.resize(stateDim, stateDim);
-  dynamics.dfdx.topLeftCorner(sysStateDim, sysStateDim) = dynamics_system.dfdx;
+  dynamics.dfdu.resize(stateDim, inputDim);
   dynamics.dfdx.bottomLeftCorner(filtStateDim, sysStateDim).setZero();
   if (isDiagonal) {
-    dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim).noalias() = dynamics_system.dfdu * s_filter.getCdiag();
+    dynamics.dfdx.bottomRightCorner(filtStateDim, filtStateDim) = s_filter.getAdiag();
+    dynamics.dfdu.bottomRows(filtStateDim) = s_filter.getBdiag();
   } else {
-    dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim).noalias() = dynamics_system.dfdu * s_filter.getC();
+    dynamics.dfdx.bottomRightCorner(filtStateDim, filtStateDim) = s_filter.getA();
+    dynamics.dfdu.bottomRows(filtStateDim) = s_filter.getB();
   }
-  dynamics.dfdx.bottomRightCorner(filtStateDim, filtStateDim) = s_filter.getA();
 
-  dynamics.dfdu.resize(stateDim, inputDim);
+  // system blocks: [dfdx, dfdu * C] and dfdu * D
+  dynamics.dfdx.topLeftCorner(sysStateDim, sysStateDim) = dynamics_system.dfdx;
   if (isDiagonal) {
+    dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim).noalias() = dynamics_system.dfdu * s_filter.getCdiag();
     dynamics.dfdu.topRows(sysStateDim).noalias() = dynamics_system.dfdu * s_filter.getDdiag();
   } else {
+    dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim).noalias() = dynamics_system.dfdu * s_filter.getC();
     dynamics.dfdu.topRows(sysStateDim).noalias() = dynamics_system.dfdu * s_filter.getD();
   }
-  dynamics.dfdu.bottomRows(filtStateDim) = s_filter.getB();
 
   return dynamics;
 }
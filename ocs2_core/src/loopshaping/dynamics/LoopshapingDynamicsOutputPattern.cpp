@@ -50,7 +50,7 @@ VectorFunctionLinearApproximation LoopshapingDynamicsOutputPattern::linearApprox
   const auto& u_system = preCompLS.getSystemInput();
   const auto& x_filter = preCompLS.getFilterState();
   const auto& u_filter = preCompLS.getFilteredInput();
-  const auto dynamics_system = systemDynamics_->linearApproximation(t, x_system, u_system);
+  const auto dynamics_system = systemDynamics_->linearApproximation(t, x_system, u_system, preCompLS.getSystemPreComputation());
 
   const auto stateDim = x.rows();
   const auto inputDim = u.rows();
@@ -64,11 +64,15 @@ VectorFunctionLinearApproximation LoopshapingDynamicsOutputPattern::linearApprox
   dynamics.dfdx.topLeftCorner(sysStateDim, sysStateDim) = dynamics_system.dfdx;
   dynamics.dfdx.bottomLeftCorner(filtStateDim, sysStateDim).setZero();
   dynamics.dfdx.topRightCorner(sysStateDim, filtStateDim).setZero();
-  dynamics.dfdx.bottomRightCorner(filtStateDim, filtStateDim) = r_filter.getA();
-
   dynamics.dfdu.resize(stateDim, inputDim);
   dynamics.dfdu.topRows(sysStateDim) = dynamics_system.dfdu;
-  dynamics.dfdu.bottomRows(filtStateDim) = r_filter.getB();
+  if (loopshapingDefinition_->isDiagonal()) {
+    dynamics.dfdx.bottomRightCorner(filtStateDim, filtStateDim) = r_filter.getAdiag();
+    dynamics.dfdu.bottomRows(filtStateDim) = r_filter.getBdiag();
+  } else {
+    dynamics.dfdx.bottomRightCorner(filtStateDim, filtStateDim) = r_filter.getA();
+    dynamics.dfdu.bottomRows(filtStateDim) = r_filter.getB();
+  }
 
   return dynamics;
 }
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LinearAlgebra.h>
 
+#include <algorithm>
+
 namespace ocs2 {
 namespace LinearAlgebra {
 
@@ -117,6 +119,82 @@ void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT,
   RmInvConstrainedUUT.noalias() = RmInvUmUmT * QRof_RmInvUmUmTT_DmT_Qu;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void accumulateWeightedGram(const matrix_t& dhdx, const matrix_t& dhdu, const vector_t& gradientWeights, const vector_t& hessianWeights,
+                            ScalarFunctionQuadraticApproximation& accumulator) {
+  const auto numRows = hessianWeights.size();
+  const auto stateDim = dhdx.cols();
+  const auto inputDim = dhdu.cols();
+  assert(dhdx.rows() == numRows);
+  assert(gradientWeights.size() == numRows);
+
+  accumulator.dfdx.noalias() += dhdx.transpose() * gradientWeights;
+  if (inputDim > 0) {
+    accumulator.dfdu.noalias() += dhdu.transpose() * gradientWeights;
+  }
+
+  // rows scaled by sqrt(|W|): the ones with positive weights on top and the ones with negative weights at the bottom
+  const Eigen::Index numPositive = (hessianWeights.array() > 0.0).count();
+  const Eigen::Index numNegative = (hessianWeights.array() < 0.0).count();
+  if (numPositive + numNegative == 0) {
+    return;
+  }
+
+  // The scaled rows are written into scratch buffers which are reused by the later calls on the same thread. The buffers only grow,
+  // so once the largest constraint of a thread has been seen, no memory is allocated.
+  thread_local matrix_t scaledDhdxBuffer;
+  thread_local matrix_t scaledDhduBuffer;
+  const Eigen::Index numScaled = numPositive + numNegative;
+  auto reserveRows = [numScaled](matrix_t& buffer, Eigen::Index cols) {
+    if (buffer.rows() < numScaled || buffer.cols() != cols) {
+      buffer.resize(std::max(numScaled, buffer.rows()), cols);
+    }
+  };
+  reserveRows(scaledDhdxBuffer, stateDim);
+  if (inputDim > 0) {
+    reserveRows(scaledDhduBuffer, inputDim);
+  }
+  auto scaledDhdx = scaledDhdxBuffer.topRows(numScaled);
+  auto scaledDhdu = scaledDhduBuffer.topRows(inputDim > 0 ? numScaled : 0);
+
+  Eigen::Index positiveInd = 0;
+  Eigen::Index negativeInd = numPositive;
+  for (Eigen::Index i = 0; i < numRows; i++) {
+    const scalar_t weight = hessianWeights(i);
+    if (weight != 0.0) {
+      auto& ind = (weight > 0.0) ? positiveInd : negativeInd;
+      const scalar_t sqrtWeight = std::sqrt(std::abs(weight));
+      scaledDhdx.row(ind) = sqrtWeight * dhdx.row(i);
+      if (inputDim > 0) {
+        scaledDhdu.row(ind) = sqrtWeight * dhdu.row(i);
+      }
+      ind++;
+    }
+  }
+
+  // symmetric block: rank-k update of the lower triangle which is then copied to the upper triangle
+  auto addSymmetricGram = [&](const Eigen::Ref<const matrix_t>& scaledDh, matrix_t& hessian) {
+    if (numPositive > 0) {
+      hessian.selfadjointView<Eigen::Lower>().rankUpdate(scaledDh.topRows(numPositive).transpose(), 1.0);
+    }
+    if (numNegative > 0) {
+      hessian.selfadjointView<Eigen::Lower>().rankUpdate(scaledDh.bottomRows(numNegative).transpose(), -1.0);
+    }
+    hessian.triangularView<Eigen::StrictlyUpper>() = hessian.transpose();
+  };
+
+  addSymmetricGram(scaledDhdx, accumulator.dfdxx);
+  if (inputDim > 0) {
+    addSymmetricGram(scaledDhdu, accumulator.dfduu);
+    accumulator.dfdux.noalias() += scaledDhdu.topRows(numPositive).transpose() * scaledDhdx.topRows(numPositive);
+    if (numNegative > 0) {
+      accumulator.dfdux.noalias() -= scaledDhdu.bottomRows(numNegative).transpose() * scaledDhdx.bottomRows(numNegative);
+    }
+  }
+}
+
 // Explicit instantiations for dynamic sized matrices
 template int rank(const matrix_t& A);
 template Eigen::VectorXcd eigenvalues(const matrix_t& A);
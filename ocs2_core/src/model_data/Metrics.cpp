@@ -169,6 +169,10 @@ MetricsCollection interpolate(const index_alpha_t& indexAlpha, const std::vector
     out.stateInputIneqLagrangian.emplace_back(penalty, std::move(constraint));
   }  // end of i loop
 
+  // inequality active-set statistics of the nearest node
+  out.numSkippedIneqTerms = dataArray[ind].numSkippedIneqTerms;
+  out.numEvaluatedIneqTerms = dataArray[ind].numEvaluatedIneqTerms;
+
   return out;
 }
 
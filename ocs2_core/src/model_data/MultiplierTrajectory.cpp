@@ -0,0 +1,226 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/model_data/MultiplierTrajectory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace ocs2 {
+
+namespace {
+
+std::array<const std::vector<Multiplier>*, MultiplierTrajectory::numTermTypes> getTerms(const MultiplierCollection& multiplierCollection) {
+  return {&multiplierCollection.stateEq, &multiplierCollection.stateIneq, &multiplierCollection.stateInputEq,
+          &multiplierCollection.stateInputIneq};
+}
+
+std::array<std::vector<Multiplier>*, MultiplierTrajectory::numTermTypes> getTerms(MultiplierCollection& multiplierCollection) {
+  return {&multiplierCollection.stateEq, &multiplierCollection.stateIneq, &multiplierCollection.stateInputEq,
+          &multiplierCollection.stateInputIneq};
+}
+
+}  // namespace
+
+constexpr size_t MultiplierTrajectory::numTermTypes;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiplierTrajectory::Layout::Layout(const MultiplierCollection& multiplierCollection) {
+  const auto terms = getTerms(multiplierCollection);
+  for (size_t t = 0; t < numTermTypes; t++) {
+    termSizes[t] = getSizes(*terms[t]);
+    termOffsets[t].resize(termSizes[t].size());
+    for (size_t i = 0; i < termSizes[t].size(); i++) {
+      termOffsets[t][i] = size;
+      size += 1 + termSizes[t][i];
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MultiplierTrajectory::Layout::hasSameSizes(const MultiplierCollection& multiplierCollection) const {
+  const auto terms = getTerms(multiplierCollection);
+  for (size_t t = 0; t < numTermTypes; t++) {
+    if (terms[t]->size() != termSizes[t].size()) {
+      return false;
+    }
+    for (size_t i = 0; i < termSizes[t].size(); i++) {
+      if (static_cast<size_t>((*terms[t])[i].lagrangian.size()) != termSizes[t][i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MultiplierTrajectory::MultiplierTrajectory(const std::vector<MultiplierCollection>& multiplierCollectionTrajectory) {
+  assign(multiplierCollectionTrajectory);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::clear() {
+  buffer_.clear();
+  nodeOffsets_.clear();
+  nodeLayoutIndices_.clear();
+  layouts_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::assign(const std::vector<MultiplierCollection>& multiplierCollectionTrajectory) {
+  clear();
+  nodeOffsets_.reserve(multiplierCollectionTrajectory.size());
+  nodeLayoutIndices_.reserve(multiplierCollectionTrajectory.size());
+  for (const auto& multiplierCollection : multiplierCollectionTrajectory) {
+    push_back(multiplierCollection);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::reserve(size_t numNodes, size_t bufferSize) {
+  buffer_.reserve(bufferSize);
+  nodeOffsets_.reserve(numNodes);
+  nodeLayoutIndices_.reserve(numNodes);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::push_back(const MultiplierCollection& multiplierCollection) {
+  // consecutive nodes mostly share the layout, therefore the layout of the previous node is checked first
+  size_t layoutIndex = nodeLayoutIndices_.empty() ? 0 : nodeLayoutIndices_.back();
+  if (layoutIndex >= layouts_.size() || !layouts_[layoutIndex].hasSameSizes(multiplierCollection)) {
+    const auto layoutItr = std::find_if(layouts_.cbegin(), layouts_.cend(),
+                                        [&](const Layout& layout) { return layout.hasSameSizes(multiplierCollection); });
+    layoutIndex = std::distance(layouts_.cbegin(), layoutItr);
+    if (layoutItr == layouts_.cend()) {
+      layouts_.emplace_back(multiplierCollection);
+    }
+  }
+  const auto& layout = layouts_[layoutIndex];
+
+  // pack
+  const size_t nodeOffset = buffer_.size();
+  buffer_.resize(nodeOffset + layout.size);
+  const auto terms = getTerms(multiplierCollection);
+  for (size_t t = 0; t < numTermTypes; t++) {
+    for (size_t i = 0; i < terms[t]->size(); i++) {
+      const auto& multiplier = (*terms[t])[i];
+      scalar_t* data = buffer_.data() + nodeOffset + layout.termOffsets[t][i];
+      data[0] = multiplier.penalty;
+      std::copy(multiplier.lagrangian.data(), multiplier.lagrangian.data() + multiplier.lagrangian.size(), data + 1);
+    }
+  }
+
+  nodeOffsets_.push_back(nodeOffset);
+  nodeLayoutIndices_.push_back(layoutIndex);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::get(size_t index, MultiplierCollection& multiplierCollection) const {
+  const scalar_t* data = buffer_.data() + nodeOffsets_[index];
+  unpack(layout(index), data, data, 1.0, multiplierCollection);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::interpolate(const LinearInterpolation::index_alpha_t& indexAlpha,
+                                       MultiplierCollection& multiplierCollection) const {
+  assert(!empty());
+  if (size() == 1) {
+    get(0, multiplierCollection);
+    return;
+  }
+
+  const size_t index = indexAlpha.first;
+  const scalar_t alpha = indexAlpha.second;
+  if (nodeLayoutIndices_[index] == nodeLayoutIndices_[index + 1]) {
+    unpack(layout(index), buffer_.data() + nodeOffsets_[index], buffer_.data() + nodeOffsets_[index + 1], alpha, multiplierCollection);
+  } else {
+    get((alpha > 0.5) ? index : index + 1, multiplierCollection);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::shift(size_t numNodes) {
+  if (numNodes >= size()) {
+    buffer_.clear();
+    nodeOffsets_.clear();
+    nodeLayoutIndices_.clear();
+    return;
+  }
+
+  const size_t removedSize = nodeOffsets_[numNodes];
+  std::memmove(buffer_.data(), buffer_.data() + removedSize, (buffer_.size() - removedSize) * sizeof(scalar_t));
+  buffer_.resize(buffer_.size() - removedSize);
+
+  nodeOffsets_.erase(nodeOffsets_.begin(), nodeOffsets_.begin() + numNodes);
+  std::for_each(nodeOffsets_.begin(), nodeOffsets_.end(), [removedSize](size_t& offset) { offset -= removedSize; });
+  nodeLayoutIndices_.erase(nodeLayoutIndices_.begin(), nodeLayoutIndices_.begin() + numNodes);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MultiplierTrajectory::unpack(const Layout& layout, const scalar_t* lhs, const scalar_t* rhs, scalar_t alpha,
+                                  MultiplierCollection& multiplierCollection) {
+  const auto terms = getTerms(multiplierCollection);
+  for (size_t t = 0; t < numTermTypes; t++) {
+    auto& termsMultiplier = *terms[t];
+    termsMultiplier.resize(layout.termSizes[t].size());
+    for (size_t i = 0; i < termsMultiplier.size(); i++) {
+      const size_t offset = layout.termOffsets[t][i];
+      const auto size = static_cast<Eigen::Index>(layout.termSizes[t][i]);
+      termsMultiplier[i].penalty = alpha * lhs[offset] + (1.0 - alpha) * rhs[offset];
+      // only allocates if the size has changed
+      termsMultiplier[i].lagrangian = alpha * Eigen::Map<const vector_t>(lhs + offset + 1, size) +
+                                      (1.0 - alpha) * Eigen::Map<const vector_t>(rhs + offset + 1, size);
+    }
+  }
+}
+
+}  // namespace ocs2
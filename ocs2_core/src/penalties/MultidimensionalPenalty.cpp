@@ -27,8 +27,10 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 
+#include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
 namespace ocs2 {
@@ -49,6 +51,12 @@ class PenaltyBaseWrapper final : public augmented::AugmentedPenaltyBase {
   scalar_t getDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return penaltyPtr_->getDerivative(t, h); }
   scalar_t getSecondDerivative(scalar_t t, scalar_t l, scalar_t h) const override { return penaltyPtr_->getSecondDerivative(t, h); }
 
+  scalar_t getTotalValue(scalar_t t, const vector_t* l, const vector_t& h) const override { return penaltyPtr_->getTotalValue(t, h); }
+  scalar_t getTotalValue1stDev2ndDev(scalar_t t, const vector_t* l, const vector_t& h, vector_t& derivative,
+                                     vector_t& secondDerivative) const override {
+    return penaltyPtr_->getTotalValue1stDev2ndDev(t, h, derivative, secondDerivative);
+  }
+
   scalar_t updateMultiplier(scalar_t t, scalar_t l, scalar_t h) const override {
     throw std::runtime_error("[" + name() + "] This penalty is only applicable to soft constraints!");
   }
@@ -125,10 +133,15 @@ scalar_t MultidimensionalPenalty::getValue(scalar_t t, const vector_t& h, const
   const auto numConstraints = h.rows();
   assert(penaltyPtrArray_.size() == 1 || penaltyPtrArray_.size() == numConstraints);
 
+  // a single penalty function is evaluated for all the constraints in one call
+  if (penaltyPtrArray_.size() == 1) {
+    return penaltyPtrArray_[0]->getTotalValue(t, l, h);
+  }
+
+  // one penalty function per constraint
   scalar_t penalty = 0;
   for (size_t i = 0; i < numConstraints; i++) {
-    const auto& penaltyTerm = (penaltyPtrArray_.size() == 1) ? penaltyPtrArray_[0] : penaltyPtrArray_[i];
-    penalty += penaltyTerm->getValue(t, getMultiplier(l, i), h(i));
+    penalty += penaltyPtrArray_[i]->getValue(t, getMultiplier(l, i), h(i));
   }
 
   return penalty;
@@ -146,19 +159,12 @@ ScalarFunctionQuadraticApproximation MultidimensionalPenalty::getQuadraticApprox
   scalar_t penaltyValue = 0.0;
   vector_t penaltyDerivative, penaltySecondDerivative;
   std::tie(penaltyValue, penaltyDerivative, penaltySecondDerivative) = getPenaltyValue1stDev2ndDev(t, h.f, l);
-  const matrix_t penaltySecondDev_dhdx = penaltySecondDerivative.asDiagonal() * h.dfdx;
 
   // to make sure that dfdux in the state-only case has a right size
-  ScalarFunctionQuadraticApproximation penaltyApproximation(stateDim, inputDim);
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
 
   penaltyApproximation.f = penaltyValue;
-  penaltyApproximation.dfdx.noalias() = h.dfdx.transpose() * penaltyDerivative;
-  penaltyApproximation.dfdxx.noalias() = h.dfdx.transpose() * penaltySecondDev_dhdx;
-  if (inputDim > 0) {
-    penaltyApproximation.dfdu.noalias() = h.dfdu.transpose() * penaltyDerivative;
-    penaltyApproximation.dfdux.noalias() = h.dfdu.transpose() * penaltySecondDev_dhdx;
-    penaltyApproximation.dfduu.noalias() = h.dfdu.transpose() * penaltySecondDerivative.asDiagonal() * h.dfdu;
-  }
+  LinearAlgebra::accumulateWeightedGram(h.dfdx, h.dfdu, penaltyDerivative, penaltySecondDerivative, penaltyApproximation);
 
   return penaltyApproximation;
 }
@@ -176,22 +182,17 @@ ScalarFunctionQuadraticApproximation MultidimensionalPenalty::getQuadraticApprox
   scalar_t penaltyValue = 0.0;
   vector_t penaltyDerivative, penaltySecondDerivative;
   std::tie(penaltyValue, penaltyDerivative, penaltySecondDerivative) = getPenaltyValue1stDev2ndDev(t, h.f, l);
-  const matrix_t penaltySecondDev_dhdx = penaltySecondDerivative.asDiagonal() * h.dfdx;
 
   // to make sure that dfdux in the state-only case has a right size
-  ScalarFunctionQuadraticApproximation penaltyApproximation(stateDim, inputDim);
+  auto penaltyApproximation = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
 
   penaltyApproximation.f = penaltyValue;
-  penaltyApproximation.dfdx.noalias() = h.dfdx.transpose() * penaltyDerivative;
-  penaltyApproximation.dfdxx.noalias() = h.dfdx.transpose() * penaltySecondDev_dhdx;
+  LinearAlgebra::accumulateWeightedGram(h.dfdx, h.dfdu, penaltyDerivative, penaltySecondDerivative, penaltyApproximation);
   for (size_t i = 0; i < numConstraints; i++) {
     penaltyApproximation.dfdxx.noalias() += penaltyDerivative(i) * h.dfdxx[i];
   }
 
   if (inputDim > 0) {
-    penaltyApproximation.dfdu.noalias() = h.dfdu.transpose() * penaltyDerivative;
-    penaltyApproximation.dfdux.noalias() = h.dfdu.transpose() * penaltySecondDev_dhdx;
-    penaltyApproximation.dfduu.noalias() = h.dfdu.transpose() * penaltySecondDerivative.asDiagonal() * h.dfdu;
     for (size_t i = 0; i < numConstraints; i++) {
       penaltyApproximation.dfduu.noalias() += penaltyDerivative(i) * h.dfduu[i];
       penaltyApproximation.dfdux.noalias() += penaltyDerivative(i) * h.dfdux[i];
@@ -212,8 +213,16 @@ std::tuple<scalar_t, vector_t, vector_t> MultidimensionalPenalty::getPenaltyValu
   scalar_t penaltyValue = 0.0;
   vector_t penaltyDerivative(numConstraints);
   vector_t penaltySecondDerivative(numConstraints);
+
+  // a single penalty function is evaluated for all the constraints in one call
+  if (penaltyPtrArray_.size() == 1) {
+    penaltyValue = penaltyPtrArray_[0]->getTotalValue1stDev2ndDev(t, l, h, penaltyDerivative, penaltySecondDerivative);
+    return {penaltyValue, penaltyDerivative, penaltySecondDerivative};
+  }
+
+  // one penalty function per constraint
   for (size_t i = 0; i < numConstraints; i++) {
-    const auto& penaltyTerm = (penaltyPtrArray_.size() == 1) ? penaltyPtrArray_[0] : penaltyPtrArray_[i];
+    const auto& penaltyTerm = penaltyPtrArray_[i];
     penaltyValue += penaltyTerm->getValue(t, getMultiplier(l, i), h(i));
     penaltyDerivative(i) = penaltyTerm->getDerivative(t, getMultiplier(l, i), h(i));
     penaltySecondDerivative(i) = penaltyTerm->getSecondDerivative(t, getMultiplier(l, i), h(i));
@@ -222,6 +231,32 @@ std::tuple<scalar_t, vector_t, vector_t> MultidimensionalPenalty::getPenaltyValu
   return {penaltyValue, penaltyDerivative, penaltySecondDerivative};
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MultidimensionalPenalty::isLocallyConstant(scalar_t t, const vector_t& h, const vector_t* l) const {
+  const auto numConstraints = h.rows();
+  assert(penaltyPtrArray_.size() == 1 || penaltyPtrArray_.size() == numConstraints);
+
+  for (size_t i = 0; i < numConstraints; i++) {
+    const auto& penaltyTerm = (penaltyPtrArray_.size() == 1) ? penaltyPtrArray_[0] : penaltyPtrArray_[i];
+    if (!penaltyTerm->isLocallyConstant(t, getMultiplier(l, i), h(i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MultidimensionalPenalty::hasLocallyConstantRegion() const {
+  return std::all_of(penaltyPtrArray_.begin(), penaltyPtrArray_.end(), [](const std::unique_ptr<augmented::AugmentedPenaltyBase>& penaltyPtr) {
+    return penaltyPtr->hasLocallyConstantRegion();
+  });
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
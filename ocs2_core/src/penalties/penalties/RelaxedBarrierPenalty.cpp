@@ -65,4 +65,25 @@ scalar_t RelaxedBarrierPenalty::getSecondDerivative(scalar_t t, scalar_t h) cons
   };
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t RelaxedBarrierPenalty::getTotalValue(scalar_t t, const vector_t& h) const {
+  const auto delta_h = (h.array() - 2.0 * config_.delta) / config_.delta;
+  const auto relaxedValue = config_.mu * (-log(config_.delta) + 0.5 * delta_h.square() - 0.5);
+  return (h.array() > config_.delta).select(-config_.mu * h.array().log(), relaxedValue).sum();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t RelaxedBarrierPenalty::getTotalValue1stDev2ndDev(scalar_t t, const vector_t& h, vector_t& derivative,
+                                                          vector_t& secondDerivative) const {
+  const scalar_t deltaSquare = config_.delta * config_.delta;
+  const auto isBarrier = (h.array() > config_.delta);
+  derivative = isBarrier.select(-config_.mu / h.array(), config_.mu * (h.array() - 2.0 * config_.delta) / deltaSquare).matrix();
+  secondDerivative = isBarrier.select(config_.mu / h.array().square(), config_.mu / deltaSquare).matrix();
+  return getTotalValue(t, h);
+}
+
 }  // namespace ocs2
@@ -65,4 +65,22 @@ scalar_t SquaredHingePenalty::getSecondDerivative(scalar_t t, scalar_t h) const
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t SquaredHingePenalty::getTotalValue(scalar_t t, const vector_t& h) const {
+  return config_.mu * 0.5 * (h.array() - config_.delta).min(0.0).square().sum();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t SquaredHingePenalty::getTotalValue1stDev2ndDev(scalar_t t, const vector_t& h, vector_t& derivative,
+                                                        vector_t& secondDerivative) const {
+  const auto delta_h = (h.array() - config_.delta).min(0.0);
+  derivative = (config_.mu * delta_h).matrix();
+  secondDerivative = (config_.mu * (h.array() < config_.delta).cast<scalar_t>()).matrix();
+  return config_.mu * 0.5 * delta_h.square().sum();
+}
+
 }  // namespace ocs2
@@ -0,0 +1,141 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/reference/SampledTargetTrajectories.h"
+
+#include <algorithm>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+SampledTargetTrajectories::SampledTargetTrajectories(const TargetTrajectories& targetTrajectories, const scalar_array_t& timeGrid) {
+  update(targetTrajectories, timeGrid);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void SampledTargetTrajectories::update(const TargetTrajectories& targetTrajectories, const scalar_array_t& timeGrid) {
+  targetTrajectoriesPtr_ = &targetTrajectories;
+  if (targetTrajectories.empty()) {
+    sampleTimes_.clear();
+    sampledStates_.clear();
+    sampledInputs_.clear();
+    return;
+  }
+
+  const auto& timeTrajectory = targetTrajectories.timeTrajectory;
+  sampleTimes_ = timeGrid;
+  sampledStates_.resize(timeGrid.size());
+  for (size_t i = 0; i < timeGrid.size(); i++) {
+    sampledStates_[i] = LinearInterpolation::interpolate(timeGrid[i], timeTrajectory, targetTrajectories.stateTrajectory);
+  }
+  sampledInputs_.resize(targetTrajectories.inputTrajectory.empty() ? 0 : timeGrid.size());
+  for (size_t i = 0; i < sampledInputs_.size(); i++) {
+    sampledInputs_[i] = LinearInterpolation::interpolate(timeGrid[i], timeTrajectory, targetTrajectories.inputTrajectory);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+void SampledTargetTrajectories::clear() {
+  targetTrajectoriesPtr_ = nullptr;
+  sampleTimes_.clear();
+  sampledStates_.clear();
+  sampledInputs_.clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+vector_t SampledTargetTrajectories::getDesiredState(scalar_t time, size_t& hint) const {
+  if (targetTrajectoriesPtr_ == nullptr) {
+    throw std::runtime_error("[SampledTargetTrajectories] The view is empty!");
+  }
+
+  const auto sampleIndex = findSample(time, hint);
+  if (sampleIndex < sampledStates_.size()) {
+    return sampledStates_[sampleIndex];
+  } else {
+    return targetTrajectoriesPtr_->getDesiredState(time);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+vector_t SampledTargetTrajectories::getDesiredInput(scalar_t time, size_t& hint) const {
+  if (targetTrajectoriesPtr_ == nullptr) {
+    throw std::runtime_error("[SampledTargetTrajectories] The view is empty!");
+  }
+
+  const auto sampleIndex = findSample(time, hint);
+  if (sampleIndex < sampledInputs_.size()) {
+    return sampledInputs_[sampleIndex];
+  } else {
+    return targetTrajectoriesPtr_->getDesiredInput(time);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+size_t SampledTargetTrajectories::findSample(scalar_t time, size_t& hint) const {
+  const size_t numSamples = sampleTimes_.size();
+  if (numSamples == 0) {
+    return numSamples;
+  }
+
+  // a worker queries the nodes in roughly increasing order, therefore first search around its last hit
+  constexpr size_t searchRadius = 4;
+  hint = std::min(hint, numSamples - 1);
+  const size_t windowBegin = (hint > searchRadius) ? hint - searchRadius : 0;
+  const size_t windowEnd = std::min(hint + searchRadius + 1, numSamples);
+  for (size_t i = windowBegin; i < windowEnd; ++i) {
+    if (sampleTimes_[i] == time) {
+      hint = i;
+      return i;
+    }
+  }
+
+  const auto sampleItr = std::lower_bound(sampleTimes_.cbegin(), sampleTimes_.cend(), time);
+  if (sampleItr != sampleTimes_.cend() && *sampleItr == time) {
+    hint = std::distance(sampleTimes_.cbegin(), sampleItr);
+    return hint;
+  } else {
+    return numSamples;
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/thread_support/AdaptiveThreadCount.h"
+
+#include <algorithm>
+
+namespace ocs2 {
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+AdaptiveThreadCount::AdaptiveThreadCount(size_t maxNumThreads, size_t numSamples, scalar_t minImprovement, size_t reprobePeriod)
+    : maxNumThreads_(std::max(maxNumThreads, size_t(1))),
+      numSamples_(std::max(numSamples, size_t(1))),
+      minImprovement_(minImprovement),
+      reprobePeriod_(reprobePeriod),
+      numThreads_(maxNumThreads_) {
+  reset();
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void AdaptiveThreadCount::reset() {
+  durationSum_ = 0.0;
+  numDurations_ = 0;
+  startSearch(maxNumThreads_);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void AdaptiveThreadCount::startSearch(size_t numThreads) {
+  numThreads_ = numThreads;
+  searching_ = true;
+  referenceNumThreads_ = 0;
+  referenceDuration_ = 0.0;
+  numAssessmentsSinceSearch_ = 0;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void AdaptiveThreadCount::update(scalar_t duration) {
+  durationSum_ += duration;
+  if (++numDurations_ < numSamples_) {
+    return;
+  }
+
+  // assess the current thread count
+  const scalar_t averageDuration = durationSum_ / static_cast<scalar_t>(numDurations_);
+  durationSum_ = 0.0;
+  numDurations_ = 0;
+
+  if (!searching_) {
+    if (++numAssessmentsSinceSearch_ >= reprobePeriod_ && numThreads_ < maxNumThreads_) {
+      startSearch(numThreads_ + 1);
+    }
+    return;
+  }
+
+  if (referenceNumThreads_ > 0) {
+    // the extra thread of the reference pays off: go back to it and stop the search
+    if (referenceDuration_ < (1.0 - minImprovement_) * averageDuration) {
+      numThreads_ = referenceNumThreads_;
+      searching_ = false;
+      return;
+    }
+  }
+
+  // accept the current thread count and probe with one thread less
+  referenceNumThreads_ = numThreads_;
+  referenceDuration_ = averageDuration;
+  if (numThreads_ > 1) {
+    --numThreads_;
+  } else {
+    searching_ = false;
+  }
+}
+
+}  // namespace ocs2
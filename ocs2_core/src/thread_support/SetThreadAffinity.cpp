@@ -0,0 +1,166 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/thread_support/SetThreadAffinity.h"
+
+#include <sched.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace ocs2 {
+
+namespace {
+
+std::string trim(const std::string& str) {
+  const auto first = str.find_first_not_of(" \t\n");
+  if (first == std::string::npos) {
+    return "";
+  }
+  const auto last = str.find_last_not_of(" \t\n");
+  return str.substr(first, last - first + 1);
+}
+
+/** Parses the "0,2,4-7" format of the CPU lists, which is also used by the Linux sysfs. */
+std::vector<int> parseCpuRanges(const std::string& cpuList) {
+  std::vector<int> cpus;
+  std::stringstream stream(cpuList);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    item = trim(item);
+    if (item.empty()) {
+      continue;
+    }
+    try {
+      const auto toCpuId = [](const std::string& str) {
+        size_t numParsed;
+        const int cpu = std::stoi(str, &numParsed);
+        if (numParsed != str.size() || cpu < 0) {
+          throw std::invalid_argument(str);
+        }
+        return cpu;
+      };
+      const auto dash = item.find('-');
+      const int first = toCpuId(trim(item.substr(0, dash)));
+      const int last = (dash == std::string::npos) ? first : toCpuId(trim(item.substr(dash + 1)));
+      if (last < first) {
+        throw std::invalid_argument(item);
+      }
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::logic_error&) {
+      throw std::runtime_error("[parseCpuList] Invalid CPU list entry: \"" + item + "\"");
+    }
+  }
+  return cpus;
+}
+
+bool readFirstLine(const std::string& fileName, std::string& line) {
+  std::ifstream file(fileName);
+  return file.good() && std::getline(file, line);
+}
+
+}  // namespace
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::vector<int> parseCpuList(const std::string& cpuList) {
+  const auto list = trim(cpuList);
+  if (list == "physical") {
+    return getPhysicalCores();
+  }
+  return parseCpuRanges(list);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::vector<int> getPhysicalCores() {
+  const std::string sysfsCpuPath = "/sys/devices/system/cpu/";
+
+  std::string line;
+  std::vector<int> onlineCpus;
+  if (readFirstLine(sysfsCpuPath + "online", line)) {
+    onlineCpus = parseCpuRanges(line);
+  } else {
+    for (int cpu = 0; cpu < static_cast<int>(std::thread::hardware_concurrency()); ++cpu) {
+      onlineCpus.push_back(cpu);
+    }
+  }
+
+  // (package, cpu) of the first hyper-thread sibling of each core
+  std::vector<std::pair<int, int>> cores;
+  for (const auto cpu : onlineCpus) {
+    const auto topologyPath = sysfsCpuPath + "cpu" + std::to_string(cpu) + "/topology/";
+    if (readFirstLine(topologyPath + "thread_siblings_list", line)) {
+      const auto siblings = parseCpuRanges(line);
+      if (!siblings.empty() && *std::min_element(siblings.cbegin(), siblings.cend()) != cpu) {
+        continue;
+      }
+    }
+    const int package = readFirstLine(topologyPath + "physical_package_id", line) ? std::stoi(line) : 0;
+    cores.emplace_back(package, cpu);
+  }
+  std::sort(cores.begin(), cores.end());
+
+  std::vector<int> physicalCores;
+  physicalCores.reserve(cores.size());
+  for (const auto& core : cores) {
+    physicalCores.push_back(core.second);
+  }
+  return physicalCores;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void setThreadAffinity(const std::vector<int>& cpus, pthread_t thread) {
+  if (cpus.empty()) {
+    return;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : cpus) {
+    CPU_SET(cpu, &cpuSet);
+  }
+
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+    std::cerr << "WARNING: Failed to set threads affinity (one possible reason could be "
+                 "that the requested CPUs are not available to this process.)"
+              << std::endl;
+  }
+}
+
+}  // namespace ocs2
@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
@@ -35,11 +36,14 @@ namespace ocs2 {
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, const std::vector<int>& cpus) {
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    if (!cpus.empty()) {
+      setThreadAffinity({cpus[i % cpus.size()]}, workerThreads_.back());
+    }
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
 
 using namespace ocs2;
 
@@ -102,3 +103,42 @@ TEST_F(testQuadraticCost, StateCostClone) {
   auto Lclone = costFunctionClone->getValue(t_, x_, targetTrajectories_, preComputation_);
   EXPECT_NEAR(L, Lclone, PRECISION);
 }
+
+namespace {
+/** Overrides only the deprecated deviation hooks, as code written against the previous interface does */
+class LegacyStateCost final : public QuadraticStateCost {
+ public:
+  using QuadraticStateCost::QuadraticStateCost;
+  LegacyStateCost* clone() const override { return new LegacyStateCost(*this); }
+
+ protected:
+  vector_t getStateDeviation(scalar_t, const vector_t& state, const TargetTrajectories&) const override {
+    return vector_t::Zero(state.size());
+  }
+};
+
+class LegacyStateInputCost final : public QuadraticStateInputCost {
+ public:
+  using QuadraticStateInputCost::QuadraticStateInputCost;
+  LegacyStateInputCost* clone() const override { return new LegacyStateInputCost(*this); }
+
+ protected:
+  std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t, const vector_t& state, const vector_t& input,
+                                                       const TargetTrajectories&) const override {
+    return {vector_t::Zero(state.size()), vector_t::Zero(input.size())};
+  }
+};
+}  // namespace
+
+TEST_F(testQuadraticCost, SampledTargetTrajectories) {
+  const SampledTargetTrajectories sampledTargetTrajectories(targetTrajectories_, {t_});
+  PreComputation preComputation;
+  preComputation.setSampledTargetTrajectoriesPtr(&sampledTargetTrajectories);
+
+  EXPECT_NEAR(QuadraticStateInputCost(Q_, R_, P_).getValue(t_, x_, u_, targetTrajectories_, preComputation), expectedCost_, PRECISION);
+  EXPECT_NEAR(QuadraticStateCost(Qf_).getValue(t_, x_, targetTrajectories_, preComputation), expectedFinalCost_, PRECISION);
+
+  // the deprecated hooks of a derived class are still called while a sampled view is attached
+  EXPECT_NEAR(LegacyStateInputCost(Q_, R_, P_).getValue(t_, x_, u_, targetTrajectories_, preComputation), 0.0, PRECISION);
+  EXPECT_NEAR(LegacyStateCost(Qf_).getValue(t_, x_, targetTrajectories_, preComputation), 0.0, PRECISION);
+}
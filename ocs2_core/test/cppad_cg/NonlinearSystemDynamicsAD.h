@@ -0,0 +1,56 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/automatic_differentiation/Types.h>
+#include <ocs2_core/dynamics/SystemDynamicsBaseAD.h>
+
+namespace ocs2 {
+
+/** A time-varying, damped pendulum with a torque input: dx = [x(1); -(1 + 0.5 cos(t)) sin(x(0)) - 0.1 x(1) + u(0) x(0)] */
+class NonlinearSystemDynamicsAD : public SystemDynamicsBaseAD {
+ public:
+  NonlinearSystemDynamicsAD() = default;
+  ~NonlinearSystemDynamicsAD() override = default;
+  NonlinearSystemDynamicsAD* clone() const override { return new NonlinearSystemDynamicsAD(*this); }
+
+ protected:
+  NonlinearSystemDynamicsAD(const NonlinearSystemDynamicsAD& rhs) = default;
+
+  ad_vector_t systemFlowMap(ad_scalar_t time, const ad_vector_t& state, const ad_vector_t& input,
+                            const ad_vector_t& parameters) const override {
+    ad_vector_t stateDerivative(2);
+    stateDerivative(0) = state(1);
+    stateDerivative(1) = -(1.0 + 0.5 * cos(time)) * sin(state(0)) - 0.1 * state(1) + input(0) * state(0);
+    return stateDerivative;
+  }
+};
+
+}  // namespace ocs2
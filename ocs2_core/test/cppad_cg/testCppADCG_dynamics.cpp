@@ -33,7 +33,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 
 #include "LinearSystemDynamicsAD.h"
+#include "NonlinearSystemDynamicsAD.h"
 #include "ocs2_core/dynamics/LinearSystemDynamics.h"
+#include "ocs2_core/integration/SensitivityIntegrator.h"
 #include "ocs2_core/test/testTools.h"
 
 using namespace ocs2;
@@ -142,3 +144,62 @@ TEST_F(testCppADCG_dynamicsFixture, multithread_test) {
 
   ASSERT_TRUE(success && successClone);
 }
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
+TEST_F(testCppADCG_dynamicsFixture, discrete_flow_map_test) {
+  boost::filesystem::path filePath(__FILE__);
+  const std::string libraryFolder = filePath.parent_path().generic_string() + "/testCppADCG_generated";
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const scalar_t precision = 1e-9;
+
+  for (const auto integratorType : {SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2, SensitivityIntegratorType::RK4}) {
+    // reference without the generated discrete flow map
+    const auto discretizer = selectDynamicsDiscretization(integratorType);
+    const auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(integratorType);
+    std::unique_ptr<LinearSystemDynamicsAD> adLinearSystemPtr(adLinearSystem_->clone());
+    adLinearSystemPtr->initializeDiscreteFlowMap(integratorType, "testCppADCG_dynamics", libraryFolder, true, false);
+    ASSERT_TRUE(adLinearSystemPtr->hasDiscreteFlowMap(integratorType));
+
+    for (size_t it = 0; it < 10; it++) {
+      const vector_t x = vector_t::Random(stateDim_);
+      const vector_t u = vector_t::Random(inputDim_);
+
+      const auto expected = sensitivityDiscretizer(*linearSystem_, t, x, u, dt);
+      const auto approximation = adLinearSystemPtr->discreteFlowMapLinearApproximation(t, x, u, dt);
+      EXPECT_TRUE(isApprox(approximation, expected, precision));
+      EXPECT_TRUE(isApprox(sensitivityDiscretizer(*adLinearSystemPtr, t, x, u, dt), expected, precision));
+      EXPECT_TRUE(discretizer(*adLinearSystemPtr, t, x, u, dt).isApprox(expected.f, precision));
+    }
+
+    // the generated model is cloned
+    std::unique_ptr<LinearSystemDynamicsAD> clonedSystemPtr(adLinearSystemPtr->clone());
+    EXPECT_TRUE(clonedSystemPtr->hasDiscreteFlowMap(integratorType));
+  }
+
+  // nonlinear and time-varying system, referenced by the chained stage linearizations of the same model
+  NonlinearSystemDynamicsAD nonlinearSystem;
+  nonlinearSystem.initialize(2, 1, "testCppADCG_nonlinear_dynamics", libraryFolder, true, false);
+  for (const auto integratorType : {SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2, SensitivityIntegratorType::RK4}) {
+    const auto discretizer = selectDynamicsDiscretization(integratorType);
+    const auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(integratorType);
+    std::unique_ptr<NonlinearSystemDynamicsAD> discreteSystemPtr(nonlinearSystem.clone());
+    discreteSystemPtr->initializeDiscreteFlowMap(integratorType, "testCppADCG_nonlinear_dynamics", libraryFolder, true, false);
+    ASSERT_TRUE(discreteSystemPtr->hasDiscreteFlowMap(integratorType));
+
+    for (size_t it = 0; it < 10; it++) {
+      const scalar_t tk = t + it * dt;
+      const vector_t x = vector_t::Random(2);
+      const vector_t u = vector_t::Random(1);
+
+      const auto expected = sensitivityDiscretizer(nonlinearSystem, tk, x, u, dt);
+      const auto approximation = discreteSystemPtr->discreteFlowMapLinearApproximation(tk, x, u, dt);
+      EXPECT_TRUE(isApprox(approximation, expected, precision));
+      EXPECT_TRUE(discretizer(*discreteSystemPtr, tk, x, u, dt).isApprox(expected.f, precision));
+      EXPECT_TRUE(discreteSystemPtr->computeDiscreteFlowMap(tk, x, u, dt).isApprox(expected.f, precision));
+    }
+  }
+}
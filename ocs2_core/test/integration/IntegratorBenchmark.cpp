@@ -0,0 +1,112 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+
+#include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Stable linear system of a typical state dimension with a time-varying input. */
+class BenchmarkSystem final : public OdeBase {
+ public:
+  explicit BenchmarkSystem(size_t stateDim) : A_(-matrix_t::Identity(stateDim, stateDim)), b_(vector_t::Ones(stateDim)) {
+    A_.diagonal(1).setConstant(0.5);
+    A_.diagonal(-1).setConstant(-0.5);
+  }
+  ~BenchmarkSystem() override = default;
+  vector_t computeFlowMap(scalar_t t, const vector_t& x) override { return A_ * x + b_ * std::sin(t); }
+
+ private:
+  matrix_t A_;
+  vector_t b_;
+};
+
+}  // namespace
+
+/**
+ * Compares the boost odeint integrators with the fixed-step integrators on a rollout-like integration.
+ * Usage: ocs2_core_integrator_benchmark [numRepetitions]
+ */
+int main(int argc, char** argv) {
+  const size_t numRepetitions = (argc > 1) ? std::stoul(argv[1]) : 1000;
+  const size_t stateDim = 24;
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const scalar_t dt = 0.01;
+
+  BenchmarkSystem system(stateDim);
+  const vector_t initialState = vector_t::Ones(stateDim);
+
+  std::cerr << "Integration of a " << stateDim << " dimensional system over [" << startTime << ", " << finalTime << "] with dt = " << dt
+            << ", " << numRepetitions << " repetitions.\n";
+  std::cerr << std::left << std::setw(14) << "Integrator" << std::setw(24) << "integrateAdaptive [ms]" << std::setw(24)
+            << "integrateConst [ms]"
+            << "final state error\n";
+
+  const vector_t referenceState = [&]() {
+    vector_array_t stateTrajectory;
+    Observer observer(&stateTrajectory);
+    newIntegrator(IntegratorType::ODE45)->integrateAdaptive(system, observer, initialState, startTime, finalTime, dt, 1e-12, 1e-12);
+    return stateTrajectory.back();
+  }();
+
+  for (const auto type : {IntegratorType::ODE45, IntegratorType::ODE45_OCS2, IntegratorType::EULER, IntegratorType::EULER_OCS2,
+                          IntegratorType::RK4, IntegratorType::RK4_OCS2}) {
+    auto integrator = newIntegrator(type);
+    scalar_array_t timeTrajectory;
+    vector_array_t stateTrajectory;
+
+    benchmark::RepeatedTimer adaptiveTimer;
+    benchmark::RepeatedTimer constTimer;
+    for (size_t i = 0; i < numRepetitions; i++) {
+      timeTrajectory.clear();
+      stateTrajectory.clear();
+      Observer observer(&stateTrajectory, &timeTrajectory);
+      adaptiveTimer.startTimer();
+      integrator->integrateAdaptive(system, observer, initialState, startTime, finalTime, dt);
+      adaptiveTimer.endTimer();
+
+      timeTrajectory.clear();
+      stateTrajectory.clear();
+      constTimer.startTimer();
+      integrator->integrateConst(system, observer, initialState, startTime, finalTime, dt);
+      constTimer.endTimer();
+    }
+
+    std::cerr << std::left << std::setw(14) << integrator_type::toString(type) << std::setw(24) << adaptiveTimer.getAverageInMilliseconds()
+              << std::setw(24) << constTimer.getAverageInMilliseconds() << (stateTrajectory.back() - referenceState).norm() << "\n";
+  }
+
+  return 0;
+}
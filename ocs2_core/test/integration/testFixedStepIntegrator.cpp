@@ -0,0 +1,183 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/integration/Integrator.h>
+
+namespace {
+
+class LinearSystem final : public ocs2::OdeBase {
+ public:
+  ~LinearSystem() override = default;
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x) override {
+    const ocs2::matrix_t A = (ocs2::matrix_t(2, 2) << -2, -1,  // clang-format off
+                                                       1,  0).finished();  // clang-format on
+    const ocs2::vector_t B = (ocs2::vector_t(2) << 1, 0).finished();
+    return A * x + B * std::sin(t);
+  }
+};
+
+/** Stiff scalar system that quickly converges to cos(t). */
+class StiffSystem final : public ocs2::OdeBase {
+ public:
+  ~StiffSystem() override = default;
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x) override {
+    return -1000.0 * (x - ocs2::vector_t::Constant(1, std::cos(t)));
+  }
+};
+
+/** Scalar system dx/dt = x^2, whose implicit midpoint stage equation has no real solution for x * dt > 1/2. */
+class QuadraticSystem final : public ocs2::OdeBase {
+ public:
+  ~QuadraticSystem() override = default;
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x) override { return x.cwiseProduct(x); }
+};
+
+struct TrajectoryData {
+  ocs2::scalar_array_t timeTrajectory;
+  ocs2::vector_array_t stateTrajectory;
+  size_t numFunctionCalls;
+};
+
+enum class Mode { CONST, ADAPTIVE, TIMES };
+
+TrajectoryData integrate(ocs2::IntegratorType type, Mode mode, ocs2::scalar_t t0, ocs2::scalar_t t1, ocs2::scalar_t dt) {
+  const ocs2::vector_t x0 = (ocs2::vector_t(2) << 0.5, -1.0).finished();
+  const ocs2::scalar_array_t times = {t0, t0 + 0.33 * (t1 - t0), t0 + 0.5 * (t1 - t0), t1};
+
+  TrajectoryData data;
+  LinearSystem sys;
+  ocs2::Observer observer(&data.stateTrajectory, &data.timeTrajectory);
+  auto integrator = ocs2::newIntegrator(type);
+  switch (mode) {
+    case Mode::CONST:
+      integrator->integrateConst(sys, observer, x0, t0, t1, dt);
+      break;
+    case Mode::ADAPTIVE:
+      integrator->integrateAdaptive(sys, observer, x0, t0, t1, dt);
+      break;
+    case Mode::TIMES:
+      integrator->integrateTimes(sys, observer, x0, times.begin(), times.end(), dt);
+      break;
+  }
+  data.numFunctionCalls = sys.getNumFunctionCalls();
+  return data;
+}
+
+void compareWithBoost(ocs2::IntegratorType type, ocs2::IntegratorType boostType, ocs2::scalar_t dt) {
+  for (const auto mode : {Mode::CONST, Mode::ADAPTIVE, Mode::TIMES}) {
+    const auto data = integrate(type, mode, 0.0, 1.03, dt);
+    const auto data_boost = integrate(boostType, mode, 0.0, 1.03, dt);
+
+    EXPECT_EQ(data.numFunctionCalls, data_boost.numFunctionCalls);
+    ASSERT_EQ(data.timeTrajectory.size(), data_boost.timeTrajectory.size());
+    for (size_t i = 0; i < data.timeTrajectory.size(); i++) {
+      EXPECT_NEAR(data.timeTrajectory[i], data_boost.timeTrajectory[i], 1e-12);
+      EXPECT_TRUE(data.stateTrajectory[i].isApprox(data_boost.stateTrajectory[i], 1e-10));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(FixedStepIntegratorTest, compareEulerWithBoost) {
+  compareWithBoost(ocs2::IntegratorType::EULER_OCS2, ocs2::IntegratorType::EULER, 0.01);
+}
+
+TEST(FixedStepIntegratorTest, compareRK4WithBoost) {
+  compareWithBoost(ocs2::IntegratorType::RK4_OCS2, ocs2::IntegratorType::RK4, 0.05);
+}
+
+TEST(FixedStepIntegratorTest, integrateBackwards) {
+  const auto data = integrate(ocs2::IntegratorType::RK4_OCS2, Mode::ADAPTIVE, 1.0, 0.0, -0.03);
+  const auto data_boost = integrate(ocs2::IntegratorType::RK4, Mode::ADAPTIVE, 1.0, 0.0, -0.03);
+
+  EXPECT_NEAR(data.timeTrajectory.back(), 0.0, 1e-12);
+  EXPECT_TRUE(data.stateTrajectory.back().isApprox(data_boost.stateTrajectory.back(), 1e-10));
+}
+
+TEST(FixedStepIntegratorTest, maxNumSteps) {
+  LinearSystem sys;
+  ocs2::Observer observer;
+  auto integrator = ocs2::newIntegrator(ocs2::IntegratorType::RK4_OCS2);
+  EXPECT_THROW(integrator->integrateAdaptive(sys, observer, ocs2::vector_t::Zero(2), 0.0, 1.0, 0.01, 1e-6, 1e-3, 100),
+               std::runtime_error);
+}
+
+TEST(FixedStepIntegratorTest, concatenateTrajectories) {
+  ocs2::scalar_array_t timeTrajectory;
+  ocs2::vector_array_t stateTrajectory;
+  LinearSystem sys;
+  auto integrator = ocs2::newIntegrator(ocs2::IntegratorType::RK4_OCS2);
+
+  ocs2::Observer observer(&stateTrajectory, &timeTrajectory);
+  integrator->integrateAdaptive(sys, observer, ocs2::vector_t::Ones(2), 0.0, 0.5, 0.1);
+  const ocs2::vector_t x1 = stateTrajectory.back();
+  integrator->integrateAdaptive(sys, observer, x1, 0.5, 1.0, 0.1);
+
+  ASSERT_EQ(timeTrajectory.size(), 12);
+  EXPECT_NEAR(timeTrajectory[5], 0.5, 1e-12);
+  EXPECT_NEAR(timeTrajectory[6], 0.5, 1e-12);
+  EXPECT_TRUE(stateTrajectory[6].isApprox(x1));
+  EXPECT_NEAR(timeTrajectory.back(), 1.0, 1e-12);
+}
+
+TEST(FixedStepIntegratorTest, implicitMidpointAccuracy) {
+  // second order accurate compared to the adaptive ODE45 solution
+  for (const auto mode : {Mode::CONST, Mode::ADAPTIVE, Mode::TIMES}) {
+    const auto data = integrate(ocs2::IntegratorType::IMPLICIT_MIDPOINT_OCS2, mode, 0.0, 1.03, 0.01);
+    const auto data_ode45 = integrate(ocs2::IntegratorType::ODE45, Mode::TIMES, 0.0, 1.03, 0.01);
+    EXPECT_NEAR(data.timeTrajectory.back(), 1.03, 1e-12);
+    EXPECT_TRUE(data.stateTrajectory.back().isApprox(data_ode45.stateTrajectory.back(), 1e-4));
+  }
+}
+
+TEST(FixedStepIntegratorTest, implicitMidpointStiff) {
+  const auto integrateStiff = [](ocs2::IntegratorType type) {
+    StiffSystem sys;
+    ocs2::vector_array_t stateTrajectory;
+    ocs2::Observer observer(&stateTrajectory);
+    auto integrator = ocs2::newIntegrator(type);
+    integrator->integrateConst(sys, observer, ocs2::vector_t::Ones(1), 0.0, 1.0, 0.05);
+    return stateTrajectory.back();
+  };
+
+  // the explicit scheme is unstable at this step size while the implicit midpoint rule tracks the slow manifold x = cos(t)
+  EXPECT_GT(integrateStiff(ocs2::IntegratorType::RK4_OCS2).norm(), 1e6);
+  EXPECT_NEAR(integrateStiff(ocs2::IntegratorType::IMPLICIT_MIDPOINT_OCS2)(0), std::cos(1.0), 1e-3);
+}
+
+TEST(FixedStepIntegratorTest, implicitMidpointNotConverged) {
+  QuadraticSystem sys;
+  ocs2::Observer observer;
+  auto integrator = ocs2::newIntegrator(ocs2::IntegratorType::IMPLICIT_MIDPOINT_OCS2);
+  EXPECT_NO_THROW(integrator->integrateConst(sys, observer, ocs2::vector_t::Ones(1), 0.0, 0.2, 0.1));
+  EXPECT_THROW(integrator->integrateConst(sys, observer, ocs2::vector_t::Ones(1), 0.0, 1.0, 1.0), std::runtime_error);
+}
@@ -45,6 +45,26 @@ std::unique_ptr<ocs2::LinearSystemDynamics> getSystem() {
   B << 1, 0;
   return std::unique_ptr<ocs2::LinearSystemDynamics>(new ocs2::LinearSystemDynamics(A, B));
 }
+
+/** Dynamics dx/dt = x^2 + u, whose implicit midpoint stage equation has no real solution for (x + dt/2 * u) * dt > 1/2. */
+class QuadraticSystemDynamics final : public ocs2::SystemDynamicsBase {
+ public:
+  ~QuadraticSystemDynamics() override = default;
+  QuadraticSystemDynamics* clone() const override { return new QuadraticSystemDynamics(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    return x.cwiseProduct(x) + u;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation& preComp) override {
+    ocs2::VectorFunctionLinearApproximation approximation;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    approximation.dfdx = (2.0 * x).asDiagonal();
+    approximation.dfdu = ocs2::matrix_t::Identity(x.size(), u.size());
+    return approximation;
+  }
+};
 }  // namespace
 
 TEST(test_sensitivity_integrator, eulerSensitivity) {
@@ -184,6 +204,64 @@ TEST(test_sensitivity_integrator, rk4Sensitivity) {
   ASSERT_TRUE(rk4LinearizedDynamics.dfdu.isApprox(rk4dynamics_check.dfdu));
 }
 
+TEST(test_sensitivity_integrator, implicitMidpointSensitivity) {
+  auto type = ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT;
+  auto implicitMidpointSensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+  auto implicitMidpointDiscretization = ocs2::selectDynamicsDiscretization(type);
+
+  auto system = getSystem();
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.1;
+
+  // Closed form of the implicit midpoint rule for linear dynamics: (Id - dt/2 A) x_{k+1} = (Id + dt/2 A) x_{k} + dt B u_{k}
+  const auto implicitMidpointDynamics_check = [&]() {
+    const ocs2::PreComputation preComp;
+    const ocs2::VectorFunctionLinearApproximation continuousApproximation = system->linearApproximation(t, x, u, preComp);
+    const ocs2::matrix_t I = ocs2::matrix_t::Identity(x.size(), x.size());
+    const ocs2::matrix_t M = I - 0.5 * dt * continuousApproximation.dfdx;
+
+    ocs2::VectorFunctionLinearApproximation discreteApproximation;
+    discreteApproximation.dfdx = M.inverse() * (I + 0.5 * dt * continuousApproximation.dfdx);
+    discreteApproximation.dfdu = M.inverse() * dt * continuousApproximation.dfdu;
+    discreteApproximation.f = discreteApproximation.dfdx * x + discreteApproximation.dfdu * u;
+    return discreteApproximation;
+  }();
+
+  const auto implicitMidpointForwardDynamics = implicitMidpointDiscretization(*system, t, x, u, dt);
+  ASSERT_TRUE(implicitMidpointForwardDynamics.isApprox(implicitMidpointDynamics_check.f));
+  const auto implicitMidpointLinearizedDynamics = implicitMidpointSensitivityDiscretization(*system, t, x, u, dt);
+  ASSERT_TRUE(implicitMidpointLinearizedDynamics.f.isApprox(implicitMidpointDynamics_check.f));
+  ASSERT_TRUE(implicitMidpointLinearizedDynamics.dfdx.isApprox(implicitMidpointDynamics_check.dfdx));
+  ASSERT_TRUE(implicitMidpointLinearizedDynamics.dfdu.isApprox(implicitMidpointDynamics_check.dfdu));
+}
+
+TEST(test_sensitivity_integrator, implicitMidpointStiff) {
+  ocs2::matrix_t A(2, 2);
+  A << -1000, 0,  // clang-format off
+           0, -1;  // clang-format on
+  ocs2::matrix_t B(2, 1);
+  B << 1000, 1;
+  ocs2::LinearSystemDynamics system(A, B);
+  const ocs2::vector_t u = ocs2::vector_t::Ones(1);
+  const ocs2::scalar_t dt = 0.05;
+
+  // The explicit RK4 discretization is unstable at this step size while the implicit midpoint rule converges to the equilibrium.
+  auto rk4Discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::RK4);
+  auto implicitMidpointDiscretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT);
+  ocs2::vector_t xRk4 = ocs2::vector_t::Zero(2);
+  for (int k = 0; k < 10; k++) {
+    xRk4 = rk4Discretization(system, k * dt, xRk4, u, dt);
+  }
+  ocs2::vector_t xImplicit = ocs2::vector_t::Zero(2);
+  for (int k = 0; k < 100; k++) {
+    xImplicit = implicitMidpointDiscretization(system, k * dt, xImplicit, u, dt);
+  }
+  EXPECT_GT(xRk4.norm(), 1e6);
+  EXPECT_TRUE(xImplicit.isApprox(ocs2::vector_t::Ones(2), 1e-2));
+}
+
 TEST(test_sensitivity_integrator, vsBoostRK4) {
   auto system = getSystem();
   ocs2::scalar_t t = 0.5;
@@ -209,4 +287,17 @@ TEST(test_sensitivity_integrator, vsBoostRK4) {
 
   // Check
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(boostRk4ForwardDynamics));
-}
\ No newline at end of file
+}
+
+TEST(test_sensitivity_integrator, implicitMidpointNotConverged) {
+  auto implicitMidpointDiscretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT);
+  auto implicitMidpointSensitivityDiscretization =
+      ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT);
+
+  QuadraticSystemDynamics system;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(1);
+  const ocs2::vector_t u = ocs2::vector_t::Zero(1);
+  EXPECT_NO_THROW(implicitMidpointDiscretization(system, 0.0, x, u, 0.1));
+  EXPECT_THROW(implicitMidpointDiscretization(system, 0.0, x, u, 1.0), std::runtime_error);
+  EXPECT_THROW(implicitMidpointSensitivityDiscretization(system, 0.0, x, u, 1.0), std::runtime_error);
+}
@@ -133,3 +133,49 @@ TEST(makePsdCholesky, makePsdCholesky) {
 
   ASSERT_GE(lambdaSparseMatCorr.minCoeff(), minDesiredEigenvalue);
 }
+
+TEST(LASolvers, accumulateWeightedGram) {
+  const size_t m = 7;
+  const size_t nx = 5;
+  const size_t nu = 3;
+  const scalar_t tol = 1e-9;
+
+  const matrix_t dhdx = matrix_t::Random(m, nx);
+  const matrix_t dhdu = matrix_t::Random(m, nu);
+  const vector_t w = vector_t::Random(m);
+  // mixed signs and some inactive rows
+  const vector_t W = (vector_t(m) << 2.0, 0.0, 0.5, -0.3, 0.0, 1.5, -1.0).finished();
+
+  auto accumulator = ScalarFunctionQuadraticApproximation::Zero(nx, nu);
+  accumulator.dfdxx = matrix_t::Identity(nx, nx);
+  accumulator.dfduu = matrix_t::Identity(nu, nu);
+  auto expected = accumulator;
+
+  accumulateWeightedGram(dhdx, dhdu, w, W, accumulator);
+
+  expected.dfdx += dhdx.transpose() * w;
+  expected.dfdu += dhdu.transpose() * w;
+  expected.dfdxx += dhdx.transpose() * W.asDiagonal() * dhdx;
+  expected.dfdux += dhdu.transpose() * W.asDiagonal() * dhdx;
+  expected.dfduu += dhdu.transpose() * W.asDiagonal() * dhdu;
+
+  EXPECT_TRUE(accumulator.dfdx.isApprox(expected.dfdx, tol));
+  EXPECT_TRUE(accumulator.dfdu.isApprox(expected.dfdu, tol));
+  EXPECT_TRUE(accumulator.dfdxx.isApprox(expected.dfdxx, tol));
+  EXPECT_TRUE(accumulator.dfdux.isApprox(expected.dfdux, tol));
+  EXPECT_TRUE(accumulator.dfduu.isApprox(expected.dfduu, tol));
+
+  // state-only
+  auto stateOnlyAccumulator = ScalarFunctionQuadraticApproximation::Zero(nx, 0);
+  accumulateWeightedGram(dhdx, matrix_t(m, 0), w, W, stateOnlyAccumulator);
+  EXPECT_TRUE(stateOnlyAccumulator.dfdxx.isApprox(dhdx.transpose() * W.asDiagonal() * dhdx, tol));
+
+  // fewer rows than the previous calls, such that only a part of the reused scratch memory is used
+  const size_t numTopRows = 3;
+  auto topRowsAccumulator = ScalarFunctionQuadraticApproximation::Zero(nx, nu);
+  accumulateWeightedGram(dhdx.topRows(numTopRows), dhdu.topRows(numTopRows), w.head(numTopRows), W.head(numTopRows), topRowsAccumulator);
+  const auto topRowsW = W.head(numTopRows).asDiagonal();
+  EXPECT_TRUE(topRowsAccumulator.dfdxx.isApprox(dhdx.topRows(numTopRows).transpose() * topRowsW * dhdx.topRows(numTopRows), tol));
+  EXPECT_TRUE(topRowsAccumulator.dfdux.isApprox(dhdu.topRows(numTopRows).transpose() * topRowsW * dhdx.topRows(numTopRows), tol));
+  EXPECT_TRUE(topRowsAccumulator.dfduu.isApprox(dhdu.topRows(numTopRows).transpose() * topRowsW * dhdu.topRows(numTopRows), tol));
+}
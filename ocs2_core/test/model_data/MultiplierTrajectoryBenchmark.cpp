@@ -0,0 +1,128 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/model_data/Multiplier.h>
+#include <ocs2_core/model_data/MultiplierTrajectory.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** A legged-robot-like constraint structure: one inequality term per leg and per friction cone face, with two contact modes. */
+std::vector<MultiplierCollection> getMultiplierCollectionTrajectory(size_t numNodes) {
+  std::vector<MultiplierCollection> multiplierCollectionTrajectory(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    const size_t numContacts = (i < numNodes / 2) ? 4 : 2;
+    auto& multiplierCollection = multiplierCollectionTrajectory[i];
+    multiplierCollection.stateInputEq.emplace_back(1.0, vector_t::Random(3 * (4 - numContacts)));
+    for (size_t j = 0; j < 4 * numContacts; j++) {
+      multiplierCollection.stateInputIneq.emplace_back(1.0, vector_t::Random(1));
+    }
+    multiplierCollection.stateIneq.emplace_back(1.0, vector_t::Random(2));
+  }
+  return multiplierCollectionTrajectory;
+}
+
+}  // namespace
+
+/**
+ * Compares the dual solution initialization of the line search steps from a cached dual solution: interpolating the unpacked
+ * MultiplierCollections, packing the cached intermediates at each step, and packing them once per search.
+ * Usage: ocs2_core_multiplier_trajectory_benchmark [numRepetitions]
+ */
+int main(int argc, char** argv) {
+  const size_t numRepetitions = (argc > 1) ? std::stoul(argv[1]) : 100;
+  const size_t numNodes = 200;
+  const size_t numSearchSteps = 10;
+
+  const auto cachedIntermediates = getMultiplierCollectionTrajectory(numNodes);
+  scalar_array_t cachedTimeTrajectory(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    cachedTimeTrajectory[i] = 0.01 * i;
+  }
+  // the nodes of the new primal solution are in the middle of the cached ones
+  std::vector<LinearInterpolation::index_alpha_t> indexAlphas(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    indexAlphas[i] = LinearInterpolation::timeSegment(0.01 * i + 0.005, cachedTimeTrajectory);
+  }
+
+  std::cerr << "Initialization of " << numSearchSteps << " search steps from a cached dual solution with " << numNodes << " nodes, "
+            << numRepetitions << " repetitions.\n";
+  std::cerr << std::left << std::setw(24) << "Method"
+            << "time per search [ms]\n";
+
+  std::vector<MultiplierCollection> intermediates(numNodes);
+  auto interpolateUnpacked = [&]() {
+    for (size_t i = 0; i < numNodes; i++) {
+      intermediates[i] = LinearInterpolation::interpolate(indexAlphas[i], cachedIntermediates);
+    }
+  };
+  auto interpolatePacked = [&](const MultiplierTrajectory& multiplierTrajectory) {
+    for (size_t i = 0; i < numNodes; i++) {
+      multiplierTrajectory.interpolate(indexAlphas[i], intermediates[i]);
+    }
+  };
+
+  benchmark::RepeatedTimer unpackedTimer;
+  benchmark::RepeatedTimer packedPerStepTimer;
+  benchmark::RepeatedTimer packedOnceTimer;
+  MultiplierTrajectory multiplierTrajectory;
+  for (size_t r = 0; r < numRepetitions; r++) {
+    unpackedTimer.startTimer();
+    for (size_t s = 0; s < numSearchSteps; s++) {
+      interpolateUnpacked();
+    }
+    unpackedTimer.endTimer();
+
+    packedPerStepTimer.startTimer();
+    for (size_t s = 0; s < numSearchSteps; s++) {
+      const MultiplierTrajectory stepMultiplierTrajectory(cachedIntermediates);
+      interpolatePacked(stepMultiplierTrajectory);
+    }
+    packedPerStepTimer.endTimer();
+
+    packedOnceTimer.startTimer();
+    multiplierTrajectory.assign(cachedIntermediates);
+    for (size_t s = 0; s < numSearchSteps; s++) {
+      interpolatePacked(multiplierTrajectory);
+    }
+    packedOnceTimer.endTimer();
+  }
+
+  std::cerr << std::left << std::setw(24) << "unpacked" << unpackedTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << std::left << std::setw(24) << "packed at each step" << packedPerStepTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << std::left << std::setw(24) << "packed once" << packedOnceTimer.getAverageInMilliseconds() << "\n";
+
+  return 0;
+}
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/model_data/Multiplier.h>
+#include <ocs2_core/model_data/MultiplierTrajectory.h>
 
 namespace ocs2 {
 namespace {
@@ -181,3 +182,63 @@ TEST(TestMultiplier, testInterpolation) {
     EXPECT_TRUE(ocs2::isApprox(multiplierCollection, multiplierCollectionNew, prec));
   }  // end of i loop
 }
+
+TEST(TestMultiplier, testMultiplierTrajectory) {
+  // two constraint structures, e.g. two modes
+  const std::vector<ocs2::size_array_t> stateIneqTermsSize{{2}, {2, 0}};
+  const std::vector<ocs2::size_array_t> stateInputIneqTermsSize{{0, 2, 0, 0, 3, 5}, {1, 4}};
+
+  const size_t N = 11;
+  ocs2::scalar_array_t timeTrajectory(N);
+  std::vector<ocs2::MultiplierCollection> multiplierCollectionTrajectory(N);
+  for (size_t i = 0; i < N; i++) {
+    const size_t mode = (i < 6) ? 0 : 1;
+    ocs2::vector_t serialized;
+    timeTrajectory[i] = i * 0.1;
+    ocs2::random({0, 0}, serialized, multiplierCollectionTrajectory[i].stateEq);
+    ocs2::random(stateIneqTermsSize[mode], serialized, multiplierCollectionTrajectory[i].stateIneq);
+    ocs2::random(stateInputIneqTermsSize[mode], serialized, multiplierCollectionTrajectory[i].stateInputIneq);
+  }  // end of i loop
+
+  ocs2::MultiplierTrajectory multiplierTrajectory(multiplierCollectionTrajectory);
+  ASSERT_EQ(multiplierTrajectory.size(), N);
+
+  // unpacking and zero-copy views
+  constexpr ocs2::scalar_t prec = 1e-8;
+  using TermType = ocs2::MultiplierTrajectory::TermType;
+  for (size_t i = 0; i < N; i++) {
+    const auto& multiplierCollection = multiplierCollectionTrajectory[i];
+    EXPECT_TRUE(ocs2::isApprox(multiplierTrajectory.get(i), multiplierCollection, prec));
+    EXPECT_EQ(multiplierTrajectory.penalty(i, TermType::StateIneq, 0), multiplierCollection.stateIneq[0].penalty);
+    EXPECT_TRUE(multiplierTrajectory.lagrangian(i, TermType::StateInputIneq, 1) == multiplierCollection.stateInputIneq[1].lagrangian);
+  }
+
+  // interpolation within a mode and across the mode switch
+  ocs2::MultiplierCollection multiplierCollection;
+  const ocs2::scalar_array_t timeTrajectoryTest{-1.0, 0.0, 0.26, 0.52, 0.54, 0.58, 0.87, 1.0, 100.0};
+  for (const auto t : timeTrajectoryTest) {
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(t, timeTrajectory);
+    multiplierTrajectory.interpolate(indexAlpha, multiplierCollection);
+    EXPECT_TRUE(ocs2::isApprox(multiplierCollection, ocs2::interpolateNew(indexAlpha, multiplierCollectionTrajectory), prec));
+  }
+
+  // repacking a shorter trajectory
+  const size_t numRemoved = 4;
+  const std::vector<ocs2::MultiplierCollection> shortTrajectory(multiplierCollectionTrajectory.begin() + numRemoved,
+                                                                 multiplierCollectionTrajectory.end());
+  multiplierTrajectory.assign(shortTrajectory);
+  ASSERT_EQ(multiplierTrajectory.size(), N - numRemoved);
+  for (size_t i = 0; i < N - numRemoved; i++) {
+    EXPECT_TRUE(ocs2::isApprox(multiplierTrajectory.get(i), shortTrajectory[i], prec));
+  }
+
+  // shifting
+  const size_t numShift = 3;
+  multiplierTrajectory.shift(numShift);
+  ASSERT_EQ(multiplierTrajectory.size(), N - numRemoved - numShift);
+  for (size_t i = 0; i < N - numRemoved - numShift; i++) {
+    EXPECT_TRUE(ocs2::isApprox(multiplierTrajectory.get(i), shortTrajectory[i + numShift], prec));
+  }
+  multiplierTrajectory.push_back(multiplierCollectionTrajectory.front());
+  EXPECT_TRUE(ocs2::isApprox(multiplierTrajectory.get(N - numRemoved - numShift), multiplierCollectionTrajectory.front(), prec));
+}
@@ -0,0 +1,171 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/PreComputation.h>
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+using namespace ocs2;
+
+namespace {
+TargetTrajectories getTargetTrajectories() {
+  const scalar_array_t timeTrajectory{0.0, 0.5, 1.0};
+  const vector_array_t stateTrajectory{vector_t::Zero(2), vector_t::Ones(2), vector_t::Constant(2, 3.0)};
+  const vector_array_t inputTrajectory{vector_t::Ones(1), vector_t::Zero(1), vector_t::Ones(1)};
+  return {timeTrajectory, stateTrajectory, inputTrajectory};
+}
+}  // namespace
+
+TEST(testTargetTrajectories, sampledReferenceMatchesInterpolation) {
+  const auto targetTrajectories = getTargetTrajectories();
+
+  scalar_array_t timeGrid;
+  for (size_t i = 0; i <= 30; ++i) {
+    timeGrid.push_back(-0.1 + 0.04 * i);
+  }
+  const SampledTargetTrajectories sampledTargetTrajectories(targetTrajectories, timeGrid);
+
+  // on the grid, in a shuffled order and in between the grid points
+  size_t hint = 0;
+  for (const auto& t : timeGrid) {
+    EXPECT_TRUE(sampledTargetTrajectories.getDesiredState(t, hint).isApprox(targetTrajectories.getDesiredState(t)));
+    EXPECT_TRUE(sampledTargetTrajectories.getDesiredInput(t, hint).isApprox(targetTrajectories.getDesiredInput(t)));
+  }
+  for (size_t i = 0; i < timeGrid.size(); ++i) {
+    const auto t = timeGrid[(7 * i) % timeGrid.size()];
+    EXPECT_TRUE(sampledTargetTrajectories.getDesiredState(t, hint).isApprox(targetTrajectories.getDesiredState(t)));
+  }
+  for (const auto t : {-0.5, 0.01, 0.77, 2.0}) {
+    EXPECT_TRUE(sampledTargetTrajectories.getDesiredState(t, hint).isApprox(targetTrajectories.getDesiredState(t)));
+    EXPECT_TRUE(sampledTargetTrajectories.getDesiredInput(t, hint).isApprox(targetTrajectories.getDesiredInput(t)));
+  }
+}
+
+TEST(testTargetTrajectories, samplesFollowTheUpdates) {
+  auto targetTrajectories = getTargetTrajectories();
+  SampledTargetTrajectories sampledTargetTrajectories(targetTrajectories, {0.25});
+  size_t hint = 0;
+  EXPECT_TRUE(sampledTargetTrajectories.isViewOf(targetTrajectories));
+  EXPECT_TRUE(sampledTargetTrajectories.getDesiredState(0.25, hint).isApprox(vector_t::Constant(2, 0.5)));
+
+  // resampling after a modification
+  targetTrajectories.stateTrajectory[1].setConstant(2.0);
+  sampledTargetTrajectories.update(targetTrajectories, {0.25});
+  EXPECT_TRUE(sampledTargetTrajectories.getDesiredState(0.25, hint).isApprox(vector_t::Constant(2, 1.0)));
+
+  // without an input trajectory, the input queries fall back to the viewed target trajectories
+  const TargetTrajectories stateOnlyTargetTrajectories({0.0}, {vector_t::Constant(2, 10.0)});
+  sampledTargetTrajectories.update(stateOnlyTargetTrajectories, {0.25});
+  EXPECT_FALSE(sampledTargetTrajectories.isViewOf(targetTrajectories));
+  EXPECT_TRUE(sampledTargetTrajectories.getDesiredState(0.25, hint).isApprox(vector_t::Constant(2, 10.0)));
+  EXPECT_ANY_THROW(sampledTargetTrajectories.getDesiredInput(0.25, hint));
+
+  sampledTargetTrajectories.clear();
+  EXPECT_FALSE(sampledTargetTrajectories.isViewOf(stateOnlyTargetTrajectories));
+  EXPECT_ANY_THROW(sampledTargetTrajectories.getDesiredState(0.25, hint));
+}
+
+TEST(testTargetTrajectories, preComputationLookup) {
+  const auto targetTrajectories = getTargetTrajectories();
+  auto otherTargetTrajectories = getTargetTrajectories();
+  otherTargetTrajectories.stateTrajectory[1].setConstant(2.0);
+  const SampledTargetTrajectories sampledTargetTrajectories(targetTrajectories, {0.0, 0.25});
+
+  PreComputation preComputation;
+  EXPECT_TRUE(getDesiredState(0.25, targetTrajectories, preComputation).isApprox(vector_t::Constant(2, 0.5)));
+
+  // the view is only used for the target trajectories which it samples, and the hint follows the lookups of this PreComputation
+  preComputation.setSampledTargetTrajectoriesPtr(&sampledTargetTrajectories);
+  EXPECT_EQ(preComputation.getSampledTargetTrajectoriesPtr(), &sampledTargetTrajectories);
+  EXPECT_TRUE(getDesiredState(0.25, targetTrajectories, preComputation).isApprox(vector_t::Constant(2, 0.5)));
+  EXPECT_EQ(preComputation.getSampleHint(), 1);
+  EXPECT_TRUE(getDesiredInput(0.25, targetTrajectories, preComputation).isApprox(vector_t::Constant(1, 0.5)));
+  EXPECT_TRUE(getDesiredState(0.25, otherTargetTrajectories, preComputation).isApprox(vector_t::Constant(2, 1.0)));
+
+  // a clone does not carry the view
+  std::unique_ptr<PreComputation> clonedPreComputationPtr(preComputation.clone());
+  EXPECT_EQ(clonedPreComputationPtr->getSampledTargetTrajectoriesPtr(), nullptr);
+
+  // detaching resets the hint
+  preComputation.setSampledTargetTrajectoriesPtr(nullptr);
+  EXPECT_EQ(preComputation.getSampleHint(), 0);
+  EXPECT_TRUE(getDesiredState(0.25, targetTrajectories, preComputation).isApprox(vector_t::Constant(2, 0.5)));
+}
+
+TEST(testTargetTrajectories, concurrentQueries) {
+  const auto targetTrajectories = getTargetTrajectories();
+  scalar_array_t timeGrid;
+  for (size_t i = 0; i <= 100; ++i) {
+    timeGrid.push_back(0.01 * i);
+  }
+  const SampledTargetTrajectories sampledTargetTrajectories(targetTrajectories, timeGrid);
+
+  // each worker searches with its own hint
+  std::atomic_size_t numMismatches{0};
+  auto task = [&](size_t offset) {
+    size_t hint = 0;
+    for (size_t i = offset; i < timeGrid.size(); i += 3) {
+      const auto t = timeGrid[i];
+      if (!sampledTargetTrajectories.getDesiredState(t, hint).isApprox(targetTrajectories.getDesiredState(t))) {
+        numMismatches++;
+      }
+    }
+  };
+  std::thread thread1(task, 0), thread2(task, 1);
+  task(2);
+  thread1.join();
+  thread2.join();
+  EXPECT_EQ(numMismatches, 0);
+}
+
+TEST(testTargetTrajectories, staleHint) {
+  const auto targetTrajectories = getTargetTrajectories();
+  scalar_array_t fineTimeGrid;
+  for (size_t i = 0; i <= 100; ++i) {
+    fineTimeGrid.push_back(0.01 * i);
+  }
+  const SampledTargetTrajectories fineSampledTargetTrajectories(targetTrajectories, fineTimeGrid);
+  const SampledTargetTrajectories coarseSampledTargetTrajectories(targetTrajectories, {0.1, 0.4, 0.9});
+
+  // a hint of another view, here out of range, only costs a binary search
+  size_t hint = 0;
+  for (size_t i = 0; i < fineTimeGrid.size(); ++i) {
+    const auto t = fineTimeGrid[i];
+    EXPECT_TRUE(fineSampledTargetTrajectories.getDesiredState(t, hint).isApprox(targetTrajectories.getDesiredState(t)));
+    const auto coarseTime = (i % 3 == 0) ? 0.1 : (i % 3 == 1) ? 0.4 : 0.9;
+    EXPECT_TRUE(
+        coarseSampledTargetTrajectories.getDesiredInput(coarseTime, hint).isApprox(targetTrajectories.getDesiredInput(coarseTime)));
+  }
+}
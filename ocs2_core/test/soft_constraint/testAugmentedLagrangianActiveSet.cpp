@@ -0,0 +1,202 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <ocs2_core/augmented_lagrangian/AugmentedLagrangian.h>
+#include <ocs2_core/augmented_lagrangian/StateAugmentedLagrangianCollection.h>
+#include <ocs2_core/augmented_lagrangian/StateInputAugmentedLagrangianCollection.h>
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
+#include <ocs2_core/penalties/Penalties.h>
+
+using namespace ocs2;
+
+namespace {
+
+constexpr size_t stateDim = 4;
+constexpr size_t inputDim = 2;
+constexpr size_t numConstraints = 3;
+
+/** Creates a linear inequality term h = e + C x + D u with a slackness squared hinge penalty. */
+std::unique_ptr<StateInputAugmentedLagrangianInterface> getStateInputTerm(const vector_t& e) {
+  std::unique_ptr<StateInputConstraint> constraintPtr(
+      new LinearStateInputConstraint(e, matrix_t::Random(numConstraints, stateDim), matrix_t::Random(numConstraints, inputDim)));
+  return create(std::move(constraintPtr), augmented::SlacknessSquaredHingePenalty::create({10.0, 1.0}));
+}
+
+/** Creates a linear inequality term h = e + C x with a slackness squared hinge penalty. */
+std::unique_ptr<StateAugmentedLagrangianInterface> getStateTerm(const vector_t& e) {
+  std::unique_ptr<StateConstraint> constraintPtr(new LinearStateConstraint(e, matrix_t::Random(numConstraints, stateDim)));
+  return create(std::move(constraintPtr), augmented::SlacknessSquaredHingePenalty::create({10.0, 1.0}));
+}
+
+/** A linear state constraint h = e + C x which counts the evaluations of its value and its linear approximation. */
+class CountingStateConstraint final : public StateConstraint {
+ public:
+  CountingStateConstraint(vector_t e, matrix_t C, std::shared_ptr<size_t> numEvaluationsPtr)
+      : StateConstraint(ConstraintOrder::Linear), e_(std::move(e)), C_(std::move(C)), numEvaluationsPtr_(std::move(numEvaluationsPtr)) {}
+  ~CountingStateConstraint() override = default;
+  CountingStateConstraint* clone() const override { return new CountingStateConstraint(*this); }
+
+  size_t getNumConstraints(scalar_t time) const override { return e_.size(); }
+
+  vector_t getValue(scalar_t t, const vector_t& x, const PreComputation&) const override {
+    ++(*numEvaluationsPtr_);
+    return e_ + C_ * x;
+  }
+
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&) const override {
+    ++(*numEvaluationsPtr_);
+    VectorFunctionLinearApproximation linearApproximation;
+    linearApproximation.f = e_ + C_ * x;
+    linearApproximation.dfdx = C_;
+    return linearApproximation;
+  }
+
+ private:
+  CountingStateConstraint(const CountingStateConstraint& rhs) = default;
+
+  vector_t e_;
+  matrix_t C_;
+  std::shared_ptr<size_t> numEvaluationsPtr_;
+};
+
+template <typename Approximation>
+void expectEqual(const Approximation& approx, const Approximation& expected) {
+  EXPECT_NEAR(approx.f, expected.f, 1e-9);
+  EXPECT_TRUE(approx.dfdx.isApprox(expected.dfdx));
+  EXPECT_TRUE(approx.dfdxx.isApprox(expected.dfdxx));
+}
+
+}  // unnamed namespace
+
+TEST(testAugmentedLagrangianActiveSet, stateInputCollection) {
+  const scalar_t t = 0.0;
+  const vector_t x = vector_t::Random(stateDim);
+  const vector_t u = vector_t::Random(inputDim);
+  PreComputation preComp;
+
+  // far from the bounds, close to the bounds, and violated
+  std::vector<std::unique_ptr<StateInputAugmentedLagrangianInterface>> terms;
+  terms.push_back(getStateInputTerm(vector_t::Constant(numConstraints, 100.0)));
+  terms.push_back(getStateInputTerm(vector_t::Zero(numConstraints)));
+  terms.push_back(getStateInputTerm(vector_t::Constant(numConstraints, -100.0)));
+
+  StateInputAugmentedLagrangianCollection collection;
+  for (size_t i = 0; i < terms.size(); i++) {
+    collection.add("term" + std::to_string(i), std::unique_ptr<StateInputAugmentedLagrangianInterface>(terms[i]->clone()));
+  }
+
+  std::vector<Multiplier> termsMultiplier;
+  collection.initializeLagrangian(t, termsMultiplier);
+
+  // the reference sums the full approximation of every term
+  auto expected = ScalarFunctionQuadraticApproximation::Zero(stateDim, inputDim);
+  for (size_t i = 0; i < terms.size(); i++) {
+    expected += terms[i]->getQuadraticApproximation(t, x, u, termsMultiplier[i], preComp);
+  }
+
+  const auto approx = collection.getQuadraticApproximation(t, x, u, termsMultiplier, preComp);
+  expectEqual(approx, expected);
+  EXPECT_TRUE(approx.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(approx.dfdux.isApprox(expected.dfdux));
+  EXPECT_TRUE(approx.dfduu.isApprox(expected.dfduu));
+
+  // reusing the metrics skips the locally constant term without changing the result
+  const auto termsMetrics = collection.getValue(t, x, u, termsMultiplier, preComp);
+  const auto approxWithMetrics = collection.getQuadraticApproximation(t, x, u, termsMultiplier, termsMetrics, preComp);
+  expectEqual(approxWithMetrics, expected);
+  EXPECT_TRUE(approxWithMetrics.dfdu.isApprox(expected.dfdu));
+  EXPECT_TRUE(approxWithMetrics.dfdux.isApprox(expected.dfdux));
+  EXPECT_TRUE(approxWithMetrics.dfduu.isApprox(expected.dfduu));
+
+  size_t numSkipped = 0;
+  size_t numEvaluated = 0;
+  collection.countLocallyConstantTerms(t, termsMetrics, termsMultiplier, numSkipped, numEvaluated);
+  EXPECT_EQ(numSkipped, 1);
+  EXPECT_EQ(numEvaluated, 2);
+}
+
+TEST(testAugmentedLagrangianActiveSet, stateCollection) {
+  const scalar_t t = 0.0;
+  const vector_t x = vector_t::Random(stateDim);
+  PreComputation preComp;
+
+  StateAugmentedLagrangianCollection collection;
+  collection.add("inactive0", getStateTerm(vector_t::Constant(numConstraints, 100.0)));
+  collection.add("inactive1", getStateTerm(vector_t::Constant(numConstraints, 50.0)));
+
+  std::vector<Multiplier> termsMultiplier;
+  collection.initializeLagrangian(t, termsMultiplier);
+
+  const auto termsMetrics = collection.getValue(t, x, termsMultiplier, preComp);
+  const auto approx = collection.getQuadraticApproximation(t, x, termsMultiplier, termsMetrics, preComp);
+  EXPECT_NEAR(approx.f, sumPenalties(termsMetrics), 1e-9);
+  EXPECT_TRUE(approx.dfdx.isZero());
+  EXPECT_TRUE(approx.dfdxx.isZero());
+  expectEqual(approx, collection.getQuadraticApproximation(t, x, termsMultiplier, preComp));
+
+  size_t numSkipped = 0;
+  size_t numEvaluated = 0;
+  collection.countLocallyConstantTerms(t, termsMetrics, termsMultiplier, numSkipped, numEvaluated);
+  EXPECT_EQ(numSkipped, 2);
+  EXPECT_EQ(numEvaluated, 0);
+}
+
+TEST(testAugmentedLagrangianActiveSet, skippedTermIsNotEvaluated) {
+  const scalar_t t = 0.0;
+  const vector_t x = vector_t::Random(stateDim);
+  PreComputation preComp;
+
+  auto numInactiveEvaluationsPtr = std::make_shared<size_t>(0);
+  auto numActiveEvaluationsPtr = std::make_shared<size_t>(0);
+  std::unique_ptr<StateConstraint> inactivePtr(new CountingStateConstraint(
+      vector_t::Constant(numConstraints, 100.0), matrix_t::Random(numConstraints, stateDim), numInactiveEvaluationsPtr));
+  std::unique_ptr<StateConstraint> activePtr(
+      new CountingStateConstraint(vector_t::Zero(numConstraints), matrix_t::Random(numConstraints, stateDim), numActiveEvaluationsPtr));
+
+  StateAugmentedLagrangianCollection collection;
+  collection.add("inactive", create(std::move(inactivePtr), augmented::SlacknessSquaredHingePenalty::create({10.0, 1.0})));
+  collection.add("active", create(std::move(activePtr), augmented::SlacknessSquaredHingePenalty::create({10.0, 1.0})));
+
+  std::vector<Multiplier> termsMultiplier;
+  collection.initializeLagrangian(t, termsMultiplier);
+  const auto termsMetrics = collection.getValue(t, x, termsMultiplier, preComp);
+  const auto expected = collection.getQuadraticApproximation(t, x, termsMultiplier, preComp);
+
+  *numInactiveEvaluationsPtr = 0;
+  *numActiveEvaluationsPtr = 0;
+  const auto approx = collection.getQuadraticApproximation(t, x, termsMultiplier, termsMetrics, preComp);
+  expectEqual(approx, expected);
+  EXPECT_EQ(*numInactiveEvaluationsPtr, 0);
+  EXPECT_EQ(*numActiveEvaluationsPtr, 1);
+}
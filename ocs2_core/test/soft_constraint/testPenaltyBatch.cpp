@@ -0,0 +1,102 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/penalties/Penalties.h>
+
+namespace {
+
+/** Checks the vectorized penalty evaluation against the element-wise scalar interface. */
+void checkTotalValue(const ocs2::PenaltyBase& penalty, const ocs2::vector_t& h) {
+  constexpr ocs2::scalar_t eps = 1e-9;
+  constexpr ocs2::scalar_t t = 0.0;
+
+  ocs2::scalar_t expectedValue = 0.0;
+  ocs2::vector_t expectedDerivative(h.size());
+  ocs2::vector_t expectedSecondDerivative(h.size());
+  for (int i = 0; i < h.size(); i++) {
+    expectedValue += penalty.getValue(t, h(i));
+    expectedDerivative(i) = penalty.getDerivative(t, h(i));
+    expectedSecondDerivative(i) = penalty.getSecondDerivative(t, h(i));
+  }
+
+  ocs2::vector_t derivative, secondDerivative;
+  EXPECT_NEAR(penalty.getTotalValue(t, h), expectedValue, eps) << penalty.name();
+  EXPECT_NEAR(penalty.getTotalValue1stDev2ndDev(t, h, derivative, secondDerivative), expectedValue, eps) << penalty.name();
+  EXPECT_TRUE(derivative.isApprox(expectedDerivative, eps)) << penalty.name();
+  EXPECT_TRUE(secondDerivative.isApprox(expectedSecondDerivative, eps)) << penalty.name();
+}
+
+/** Checks the vectorized augmented penalty evaluation against the element-wise scalar interface. */
+void checkTotalValue(const ocs2::augmented::AugmentedPenaltyBase& penalty, const ocs2::vector_t& l, const ocs2::vector_t& h) {
+  constexpr ocs2::scalar_t eps = 1e-9;
+  constexpr ocs2::scalar_t t = 0.0;
+
+  ocs2::scalar_t expectedValue = 0.0;
+  ocs2::vector_t expectedDerivative(h.size());
+  ocs2::vector_t expectedSecondDerivative(h.size());
+  for (int i = 0; i < h.size(); i++) {
+    expectedValue += penalty.getValue(t, l(i), h(i));
+    expectedDerivative(i) = penalty.getDerivative(t, l(i), h(i));
+    expectedSecondDerivative(i) = penalty.getSecondDerivative(t, l(i), h(i));
+  }
+
+  ocs2::vector_t derivative, secondDerivative;
+  EXPECT_NEAR(penalty.getTotalValue(t, &l, h), expectedValue, eps) << penalty.name();
+  EXPECT_NEAR(penalty.getTotalValue1stDev2ndDev(t, &l, h, derivative, secondDerivative), expectedValue, eps) << penalty.name();
+  EXPECT_TRUE(derivative.isApprox(expectedDerivative, eps)) << penalty.name();
+  EXPECT_TRUE(secondDerivative.isApprox(expectedSecondDerivative, eps)) << penalty.name();
+
+  // zero multipliers
+  const ocs2::vector_t zero = ocs2::vector_t::Zero(h.size());
+  EXPECT_NEAR(penalty.getTotalValue(t, nullptr, h), penalty.getTotalValue(t, &zero, h), eps) << penalty.name();
+}
+
+}  // unnamed namespace
+
+TEST(testPenaltyBatch, penalties) {
+  // constraint values on both sides of the relaxation parameters
+  const ocs2::vector_t h = (ocs2::vector_t(8) << -2.0, -0.5, -1e-4, 0.0, 1e-4, 0.05, 0.5, 3.0).finished();
+
+  checkTotalValue(ocs2::RelaxedBarrierPenalty({0.1, 1e-3}), h);
+  checkTotalValue(ocs2::SquaredHingePenalty({10.0, 0.1}), h);
+  checkTotalValue(ocs2::QuadraticPenalty(5.0), h);
+  checkTotalValue(ocs2::SmoothAbsolutePenalty({10.0, 1e-2}), h);
+  checkTotalValue(ocs2::DoubleSidedPenalty(-0.5, 0.5, std::unique_ptr<ocs2::PenaltyBase>(new ocs2::RelaxedBarrierPenalty({0.1, 0.1}))), h);
+}
+
+TEST(testPenaltyBatch, augmentedPenalties) {
+  const ocs2::vector_t h = (ocs2::vector_t(6) << -2.0, -0.5, 0.0, 1e-4, 0.5, 3.0).finished();
+  const ocs2::vector_t l = ocs2::vector_t::LinSpaced(h.size(), -1.0, 1.0);
+
+  checkTotalValue(ocs2::augmented::QuadraticPenalty({10.0, 1.0}), l, h);
+  checkTotalValue(ocs2::augmented::SmoothAbsolutePenalty({10.0, 1e-2, 1.0}), l, h);
+  checkTotalValue(ocs2::augmented::SlacknessSquaredHingePenalty({10.0, 0.1}), l, h);
+}
@@ -0,0 +1,70 @@
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/AdaptiveThreadCount.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+using namespace ocs2;
+
+TEST(testThreadAffinity, parseCpuList) {
+  EXPECT_TRUE(parseCpuList("").empty());
+  EXPECT_EQ(parseCpuList("3"), std::vector<int>({3}));
+  EXPECT_EQ(parseCpuList("0, 2,4-7"), std::vector<int>({0, 2, 4, 5, 6, 7}));
+  EXPECT_EQ(parseCpuList("physical"), getPhysicalCores());
+  EXPECT_THROW(parseCpuList("1,a"), std::runtime_error);
+  EXPECT_THROW(parseCpuList("5-2"), std::runtime_error);
+  EXPECT_THROW(parseCpuList("-1"), std::runtime_error);
+}
+
+TEST(testThreadAffinity, physicalCores) {
+  const auto physicalCores = getPhysicalCores();
+  ASSERT_FALSE(physicalCores.empty());
+  EXPECT_LE(physicalCores.size(), std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+TEST(testThreadAffinity, pinnedPool) {
+  const auto cpus = getPhysicalCores();
+  ThreadPool pool(2, 0, {cpus.front()});
+  std::atomic_int counter{0};
+  pool.runParallel([&](int) { counter++; }, 3);
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testAdaptiveThreadCount, settlesAtSaturation) {
+  constexpr size_t numSamples = 3;
+  AdaptiveThreadCount threadCount(8, numSamples, 0.05, 1000);
+  // the duration scales down to 3 threads and saturates afterwards
+  const auto duration = [](size_t n) { return 1.0 / static_cast<scalar_t>(std::min(n, size_t(3))); };
+  for (size_t i = 0; i < 100 * numSamples; ++i) {
+    threadCount.update(duration(threadCount.get()));
+  }
+  EXPECT_EQ(threadCount.get(), 3);
+
+  threadCount.reset();
+  EXPECT_EQ(threadCount.get(), 8);
+}
+
+TEST(testAdaptiveThreadCount, keepsScalingThreads) {
+  AdaptiveThreadCount threadCount(4, 1, 0.05, 1000);
+  for (size_t i = 0; i < 100; ++i) {
+    threadCount.update(1.0 / static_cast<scalar_t>(threadCount.get()));
+  }
+  EXPECT_EQ(threadCount.get(), 4);
+}
+
+TEST(testAdaptiveThreadCount, reprobesLargerCount) {
+  AdaptiveThreadCount threadCount(4, 1, 0.05, 5);
+  // no scaling at first
+  for (size_t i = 0; i < 20; ++i) {
+    threadCount.update(1.0);
+  }
+  EXPECT_EQ(threadCount.get(), 1);
+
+  // the task becomes parallelizable
+  for (size_t i = 0; i < 100; ++i) {
+    threadCount.update(1.0 / static_cast<scalar_t>(threadCount.get()));
+  }
+  EXPECT_EQ(threadCount.get(), 4);
+}
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 #include <ocs2_oc/oc_data/DualSolution.h>
@@ -80,6 +81,35 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
 scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
                            PrimalSolution& primalSolution);
 
+/**
+ * Finds the post-event indices of a time grid generated by a time-triggered rollout. Such a grid resolves every event in
+ * (timeGrid.front(), timeGrid.back()] by a pre-event node at the event time followed by a post-event node.
+ *
+ * @param [in] timeGrid: The time grid, e.g. the time stamps of the nominal controller.
+ * @param [in] eventTimes: The event times of the mode schedule.
+ * @param [out] postEventIndices: The post-event indices of the time grid.
+ * @return false if the time grid does not resolve all the events.
+ */
+bool findPostEventIndices(const scalar_array_t& timeGrid, const scalar_array_t& eventTimes, size_array_t& postEventIndices);
+
+/**
+ * Forward simulates the system dynamics with the given controller on a fixed time grid. The state is propagated over each interval
+ * by a single step of the discretizer while the input is held constant at its value on the interval's starting node. On the events,
+ * the jump map is applied instead. Compared to rolloutTrajectory, the number of dynamics evaluations is fixed by the grid.
+ *
+ * @param [in] discretizer: The dynamics discretizer.
+ * @param [in] dynamics: A reference to the system dynamics.
+ * @param [in] timeGrid: The time grid.
+ * @param [in] postEventIndices: The post-event indices of the time grid, see findPostEventIndices.
+ * @param [in] initState: The initial state.
+ * @param [in, out] primalSolution: The resulting primal solution. The trajectories are computed based on the controller stored in
+ *                                  primalSolution. The modeSchedule field is not modified.
+ *
+ * @return average time step.
+ */
+scalar_t discreteRolloutTrajectory(const DynamicsDiscretizer& discretizer, SystemDynamicsBase& dynamics, const scalar_array_t& timeGrid,
+                                   const size_array_t& postEventIndices, const vector_t& initState, PrimalSolution& primalSolution);
+
 /**
  * Extract a primal solution for the range [initTime, finalTime] from a given primal solution. It assumes that the
  * given range is within the solution time of input primal solution.
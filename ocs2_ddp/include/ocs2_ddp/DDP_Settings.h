@@ -30,9 +30,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/Integrator.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
 
 #include "ocs2_ddp/search_strategy/StrategySettings.h"
 
@@ -68,6 +70,8 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** CPUs of the nThreads - 1 worker threads, loaded from a CPU list (see parseCpuList). An empty list does not pin the workers. */
+  std::vector<int> threadAffinity_;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
@@ -95,6 +99,14 @@ struct Settings {
   scalar_t timeStep_ = 1e-2;
   /** The backward pass integrator type: SLQ uses it for solving Riccati equation and ILQR uses it for discretizing LQ approximation. */
   IntegratorType backwardPassIntegratorType_ = IntegratorType::ODE45;
+  /**
+   * If true, the search strategy evaluates its candidates by propagating the state over the fixed node grid of the nominal solution
+   * with a single discretization step per interval, instead of an adaptive rollout. The rollout is still used whenever the node grid
+   * does not resolve the events of the current mode schedule.
+   */
+  bool discreteRollout_ = false;
+  /** The discretization scheme of the node grid evaluation. */
+  SensitivityIntegratorType discreteRolloutIntegratorType_ = SensitivityIntegratorType::RK4;
 
   /** The initial coefficient of the quadratic penalty function in augmented Lagrangian method. It should be greater than one. */
   scalar_t constraintPenaltyInitialValue_ = 2.0;
@@ -393,6 +393,9 @@ class GaussNewtonDDP : public SolverBase {
   // constructed and solved before terminating run()
   DualDataContainer cachedDualData_;
   PrimalDataContainer cachedPrimalData_;
+  // the packed intermediates of the dual solution which the search strategy is run from. It is packed once per search, since all the
+  // search steps initialize their dual solution from it. In runInit, it holds the warm start shifted to the new initial time.
+  MultiplierTrajectory cachedDualIntermediates_;
 
   struct ConstraintPenaltyCoefficients {
     scalar_t penaltyTol = 1e-3;
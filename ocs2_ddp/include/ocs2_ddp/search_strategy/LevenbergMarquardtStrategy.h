@@ -71,8 +71,8 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
   void reset() override;
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-           const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
-           search_strategy::SolutionRef solution) override;
+           const LinearController& unoptimizedController, const DualSolution& dualSolution, const MultiplierTrajectory& dualIntermediates,
+           const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) override;
 
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
@@ -97,8 +97,10 @@ class LevenbergMarquardtStrategy final : public SearchStrategyBase {
   RolloutBase& rolloutRef_;
   OptimalControlProblem& optimalControlProblemRef_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
+  DynamicsDiscretizer discretizer_;
 
   DualSolution tempDualSolution_;
+  size_array_t nodeGridPostEventIndices_;
 };
 
 }  // namespace ocs2
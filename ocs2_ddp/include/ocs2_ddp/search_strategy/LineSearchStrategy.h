@@ -73,8 +73,8 @@ class LineSearchStrategy final : public SearchStrategyBase {
   void reset() override {}
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-           const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
-           search_strategy::SolutionRef solution) override;
+           const LinearController& unoptimizedController, const DualSolution& dualSolution, const MultiplierTrajectory& dualIntermediates,
+           const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) override;
 
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
@@ -90,6 +90,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
     const vector_t* initStatePtr;
     const LinearController* unoptimizedControllerPtr;
     const DualSolution* dualSolutionPtr;
+    const MultiplierTrajectory* dualIntermediatesPtr;
     const ModeSchedule* modeSchedulePtr;
   };
 
@@ -115,9 +116,12 @@ class LineSearchStrategy final : public SearchStrategyBase {
   std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock_;
   std::vector<std::reference_wrapper<OptimalControlProblem>> optimalControlProblemRefStock_;
   std::function<scalar_t(PerformanceIndex)> meritFunc_;
+  DynamicsDiscretizer discretizer_;
 
   // input
   LineSearchInputRef lineSearchInputRef_;
+  bool useNodeGrid_ = false;  // evaluate the candidates on the node grid of the unoptimized controller
+  size_array_t nodeGridPostEventIndices_;
   // output
   std::atomic<scalar_t> bestStepSize_{0.0};
   search_strategy::SolutionRef* bestSolutionRef_;
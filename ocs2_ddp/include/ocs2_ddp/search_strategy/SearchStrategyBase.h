@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/ModelData.h>
+#include <ocs2_core/model_data/MultiplierTrajectory.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 
 #include <ocs2_oc/oc_data/DualSolution.h>
@@ -82,13 +83,15 @@ class SearchStrategyBase {
    * @param [in] expectedCost: The expected cost based on the LQ model optimization.
    * @param [in] unoptimizedController: The unoptimized controller which search will be performed.
    * @param [in] dualSolution: The dual solution.
+   * @param [in] dualIntermediates: The packed intermediates of dualSolution.
    * @param [in] ModeSchedule The current mode schedule.
    * @param [in/out]
    * @param [out] solution: Output of search (primalSolution, performanceIndex, problemMetrics, avgTimeStep)
    * @return whether the search was successful or failed.
    */
   virtual bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-                   const LinearController& unoptimizedController, const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
+                   const LinearController& unoptimizedController, const DualSolution& dualSolution,
+                   const MultiplierTrajectory& dualIntermediates, const ModeSchedule& modeSchedule,
                    search_strategy::SolutionRef solution) = 0;
 
   /**
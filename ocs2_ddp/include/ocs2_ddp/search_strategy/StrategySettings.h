@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/Types.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_ddp/HessianCorrection.h>
 
 namespace ocs2 {
@@ -72,6 +73,10 @@ struct Settings {
   scalar_t minRelCost = 1e-3;
   /** This value determines the tolerance of constraint's ISE (Integral of Square Error). */
   scalar_t constraintTolerance = 1e-3;
+  /** If true, the candidates are evaluated on the nominal node grid with one discretization step per interval instead of a rollout. */
+  bool discreteRollout = false;
+  /** The discretization scheme of the node grid evaluation. */
+  SensitivityIntegratorType discreteRolloutIntegratorType = SensitivityIntegratorType::RK4;
 };  // end of Settings
 
 }  // namespace search_strategy
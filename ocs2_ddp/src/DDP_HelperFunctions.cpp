@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/PreComputation.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/Numerics.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
 namespace ocs2 {
@@ -184,6 +185,74 @@ scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector
   return (finalTime - initTime) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool findPostEventIndices(const scalar_array_t& timeGrid, const scalar_array_t& eventTimes, size_array_t& postEventIndices) {
+  postEventIndices.clear();
+  if (timeGrid.size() < 2) {
+    return false;
+  }
+
+  // same as the rollout: no event at the initial time but there can be one at the final time
+  const auto firstEventItr = std::upper_bound(eventTimes.cbegin(), eventTimes.cend(), timeGrid.front());
+  const auto lastEventItr = std::upper_bound(eventTimes.cbegin(), eventTimes.cend(), timeGrid.back());
+
+  size_t k = 0;
+  for (auto eventItr = firstEventItr; eventItr != lastEventItr; ++eventItr) {
+    while (k < timeGrid.size() && timeGrid[k] < *eventItr && !numerics::almost_eq(timeGrid[k], *eventItr)) {
+      ++k;
+    }
+    // a pre-event node at the event time followed by a post-event node
+    if (k + 1 >= timeGrid.size() || !numerics::almost_eq(timeGrid[k], *eventItr)) {
+      postEventIndices.clear();
+      return false;
+    }
+    postEventIndices.push_back(++k);
+  }  // end of eventItr loop
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t discreteRolloutTrajectory(const DynamicsDiscretizer& discretizer, SystemDynamicsBase& dynamics, const scalar_array_t& timeGrid,
+                                   const size_array_t& postEventIndices, const vector_t& initState, PrimalSolution& primalSolution) {
+  auto& controller = *primalSolution.controllerPtr_;
+  const size_t N = timeGrid.size();
+
+  primalSolution.timeTrajectory_ = timeGrid;
+  primalSolution.postEventIndices_ = postEventIndices;
+  primalSolution.stateTrajectory_.resize(N);
+  primalSolution.inputTrajectory_.resize(N);
+
+  auto& stateTrajectory = primalSolution.stateTrajectory_;
+  auto& inputTrajectory = primalSolution.inputTrajectory_;
+  auto postEventItr = postEventIndices.cbegin();
+  stateTrajectory.front() = initState;
+  for (size_t k = 0; k < N; ++k) {
+    inputTrajectory[k] = controller.computeInput(timeGrid[k], stateTrajectory[k]);
+    if (k + 1 == N) {
+      break;
+    }
+
+    if (postEventItr != postEventIndices.cend() && *postEventItr == k + 1) {
+      stateTrajectory[k + 1] = dynamics.computeJumpMap(timeGrid[k], stateTrajectory[k]);
+      ++postEventItr;
+    } else {
+      stateTrajectory[k + 1] = discretizer(dynamics, timeGrid[k], stateTrajectory[k], inputTrajectory[k], timeGrid[k + 1] - timeGrid[k]);
+    }
+  }  // end of k loop
+
+  if (!stateTrajectory.back().allFinite()) {
+    throw std::runtime_error("[discreteRolloutTrajectory] System became unstable during the rollout!");
+  }
+
+  // average time step
+  return (timeGrid.back() - timeGrid.front()) / static_cast<scalar_t>(N);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
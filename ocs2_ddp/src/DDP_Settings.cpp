@@ -37,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/property_tree/ptree.hpp>
 
 #include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 
 namespace ocs2 {
 namespace ddp {
@@ -69,6 +70,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  std::string threadAffinity;
+  loadData::loadPtreeValue(pt, threadAffinity, fieldName + ".threadAffinity", verbose);
+  settings.threadAffinity_ = parseCpuList(threadAffinity);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
@@ -86,6 +90,10 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   auto integratorName = integrator_type::toString(settings.backwardPassIntegratorType_);  // keep default
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".backwardPassIntegratorType", verbose);
   settings.backwardPassIntegratorType_ = integrator_type::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.discreteRollout_, fieldName + ".discreteRollout", verbose);
+  auto discreteRolloutIntegratorName = sensitivity_integrator::toString(settings.discreteRolloutIntegratorType_);  // keep default
+  loadData::loadPtreeValue(pt, discreteRolloutIntegratorName, fieldName + ".discreteRolloutIntegratorType", verbose);
+  settings.discreteRolloutIntegratorType_ = sensitivity_integrator::fromString(discreteRolloutIntegratorName);
 
   loadData::loadPtreeValue(pt, settings.constraintPenaltyInitialValue_, fieldName + ".constraintPenaltyInitialValue", verbose);
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
@@ -54,7 +54,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_, ddpSettings_.threadAffinity_) {
   // check OCP
   if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
     throw std::runtime_error(
@@ -90,6 +91,8 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
     s.debugPrintRollout = ddpSettings_.debugPrintRollout_;
     s.minRelCost = ddpSettings_.minRelCost_;
     s.constraintTolerance = ddpSettings_.constraintTolerance_;
+    s.discreteRollout = ddpSettings_.discreteRollout_;
+    s.discreteRolloutIntegratorType = ddpSettings_.discreteRolloutIntegratorType_;
     return s;
   }();
   auto meritFunc = [this](const PerformanceIndex& p) { return calculateRolloutMerit(p); };
@@ -176,6 +179,7 @@ void GaussNewtonDDP::reset() {
   nominalPrimalData_.clear();
   cachedDualData_.clear();
   cachedPrimalData_.clear();
+  cachedDualIntermediates_.clear();
 
   // optimized data
   optimizedDualSolution_.clear();
@@ -201,58 +205,18 @@ void GaussNewtonDDP::reset() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const {
-  // total number of nodes
-  const int N = optimizedPrimalSolution_.timeTrajectory_.size();
-
-  auto getRequestedDataLength = [](const scalar_array_t& timeTrajectory, scalar_t time) {
-    int index = std::distance(timeTrajectory.cbegin(), std::upper_bound(timeTrajectory.cbegin(), timeTrajectory.cend(), time));
-    // fix solution time window to include 1 point beyond requested time
-    index += (index != timeTrajectory.size()) ? 1 : 0;
-    return index;
-  };
-
-  auto getRequestedEventDataLength = [](const size_array_t& postEventIndices, int finalIndex) {
-    return std::distance(postEventIndices.cbegin(), std::upper_bound(postEventIndices.cbegin(), postEventIndices.cend(), finalIndex));
-  };
-
-  // length of trajectories
-  const int length = getRequestedDataLength(optimizedPrimalSolution_.timeTrajectory_, finalTime);
-  const int eventLenght = getRequestedEventDataLength(optimizedPrimalSolution_.postEventIndices_, length - 1);
-
-  // fill trajectories
-  primalSolutionPtr->timeTrajectory_.clear();
-  primalSolutionPtr->timeTrajectory_.reserve(length);
-  primalSolutionPtr->stateTrajectory_.clear();
-  primalSolutionPtr->stateTrajectory_.reserve(length);
-  primalSolutionPtr->inputTrajectory_.clear();
-  primalSolutionPtr->inputTrajectory_.reserve(length);
-  primalSolutionPtr->postEventIndices_.clear();
-  primalSolutionPtr->postEventIndices_.reserve(eventLenght);
-
-  primalSolutionPtr->timeTrajectory_.insert(primalSolutionPtr->timeTrajectory_.end(), optimizedPrimalSolution_.timeTrajectory_.begin(),
-                                            optimizedPrimalSolution_.timeTrajectory_.begin() + length);
-  primalSolutionPtr->stateTrajectory_.insert(primalSolutionPtr->stateTrajectory_.end(), optimizedPrimalSolution_.stateTrajectory_.begin(),
-                                             optimizedPrimalSolution_.stateTrajectory_.begin() + length);
-  primalSolutionPtr->inputTrajectory_.insert(primalSolutionPtr->inputTrajectory_.end(), optimizedPrimalSolution_.inputTrajectory_.begin(),
-                                             optimizedPrimalSolution_.inputTrajectory_.begin() + length);
-  primalSolutionPtr->postEventIndices_.insert(primalSolutionPtr->postEventIndices_.end(),
-                                              optimizedPrimalSolution_.postEventIndices_.begin(),
-                                              optimizedPrimalSolution_.postEventIndices_.begin() + eventLenght);
+  // fill trajectories and mode schedule, reusing the memory of the destination
+  getTimeSlicedTrajectories(optimizedPrimalSolution_, finalTime, *primalSolutionPtr);
 
   // fill controller
   if (ddpSettings_.useFeedbackPolicy_) {
-    primalSolutionPtr->controllerPtr_.reset(new LinearController);
-    // length of the copy
-    const int length = getRequestedDataLength(getLinearController(optimizedPrimalSolution_).timeStamp_, finalTime);
-    primalSolutionPtr->controllerPtr_->concatenate(optimizedPrimalSolution_.controllerPtr_.get(), 0, length);
-
+    getTimeSlicedController(*optimizedPrimalSolution_.controllerPtr_, finalTime, primalSolutionPtr->controllerPtr_);
+  } else if (auto* feedforwardControllerPtr = dynamic_cast<FeedforwardController*>(primalSolutionPtr->controllerPtr_.get())) {
+    feedforwardControllerPtr->setController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_);
   } else {
     primalSolutionPtr->controllerPtr_.reset(
         new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
   }
-
-  // fill mode schedule
-  primalSolutionPtr->modeSchedule_ = optimizedPrimalSolution_.modeSchedule_;
 }
 
 /******************************************************************************************************/
@@ -631,6 +595,10 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
   // perform the LQ approximation for intermediate times
   approximateIntermediateLQ(nominalDualData_.dualSolution, nominalPrimalData_);
 
+  // the metrics of the nominal primal solution let the approximation skip the locally constant Lagrangian terms
+  const bool hasMetrics =
+      nominalPrimalData_.problemMetrics.intermediates.size() == nominalPrimalData_.primalSolution.timeTrajectory_.size();
+
   /*
    * compute and augment the LQ approximation of the event times.
    * also call shiftHessian on the event time's cost 2nd order derivative.
@@ -641,7 +609,7 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
   if (NE > 0) {
     nextTimeIndex_ = 0;
     nextTaskId_ = 0;
-    auto task = [this, NE]() {
+    auto task = [this, NE, hasMetrics]() {
       const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
 
       // timeIndex is atomic
@@ -654,7 +622,12 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
         const auto& multiplier = nominalDualData_.dualSolution.preJumps[timeIndex];
 
         // approximate LQ for the pre-event node
-        ocs2::approximatePreJumpLQ(optimalControlProblemStock_[taskId], time, state, multiplier, modelData);
+        if (hasMetrics) {
+          const auto& metrics = nominalPrimalData_.problemMetrics.preJumps[timeIndex];
+          ocs2::approximatePreJumpLQ(optimalControlProblemStock_[taskId], time, state, multiplier, metrics, modelData);
+        } else {
+          ocs2::approximatePreJumpLQ(optimalControlProblemStock_[taskId], time, state, multiplier, modelData);
+        }
 
         // checking the numerical properties
         if (ddpSettings_.checkNumericalStability_) {
@@ -689,7 +662,11 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
     const auto& time = nominalPrimalData_.primalSolution.timeTrajectory_.back();
     const auto& state = nominalPrimalData_.primalSolution.stateTrajectory_.back();
     const auto& multiplier = nominalDualData_.dualSolution.final;
-    modelData = ocs2::approximateFinalLQ(optimalControlProblemStock_[0], time, state, multiplier);
+    if (hasMetrics) {
+      ocs2::approximateFinalLQ(optimalControlProblemStock_[0], time, state, multiplier, nominalPrimalData_.problemMetrics.final, modelData);
+    } else {
+      modelData = ocs2::approximateFinalLQ(optimalControlProblemStock_[0], time, state, multiplier);
+    }
 
     // checking the numerical properties
     if (ddpSettings_.checkNumericalStability_) {
@@ -895,9 +872,14 @@ void GaussNewtonDDP::runInit() {
           trajectorySpread(optimizedPrimalSolution_.modeSchedule_, nominalPrimalData_.primalSolution.modeSchedule_, optimizedDualSolution_);
     }
 
-    // initialize dual solution
+    // shift the warm start to the new initial time on the packed intermediates
+    cachedDualIntermediates_.assign(optimizedDualSolution_.intermediates);
+    ocs2::shiftDualSolution(nominalPrimalData_.primalSolution.timeTrajectory_.front(), optimizedDualSolution_, cachedDualIntermediates_);
+
+    // initialize dual solution. The warm start is consumed here and optimizedDualSolution_ is rebuilt by the search strategy.
     ocs2::initializeDualSolution(optimalControlProblemStock_[0], nominalPrimalData_.primalSolution, optimizedDualSolution_,
-                                 nominalDualData_.dualSolution);
+                                 cachedDualIntermediates_, nominalDualData_.dualSolution);
+    optimizedDualSolution_.clear();
     totalDualSolutionTimer_.endTimer();
 
     computeRolloutMetrics(optimalControlProblemStock_[taskId], nominalPrimalData_.primalSolution, nominalDualData_.dualSolution,
@@ -971,6 +953,7 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   // swap primal and dual data to cache before running search strategy
   nominalDualData_.swap(cachedDualData_);
   nominalPrimalData_.swap(cachedPrimalData_);
+  cachedDualIntermediates_.assign(cachedDualData_.dualSolution.intermediates);
 
   // run search strategy
   scalar_t avgTimeStep;
@@ -978,7 +961,7 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   search_strategy::SolutionRef solution(avgTimeStep, nominalDualData_.dualSolution, nominalPrimalData_.primalSolution,
                                         nominalPrimalData_.problemMetrics, performanceIndex_);
   const bool success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController_,
-                                               cachedDualData_.dualSolution, modeSchedule, solution);
+                                               cachedDualData_.dualSolution, cachedDualIntermediates_, modeSchedule, solution);
 
   // revert to the old solution if search failed
   if (success) {
@@ -1147,10 +1130,11 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   scalar_t avgTimeStep;
   const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
   const auto lqModelExpectedCost = nominalDualData_.valueFunctionTrajectory.front().f;
+  cachedDualIntermediates_.assign(nominalDualData_.dualSolution.intermediates);
   search_strategy::SolutionRef solution(avgTimeStep, optimizedDualSolution_, optimizedPrimalSolution_, optimizedProblemMetrics_,
                                         performanceIndex_);
   const bool success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController_,
-                                               nominalDualData_.dualSolution, modeSchedule, solution);
+                                               nominalDualData_.dualSolution, cachedDualIntermediates_, modeSchedule, solution);
 
   // revert to the old solution if search failed
   if (success) {
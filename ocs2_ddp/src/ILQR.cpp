@@ -47,13 +47,17 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
   sensitivityDiscretizer_ = [&]() {
     switch (settings().backwardPassIntegratorType_) {
       case IntegratorType::EULER:
+      case IntegratorType::EULER_OCS2:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::EULER);
       case IntegratorType::RK4:
+      case IntegratorType::RK4_OCS2:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
       case IntegratorType::ODE45:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
       case IntegratorType::ODE45_OCS2:
         return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+      case IntegratorType::IMPLICIT_MIDPOINT_OCS2:
+        return selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::IMPLICIT_MIDPOINT);
       default:
         throw std::runtime_error("[ILQR] Integrator of type " + integrator_type::toString(settings().backwardPassIntegratorType_) +
                                  " is not supported for sensitivity discretization! Modify ddp::Settings::backwardPassIntegratorType_.");
@@ -83,6 +87,9 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
   const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
   const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
   const auto& multiplierTrajectory = dualSolution.intermediates;
+  // the metrics of the primal solution let the approximation skip the locally constant Lagrangian terms
+  const auto& metricsTrajectory = primalData.problemMetrics.intermediates;
+  const bool hasMetrics = metricsTrajectory.size() == timeTrajectory.size();
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
   modelDataTrajectory.clear();
@@ -99,8 +106,14 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
     size_t timeIndex;
     while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
       // approximate continuous LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
+      if (hasMetrics) {
+        ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                        inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], metricsTrajectory[timeIndex],
+                                        continuousTimeModelData);
+      } else {
+        ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                        inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
+      }
 
       // checking the numerical properties
       if (settings().checkNumericalStability_) {
@@ -56,7 +56,7 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
 
   const auto integratorType = settings().backwardPassIntegratorType_;
   if (integratorType != IntegratorType::ODE45 && integratorType != IntegratorType::BULIRSCH_STOER &&
-      integratorType != IntegratorType::ODE45_OCS2 && integratorType != IntegratorType::RK4) {
+      integratorType != IntegratorType::ODE45_OCS2 && integratorType != IntegratorType::RK4 && integratorType != IntegratorType::RK4_OCS2) {
     throw(std::runtime_error("Unsupported Riccati equation integrator type: " +
                              integrator_type::toString(settings().backwardPassIntegratorType_)));
   }
@@ -82,6 +82,9 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
   const auto& inputTrajectory = primalData.primalSolution.inputTrajectory_;
   const auto& postEventIndices = primalData.primalSolution.postEventIndices_;
   const auto& multiplierTrajectory = dualSolution.intermediates;
+  // the metrics of the primal solution let the approximation skip the locally constant Lagrangian terms
+  const auto& metricsTrajectory = primalData.problemMetrics.intermediates;
+  const bool hasMetrics = metricsTrajectory.size() == timeTrajectory.size();
   auto& modelDataTrajectory = primalData.modelDataTrajectory;
 
   modelDataTrajectory.clear();
@@ -96,8 +99,14 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
     size_t timeIndex;
     while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
       // approximate LQ for the given time index
-      ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
-                                      inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
+      if (hasMetrics) {
+        ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                        inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], metricsTrajectory[timeIndex],
+                                        modelDataTrajectory[timeIndex]);
+      } else {
+        ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
+                                        inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
+      }
 
       // checking the numerical properties
       if (settings().checkNumericalStability_) {
@@ -47,7 +47,8 @@ LevenbergMarquardtStrategy::LevenbergMarquardtStrategy(search_strategy::Settings
       settings_(std::move(settings)),
       rolloutRef_(rolloutRef),
       optimalControlProblemRef_(optimalControlProblemRef),
-      meritFunc_(std::move(meritFunc)) {}
+      meritFunc_(std::move(meritFunc)),
+      discretizer_(selectDynamicsDiscretization(baseSettings_.discreteRolloutIntegratorType)) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -61,8 +62,8 @@ void LevenbergMarquardtStrategy::reset() {
 /******************************************************************************************************/
 bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState,
                                      const scalar_t expectedCost, const LinearController& unoptimizedController,
-                                     const DualSolution& dualSolution, const ModeSchedule& modeSchedule,
-                                     search_strategy::SolutionRef solution) {
+                                     const DualSolution& dualSolution, const MultiplierTrajectory& dualIntermediates,
+                                     const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) {
   constexpr size_t taskId = 0;
 
   // previous merit and the expected reduction
@@ -76,10 +77,16 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
     // compute primal solution
     solution.primalSolution.modeSchedule_ = modeSchedule;
     incrementController(stepLength, unoptimizedController, getLinearController(solution.primalSolution));
-    solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
+    const auto& nodeGrid = unoptimizedController.timeStamp_;
+    if (baseSettings_.discreteRollout && findPostEventIndices(nodeGrid, modeSchedule.eventTimes, nodeGridPostEventIndices_)) {
+      solution.avgTimeStep = discreteRolloutTrajectory(discretizer_, *optimalControlProblemRef_.dynamicsPtr, nodeGrid,
+                                                       nodeGridPostEventIndices_, initState, solution.primalSolution);
+    } else {
+      solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
+    }
 
     // adjust dual solution only if it is required
-    const DualSolution* adjustedDualSolutionPtr = &dualSolution;
+    bool isDualSolutionAdjusted = false;
     if (!dualSolution.timeTrajectory.empty()) {
       // trajectory spreading
       constexpr bool debugPrint = false;
@@ -87,12 +94,16 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
       const auto status = trajectorySpreading.set(modeSchedule, solution.primalSolution.modeSchedule_, dualSolution.timeTrajectory);
       if (status.willTruncate || status.willPerformTrajectorySpreading) {
         trajectorySpread(trajectorySpreading, dualSolution, tempDualSolution_);
-        adjustedDualSolutionPtr = &tempDualSolution_;
+        isDualSolutionAdjusted = true;
       }
     }
 
-    // initialize dual solution
-    initializeDualSolution(optimalControlProblemRef_, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
+    // initialize dual solution. The packed intermediates are only valid for the unadjusted dual solution.
+    if (isDualSolutionAdjusted) {
+      initializeDualSolution(optimalControlProblemRef_, solution.primalSolution, tempDualSolution_, solution.dualSolution);
+    } else {
+      initializeDualSolution(optimalControlProblemRef_, solution.primalSolution, dualSolution, dualIntermediates, solution.dualSolution);
+    }
 
     // compute problem metrics
     computeRolloutMetrics(optimalControlProblemRef_, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
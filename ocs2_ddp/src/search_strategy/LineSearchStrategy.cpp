@@ -51,7 +51,8 @@ LineSearchStrategy::LineSearchStrategy(search_strategy::Settings baseSettings, l
       workersSolution_(threadPoolRef.numThreads() + 1),
       rolloutRefStock_(std::move(rolloutRefStock)),
       optimalControlProblemRefStock_(std::move(optimalControlProblemRefStock)),
-      meritFunc_(std::move(meritFunc)) {
+      meritFunc_(std::move(meritFunc)),
+      discretizer_(selectDynamicsDiscretization(baseSettings_.discreteRolloutIntegratorType)) {
   // infeasible learning rate adjustment scheme
   if (!numerics::almost_ge(settings_.maxStepLength, settings_.minStepLength)) {
     throw std::runtime_error("The maximum learning rate is smaller than the minimum learning rate.");
@@ -90,11 +91,17 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   // compute primal solution
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
-  solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  if (useNodeGrid_) {
+    solution.avgTimeStep =
+        discreteRolloutTrajectory(discretizer_, *problem.get().dynamicsPtr, lineSearchInputRef_.unoptimizedControllerPtr->timeStamp_,
+                                  nodeGridPostEventIndices_, *lineSearchInputRef_.initStatePtr, solution.primalSolution);
+  } else {
+    solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+                                             lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  }
 
   // adjust dual solution only if it is required
-  const DualSolution* adjustedDualSolutionPtr = lineSearchInputRef_.dualSolutionPtr;
+  bool isDualSolutionAdjusted = false;
   if (!lineSearchInputRef_.dualSolutionPtr->timeTrajectory.empty()) {
     // trajectory spreading
     constexpr bool debugPrint = false;
@@ -103,12 +110,17 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
                                                 lineSearchInputRef_.dualSolutionPtr->timeTrajectory);
     if (status.willTruncate || status.willPerformTrajectorySpreading) {
       trajectorySpread(trajectorySpreading, *lineSearchInputRef_.dualSolutionPtr, tempDualSolutions_[taskId]);
-      adjustedDualSolutionPtr = &tempDualSolutions_[taskId];
+      isDualSolutionAdjusted = true;
     }
   }
 
-  // initialize dual solution
-  initializeDualSolution(problem, solution.primalSolution, *adjustedDualSolutionPtr, solution.dualSolution);
+  // initialize dual solution. The packed intermediates are only valid for the unadjusted dual solution.
+  if (isDualSolutionAdjusted) {
+    initializeDualSolution(problem, solution.primalSolution, tempDualSolutions_[taskId], solution.dualSolution);
+  } else {
+    initializeDualSolution(problem, solution.primalSolution, *lineSearchInputRef_.dualSolutionPtr,
+                           *lineSearchInputRef_.dualIntermediatesPtr, solution.dualSolution);
+  }
 
   // compute problem metrics
   computeRolloutMetrics(problem, solution.primalSolution, solution.dualSolution, solution.problemMetrics);
@@ -131,15 +143,21 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
 /******************************************************************************************************/
 bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
                              const LinearController& unoptimizedController, const DualSolution& dualSolution,
-                             const ModeSchedule& modeSchedule, search_strategy::SolutionRef solutionRef) {
+                             const MultiplierTrajectory& dualIntermediates, const ModeSchedule& modeSchedule,
+                             search_strategy::SolutionRef solutionRef) {
   // initialize lineSearchModule inputs
   lineSearchInputRef_.timePeriodPtr = &timePeriod;
   lineSearchInputRef_.initStatePtr = &initState;
   lineSearchInputRef_.unoptimizedControllerPtr = &unoptimizedController;
   lineSearchInputRef_.dualSolutionPtr = &dualSolution;
+  lineSearchInputRef_.dualIntermediatesPtr = &dualIntermediates;
   lineSearchInputRef_.modeSchedulePtr = &modeSchedule;
   bestSolutionRef_ = &solutionRef;
 
+  // the node grid is only used if it resolves the events of the current mode schedule
+  useNodeGrid_ = baseSettings_.discreteRollout &&
+                 findPostEventIndices(unoptimizedController.timeStamp_, modeSchedule.eventTimes, nodeGridPostEventIndices_);
+
   // perform a rollout with steplength zero.
   constexpr size_t taskId = 0;
   constexpr scalar_t stepLength = 0.0;
@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
 #include <ocs2_ddp/DDP_HelperFunctions.h>
 
 using namespace ocs2;
@@ -99,3 +101,47 @@ TEST(extractPrimalSolution, eventAtInitTime) {
   //  std::cerr << ">>>>>> Test 3\n" << PrimalSolutionTest3 << "\n";
   EXPECT_EQ(PrimalSolutionTest3.timeTrajectory_.size(), 1);
 }
+
+TEST(discreteRolloutTrajectory, linearSystemWithEvent) {
+  constexpr size_t numTime = 50;
+  constexpr scalar_t timeStep = 0.01;
+  constexpr scalar_t eventTime = numTime * timeStep;
+  constexpr auto eps = numeric_traits::weakEpsilon<scalar_t>();
+
+  // the time grid of a time-triggered rollout with an event at eventTime
+  scalar_array_t timeGrid;
+  for (size_t n = 0; n <= numTime; ++n) {
+    timeGrid.push_back(n * timeStep);
+  }
+  for (size_t n = 0; n <= numTime; ++n) {
+    timeGrid.push_back((n == 0) ? eventTime + eps : eventTime + n * timeStep);
+  }
+
+  size_array_t postEventIndices;
+  ASSERT_TRUE(findPostEventIndices(timeGrid, {eventTime}, postEventIndices));
+  EXPECT_EQ(postEventIndices, size_array_t{numTime + 1});
+  EXPECT_FALSE(findPostEventIndices(timeGrid, {0.5 * timeStep}, postEventIndices));
+  ASSERT_TRUE(findPostEventIndices(timeGrid, {0.0, 2.0 * eventTime + timeStep}, postEventIndices));
+  EXPECT_TRUE(postEventIndices.empty());
+
+  // x_dot = -x + u, x+ = 2 x-, u = 0
+  LinearSystemDynamics dynamics(-matrix_t::Identity(1, 1), matrix_t::Identity(1, 1), 2.0 * matrix_t::Identity(1, 1));
+  const scalar_array_t controllerTime{0.0, 2.0 * eventTime};
+  const vector_array_t controllerBias(2, vector_t::Zero(1));
+  const matrix_array_t controllerGain(2, matrix_t::Zero(1, 1));
+
+  PrimalSolution primalSolution;
+  primalSolution.controllerPtr_.reset(new LinearController(controllerTime, controllerBias, controllerGain));
+  findPostEventIndices(timeGrid, {eventTime}, postEventIndices);
+  const vector_t initState = vector_t::Ones(1);
+  const auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+  discreteRolloutTrajectory(discretizer, dynamics, timeGrid, postEventIndices, initState, primalSolution);
+
+  EXPECT_EQ(primalSolution.timeTrajectory_, timeGrid);
+  EXPECT_EQ(primalSolution.postEventIndices_, postEventIndices);
+  ASSERT_EQ(primalSolution.stateTrajectory_.size(), timeGrid.size());
+  ASSERT_EQ(primalSolution.inputTrajectory_.size(), timeGrid.size());
+  EXPECT_NEAR(primalSolution.stateTrajectory_[numTime](0), std::exp(-eventTime), 1e-8);
+  EXPECT_NEAR(primalSolution.stateTrajectory_[numTime + 1](0), 2.0 * std::exp(-eventTime), 1e-8);
+  EXPECT_NEAR(primalSolution.stateTrajectory_.back()(0), 2.0 * std::exp(-2.0 * eventTime), 1e-7);
+}
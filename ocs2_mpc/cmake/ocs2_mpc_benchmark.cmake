@@ -0,0 +1,34 @@
+# Adds the closed-loop MPC benchmark executable ${PROJECT_NAME}_mpc_benchmark, see ocs2_mpc/MPC_ClosedLoopBenchmark.h.
+# If a THRESHOLDS file is given, the target ${PROJECT_NAME}_mpc_benchmark_regression runs the benchmark and fails when one of its
+# statistics exceeds the thresholds. It is not built by default and is meant to be run by CI, e.g.:
+#   make ocs2_cartpole_mpc_benchmark_regression  (in the build directory of ocs2_cartpole)
+#
+# Usage:
+#   ocs2_add_mpc_benchmark(<source> [THRESHOLDS <file.info>] [COMPILE_OPTIONS <options>...])
+function(ocs2_add_mpc_benchmark SOURCE)
+  cmake_parse_arguments(ARG "" "THRESHOLDS" "COMPILE_OPTIONS" ${ARGN})
+  set(BENCHMARK_TARGET ${PROJECT_NAME}_mpc_benchmark)
+
+  add_executable(${BENCHMARK_TARGET}
+    ${SOURCE}
+  )
+  add_dependencies(${BENCHMARK_TARGET}
+    ${catkin_EXPORTED_TARGETS}
+  )
+  target_include_directories(${BENCHMARK_TARGET} PRIVATE
+    ${PROJECT_BINARY_DIR}/include
+  )
+  target_link_libraries(${BENCHMARK_TARGET}
+    ${PROJECT_NAME}
+    ${catkin_LIBRARIES}
+  )
+  target_compile_options(${BENCHMARK_TARGET} PRIVATE ${ARG_COMPILE_OPTIONS})
+
+  if(ARG_THRESHOLDS)
+    add_custom_target(${BENCHMARK_TARGET}_regression
+      COMMAND ${BENCHMARK_TARGET} --thresholds ${ARG_THRESHOLDS} --output ${PROJECT_BINARY_DIR}/${BENCHMARK_TARGET}.json
+      DEPENDS ${BENCHMARK_TARGET}
+      COMMENT "Running the closed-loop MPC benchmark of ${PROJECT_NAME} against its regression thresholds"
+    )
+  endif()
+endfunction()
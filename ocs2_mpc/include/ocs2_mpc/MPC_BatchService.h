@@ -0,0 +1,128 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/MPC_MRT_Interface.h"
+
+namespace ocs2 {
+
+/**
+ * A service which runs many independent MPC instances (e.g. one per robot in a fleet simulation) on a single shared thread pool.
+ * Each instance is wrapped in an MPC_MRT_Interface, so observations and policies are exchanged with the same thread-safe buffers.
+ *
+ * In every call to advanceMpc(), the instances are dispatched to the workers in earliest-deadline-first order. An instance whose
+ * deadline has already passed when a worker becomes available is skipped and keeps its previous policy.
+ *
+ * @note The solvers of the registered instances should be configured with a single thread (nThreads = 1). The parallelism is then
+ * provided by the service, which avoids oversubscribing the cores with one thread pool per solver.
+ * @note The pool of the service is not shared with the solvers, which keep their own pools (without worker threads if nThreads = 1).
+ * The solvers block in ThreadPool::runParallel until their tasks finish, so a solver which queues tasks on the pool of the service
+ * from one of its workers could wait for workers which are all blocked the same way.
+ */
+class MPC_BatchService {
+ public:
+  /** The outcome of the latest advanceMpc() call for an instance. */
+  struct Status {
+    bool isSkipped = false;         // The instance was not run since its deadline had passed before a worker was available.
+    bool isDeadlineMissed = false;  // The instance was skipped or finished after its deadline.
+    scalar_t solveTime = 0.0;       // The wall time [s] spent in the MPC of this instance.
+  };
+
+  /**
+   * Constructor
+   *
+   * @param [in] nThreads: The number of threads used to run the instances, including the calling thread.
+   * @param [in] threadPriority: The priority of the worker threads.
+   */
+  explicit MPC_BatchService(size_t nThreads, int threadPriority = 0);
+
+  /**
+   * Registers an MPC instance. The service does not take the ownership of the MPC.
+   *
+   * @param [in] mpc: The MPC instance.
+   * @param [in] deadline: The deadline [s] of this instance, measured from the start of each advanceMpc() call.
+   * @return The ID of the instance.
+   */
+  size_t addInstance(MPC_BASE& mpc, scalar_t deadline = std::numeric_limits<scalar_t>::infinity());
+
+  /**
+   * Registers an MPC instance through its existing MPC_MRT_Interface. The service does not take the ownership of the interface.
+   *
+   * @param [in] mpcMrtInterface: The MPC_MRT_Interface of the instance.
+   * @param [in] deadline: The deadline [s] of this instance, measured from the start of each advanceMpc() call.
+   * @return The ID of the instance.
+   */
+  size_t addInstance(MPC_MRT_Interface& mpcMrtInterface, scalar_t deadline = std::numeric_limits<scalar_t>::infinity());
+
+  /** Gets the number of registered instances. */
+  size_t numInstances() const { return instances_.size(); }
+
+  /** Sets the deadline [s] of an instance, measured from the start of each advanceMpc() call. */
+  void setDeadline(size_t instanceId, scalar_t deadline) { instances_.at(instanceId).deadline = deadline; }
+
+  /** Sets the current observation of an instance. */
+  void setCurrentObservation(size_t instanceId, const SystemObservation& observation);
+
+  /**
+   * Advances all the instances for one MPC iteration on the shared thread pool.
+   * @note This call is blocking. It returns when all the instances are either solved or skipped.
+   */
+  void advanceMpc();
+
+  /** Gets the MPC_MRT_Interface of an instance, e.g. to update and evaluate its policy or to access its ReferenceManager. */
+  MPC_MRT_Interface& getMpcMrtInterface(size_t instanceId) { return *instances_.at(instanceId).mpcMrtInterfacePtr; }
+  const MPC_MRT_Interface& getMpcMrtInterface(size_t instanceId) const { return *instances_.at(instanceId).mpcMrtInterfacePtr; }
+
+  /** Gets the status of an instance in the latest advanceMpc() call. */
+  const Status& getStatus(size_t instanceId) const { return instances_.at(instanceId).status; }
+
+ private:
+  struct Instance {
+    MPC_MRT_Interface* mpcMrtInterfacePtr;
+    std::unique_ptr<MPC_MRT_Interface> ownedMpcMrtInterfacePtr;  // Only set if the service has created the MPC_MRT_Interface
+    scalar_t deadline;
+    Status status;
+  };
+
+  size_t nThreads_;
+  ThreadPool threadPool_;
+  std::vector<Instance> instances_;
+  std::vector<size_t> schedule_;  // The instance IDs sorted by their deadlines
+};
+
+}  // namespace ocs2
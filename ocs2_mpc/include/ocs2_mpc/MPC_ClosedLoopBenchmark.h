@@ -0,0 +1,161 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+namespace benchmark {
+
+/** The settings of a Monte-Carlo closed-loop MPC benchmark. */
+struct ClosedLoopSettings {
+  size_t numTrials = 10;         // Number of closed-loop trials with randomized initial states and targets
+  scalar_t duration = 5.0;       // Simulated duration [s] of each trial
+  scalar_t mpcFrequency = 50.0;  // Frequency [Hz] of the MPC calls in the simulated time
+  unsigned int seed = 0;         // Seed of the random number generator
+};
+
+/**
+ * The problem of a closed-loop benchmark. In each trial, the initial state and the target states are perturbed by uniformly
+ * distributed noise.
+ */
+struct ClosedLoopProblem {
+  ClosedLoopProblem(MPC_BASE& mpcArg, const RolloutBase& rolloutArg) : mpc(mpcArg), rollout(rolloutArg) {}
+
+  /** The MPC to benchmark. It is reset at the beginning of each trial. */
+  MPC_BASE& mpc;
+  /** The rollout used to simulate the plant. */
+  const RolloutBase& rollout;
+  /** The nominal initial state and the amplitude of the uniform noise added to it. An empty amplitude adds no noise. */
+  vector_t initState;
+  vector_t initStateNoise;
+  /**
+   * The nominal target trajectories and the amplitude of the uniform noise added to their states, which may not be system states.
+   * An empty amplitude adds no noise.
+   */
+  TargetTrajectories targetTrajectories;
+  vector_t targetStateNoise;
+  /** Optional, called at the beginning of each trial to reset the components which otherwise carry over (e.g., a gait schedule). */
+  std::function<void()> resetTrial;
+};
+
+/**
+ * The raw samples of a closed-loop benchmark. The per-call samples have one entry per MPC call and the per-trial samples have one
+ * entry per trial.
+ */
+struct ClosedLoopSamples {
+  // per MPC call
+  std::vector<scalar_t> solveTimes;  // [ms]
+  std::vector<scalar_t> numIterations;
+  std::vector<scalar_t> cost;
+  std::vector<scalar_t> dynamicsViolationSSE;
+  std::vector<scalar_t> equalityConstraintsSSE;
+  std::vector<scalar_t> inequalityLagrangian;
+  // per trial, only if the target is defined in the state space
+  std::vector<scalar_t> finalTrackingError;  // norm of the state error w.r.t. the target at the end of the trial
+};
+
+/** The regression thresholds of a closed-loop benchmark. A benchmark fails if any of its statistics exceeds its threshold. */
+struct RegressionThresholds {
+  scalar_t solveTimeP90 = std::numeric_limits<scalar_t>::infinity();            // [ms]
+  scalar_t numIterationsMean = std::numeric_limits<scalar_t>::infinity();       // Mean number of iterations per MPC call
+  scalar_t finalTrackingErrorMean = std::numeric_limits<scalar_t>::infinity();  // Mean final tracking error of the trials
+};
+
+/**
+ * Runs the MPC in closed loop through MPC_MRT_Interface, where the plant is simulated by rolling out the MPC policy.
+ *
+ * @param [in] problem: The benchmark problem.
+ * @param [in] settings: The benchmark settings.
+ * @return The samples of all the trials.
+ * @throw std::runtime_error if a noise amplitude is neither empty nor of the size of the vectors it perturbs.
+ */
+ClosedLoopSamples runClosedLoopBenchmark(const ClosedLoopProblem& problem, const ClosedLoopSettings& settings);
+
+/**
+ * Writes the distribution of the samples (mean, standard deviation, min, median, p90, p99, and max) as a JSON object. The non-finite
+ * samples of a diverged trial are excluded from the distribution and counted as "numNonFinite".
+ *
+ * @param [out] stream: The output stream.
+ * @param [in] name: The name of the benchmark.
+ * @param [in] settings: The benchmark settings.
+ * @param [in] samples: The benchmark samples.
+ */
+void writeJson(std::ostream& stream, const std::string& name, const ClosedLoopSettings& settings, const ClosedLoopSamples& samples);
+
+/**
+ * Loads the regression thresholds. The missing thresholds are not checked.
+ *
+ * @param [in] filename: The file name of the INFO file which contains the thresholds.
+ * @param [in] fieldName: The field name which contains the thresholds.
+ * @param [in] verbose: Whether to print the loaded thresholds.
+ */
+RegressionThresholds loadRegressionThresholds(const std::string& filename, const std::string& fieldName = "thresholds",
+                                              bool verbose = true);
+
+/**
+ * Checks the samples against the regression thresholds.
+ *
+ * @param [out] stream: The stream on which the exceeded thresholds are reported.
+ * @param [in] thresholds: The regression thresholds.
+ * @param [in] samples: The benchmark samples.
+ * @return true if no threshold is exceeded.
+ */
+bool checkRegressionThresholds(std::ostream& stream, const RegressionThresholds& thresholds, const ClosedLoopSamples& samples);
+
+/**
+ * The main function of a benchmark executable, which runs the benchmark, writes its JSON summary, and checks the regression thresholds.
+ * The MPC calls run at the MPC desired frequency, if it is set.
+ *
+ * Usage: <executable> [--output <file.json>] [--thresholds <file.info>] [--trials <number>] [--seed <number>]
+ *
+ * The summary is written to the standard output if no output file is given.
+ *
+ * @param [in] argc: The number of command line arguments.
+ * @param [in] argv: The command line arguments.
+ * @param [in] name: The name of the benchmark.
+ * @param [in] problem: The benchmark problem.
+ * @return The exit code: 0 on success, 1 if a regression threshold is exceeded, and 2 for invalid arguments or an output file which
+ * cannot be written.
+ */
+int benchmarkMain(int argc, char** argv, const std::string& name, const ClosedLoopProblem& problem);
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -125,6 +125,7 @@ class MPC_MRT_Interface final : public MRT_BASE {
 
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
+  std::unique_ptr<PrimalSolution> sparePrimalSolutionPtr_;  // replaced in the buffer, reused for the next policy
 
   // MPC inputs
   SystemObservation currentObservation_;
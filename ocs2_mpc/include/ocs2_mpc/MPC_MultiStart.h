@@ -0,0 +1,165 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/synchronized_module/ReferenceManagerInterface.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+
+/**
+ * A multi-start MPC which runs several candidate solvers concurrently and uses the solution of the candidate with the lowest merit.
+ * The candidates differ by their solver instances (e.g., constructed with different Initializers or settings) and optionally by the
+ * references they solve for, which are modified per candidate through a CandidateModifier (e.g., a different ModeSchedule or target).
+ * Each candidate warm-starts from its own previous solution, so the diversity of the candidates is kept over the MPC iterations.
+ *
+ * All candidates share one ReferenceManager. It is updated once before the candidates run, and the candidates receive a copy of its
+ * active references. Setting the references through getSolverPtr()->getReferenceManager() forwards them to the shared ReferenceManager.
+ *
+ * Each MPC iteration waits until all the candidates have finished or the deadline has passed, whichever comes first, and selects the
+ * best candidate which has finished by then. The candidates which are still running continue in the background; they are not restarted
+ * and cannot be selected until they have finished, and their late solution is discarded. Only if no candidate finishes in time, the
+ * iteration waits for the first candidate to finish.
+ *
+ * @note The candidates run on disjoint threads: each candidate has its own worker of this class, optionally pinned to its own CPUs, plus
+ * the internal threads of its solver. In order to not oversubscribe the cores, the solvers should be configured with
+ * nThreads = (number of cores) / (number of candidates).
+ * @note A candidate-specific ModeSchedule is only seen by the solver. Problem components that directly hold the shared ReferenceManager
+ * (e.g., a PreComputation) still use the shared references.
+ */
+class MPC_MultiStart final : public MPC_BASE {
+ public:
+  /**
+   * Modifies the references of a candidate before it runs.
+   *
+   * @param [in] candidateIndex: The index of the candidate.
+   * @param [in] initTime: Start time of the optimization horizon.
+   * @param [in] finalTime: Final time of the optimization horizon.
+   * @param [in] initState: State at the start of the optimization horizon.
+   * @param [in, out] targetTrajectories: The TargetTrajectories of the candidate, initialized by the shared ReferenceManager.
+   * @param [in, out] modeSchedule: The ModeSchedule of the candidate, initialized by the shared ReferenceManager.
+   */
+  using CandidateModifier = std::function<void(size_t candidateIndex, scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                               TargetTrajectories& targetTrajectories, ModeSchedule& modeSchedule)>;
+
+  /** The outcome of the latest MPC iteration for a candidate. */
+  struct CandidateStatus {
+    bool isRunning = false;         // The candidate has not finished yet.
+    bool isFailed = false;          // The solver of the candidate has thrown an exception.
+    bool isDeadlineMissed = false;  // The candidate did not finish before the deadline.
+    scalar_t solveTime = 0.0;       // The wall time [s] spent in the solver of this candidate, once it has finished.
+  };
+
+  /**
+   * Constructor
+   *
+   * @param [in] mpcSettings: Structure containing the settings for the MPC algorithm.
+   * @param [in] solverPtrs: The solvers of the candidates. At least one solver is required.
+   * @param [in] deadline: The deadline [s] of each MPC iteration. If it is not positive, the MPC desired period is used.
+   * @param [in] threadPriority: The priority of the threads which run the candidates.
+   * @param [in] candidateCpus: The CPU ids to pin the worker of each candidate on. It is either empty, which leaves the workers unpinned,
+   * or has one (possibly empty) entry per candidate.
+   */
+  MPC_MultiStart(mpc::Settings mpcSettings, std::vector<std::unique_ptr<SolverBase>> solverPtrs, scalar_t deadline = 0.0,
+                 int threadPriority = 0, const std::vector<std::vector<int>>& candidateCpus = {});
+
+  /** Destructor. Waits for the running candidates to finish. */
+  ~MPC_MultiStart() override;
+
+  /** Resets all the candidates, after waiting for the running ones to finish. */
+  void reset() override;
+
+  /** Gets the solver of the candidate selected in the latest MPC iteration. */
+  SolverBase* getSolverPtr() override { return solverPtrs_[bestCandidateIndex_].get(); }
+  const SolverBase* getSolverPtr() const override { return solverPtrs_[bestCandidateIndex_].get(); }
+
+  /** Sets the ReferenceManager which is shared by all the candidates. */
+  void setReferenceManager(std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr);
+
+  /** Sets the function which modifies the references of each candidate. */
+  void setCandidateModifier(CandidateModifier candidateModifier) { candidateModifier_ = std::move(candidateModifier); }
+
+  /** Gets the number of candidates. */
+  size_t numCandidates() const { return solverPtrs_.size(); }
+
+  /** Gets the index of the candidate selected in the latest MPC iteration. */
+  size_t getBestCandidateIndex() const { return bestCandidateIndex_; }
+
+  /** Gets the solver of a candidate. */
+  SolverBase& getCandidateSolver(size_t candidateIndex) { return *solverPtrs_.at(candidateIndex); }
+  const SolverBase& getCandidateSolver(size_t candidateIndex) const { return *solverPtrs_.at(candidateIndex); }
+
+  /** Gets the status of a candidate in its latest run. */
+  CandidateStatus getCandidateStatus(size_t candidateIndex) const;
+
+  /** Waits until all the candidates have finished. */
+  void waitForCandidates();
+
+ private:
+  class CandidateReferenceManager;
+
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
+
+  /** Runs a candidate on the calling thread and updates its status when it is finished. */
+  void runCandidate(size_t candidateIndex, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                    std::chrono::steady_clock::time_point deadlineTime);
+
+  std::vector<std::unique_ptr<SolverBase>> solverPtrs_;
+  std::vector<std::shared_ptr<CandidateReferenceManager>> candidateReferenceManagerPtrs_;
+  std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
+  CandidateModifier candidateModifier_;
+  scalar_t deadline_;
+
+  size_t bestCandidateIndex_ = 0;
+
+  mutable std::mutex candidateMutex_;
+  std::condition_variable candidateFinishedCondition_;
+  std::vector<CandidateStatus> candidateStatus_;          // protected by candidateMutex_
+  std::vector<std::exception_ptr> candidateExceptions_;  // protected by candidateMutex_
+  std::vector<std::future<void>> candidateFutures_;
+
+  // one worker per candidate, destroyed first such that the running candidates finish before the other members are destroyed
+  std::vector<std::unique_ptr<ThreadPool>> candidateThreadPools_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,223 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+#include <ocs2_oc/oc_solver/PerformanceIndex.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+#include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
+
+#include "ocs2_mpc/CommandData.h"
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/MrtObserver.h"
+
+namespace ocs2 {
+namespace recording {
+
+/** The type of a record in a recording */
+enum class RecordType : uint8_t {
+  MpcInput = 0,   // the inputs of a solver run
+  MpcOutput = 1,  // the primal solution and the per-iteration performance of a solver run
+  MrtCommand = 2  // a policy as received by the MRT
+};
+
+/** The inputs of a solver run */
+struct MpcInputRecord {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 0.0;
+  vector_t initState;
+  TargetTrajectories targetTrajectories;
+  ModeSchedule modeSchedule;
+};
+
+/** The outputs of a solver run. The controller of the primal solution is not recorded. */
+struct MpcOutputRecord {
+  PrimalSolution primalSolution;
+  std::vector<PerformanceIndex> performanceIndices;
+};
+
+/** A policy as received by the MRT. The controller of the primal solution is not recorded. */
+struct MrtCommandRecord {
+  CommandData command;
+  PrimalSolution primalSolution;
+};
+
+/** A record read from a recording. Only the member matching the type is updated when reading. */
+struct Record {
+  RecordType type = RecordType::MpcInput;
+  MpcInputRecord mpcInput;
+  MpcOutputRecord mpcOutput;
+  MrtCommandRecord mrtCommand;
+};
+
+/**
+ * Appends records to a binary recording. Each record is serialized into a reused buffer and written with a single call to the file
+ * stream. The writer can be shared between the MPC and the MRT threads.
+ */
+class RecordWriter {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] fileName: The file of the recording. An existing file is overwritten.
+   */
+  explicit RecordWriter(const std::string& fileName);
+
+  /** Destructor, flushes the recording */
+  ~RecordWriter();
+
+  RecordWriter(const RecordWriter&) = delete;
+  RecordWriter& operator=(const RecordWriter&) = delete;
+
+  /** Appends the inputs of a solver run */
+  void writeMpcInput(scalar_t initTime, scalar_t finalTime, const vector_t& initState, const TargetTrajectories& targetTrajectories,
+                     const ModeSchedule& modeSchedule);
+
+  /** Appends the outputs of a solver run */
+  void writeMpcOutput(const PrimalSolution& primalSolution, const std::vector<PerformanceIndex>& performanceIndices);
+
+  /** Appends a policy as received by the MRT */
+  void writeMrtCommand(const CommandData& command, const PrimalSolution& primalSolution);
+
+  /** Flushes the file stream */
+  void flush();
+
+ private:
+  void writeBuffer(RecordType type);
+
+  std::mutex mutex_;
+  std::ofstream stream_;
+  std::vector<char> buffer_;
+};
+
+/**
+ * Reads the records of a binary recording. The file is memory-mapped and deserialized in place.
+ */
+class RecordReader {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] fileName: The file of the recording.
+   */
+  explicit RecordReader(const std::string& fileName);
+
+  /** Destructor, unmaps the file */
+  ~RecordReader();
+
+  RecordReader(const RecordReader&) = delete;
+  RecordReader& operator=(const RecordReader&) = delete;
+
+  /**
+   * Reads the next record. The memory of the record is reused.
+   *
+   * @param [out] record: The record. Only the member that matches record.type is updated.
+   * @return false if the end of the recording is reached.
+   */
+  bool readNext(Record& record);
+
+  /** Restarts reading from the first record */
+  void rewind();
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  size_t position_ = 0;
+};
+
+/**
+ * Records the inputs and the outputs of every run of a solver. Add it to the solver with SolverBase::addSynchronizedModule.
+ */
+class SolverRecorder final : public SolverSynchronizedModule {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] writerPtr: The writer of the recording.
+   * @param [in] solver: The solver this module is added to, used to record the per-iteration performance.
+   */
+  SolverRecorder(std::shared_ptr<RecordWriter> writerPtr, const SolverBase& solver) : writerPtr_(std::move(writerPtr)), solver_(solver) {}
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                    const ReferenceManagerInterface& referenceManager) override;
+
+  void postSolverRun(const PrimalSolution& primalSolution) override;
+
+ private:
+  std::shared_ptr<RecordWriter> writerPtr_;
+  const SolverBase& solver_;
+};
+
+/**
+ * Records every policy that the MRT loads into its buffer. Add it to the MRT with MRT_BASE::addMrtObserver.
+ */
+class MrtRecorder final : public MrtObserver {
+ public:
+  explicit MrtRecorder(std::shared_ptr<RecordWriter> writerPtr) : writerPtr_(std::move(writerPtr)) {}
+
+  void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) override;
+
+ private:
+  std::shared_ptr<RecordWriter> writerPtr_;
+};
+
+/** The samples of a replay, with one entry per replayed solver run */
+struct ReplaySamples {
+  std::vector<scalar_t> solveTimes;  // [ms]
+  std::vector<scalar_t> numIterations;
+  std::vector<scalar_t> replayedCost;
+  std::vector<scalar_t> recordedCost;  // NaN if the recording has no output for the run
+};
+
+/**
+ * Reruns the MPC on the recorded inputs. The recorded target trajectories and mode schedules are set to the solver's own reference
+ * manager in replay mode (see ReferenceManagerInterface::setReplayMode), such that they are not modified by the modules that generated
+ * them (e.g., a gait planner) while the state which depends on them (e.g., the swing trajectories read by the constraints) follows the
+ * recording. Afterwards, the replay mode is disabled and the references active before the replay are set again, also if the replay
+ * throws. The MPC is reset before the replay.
+ *
+ * @param [in] mpc: The MPC to run.
+ * @param [in] fileName: The file of the recording.
+ * @return The samples of the replay.
+ */
+ReplaySamples replayRecording(MPC_BASE& mpc, const std::string& fileName);
+
+}  // namespace recording
+}  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 
@@ -68,6 +69,14 @@ struct Settings {
    * set to a positive number which can be interpreted as the tracking controller's frequency.
    */
   scalar_t mrtDesiredFrequency_ = 100.0;
+
+  /**
+   * CPUs of the thread which runs the MPC loop, loaded from a CPU list (see parseCpuList). This thread also executes one of the
+   * solver's parallel tasks. An empty list does not pin the thread.
+   */
+  std::vector<int> mpcThreadAffinity_;
+  /** CPUs of the thread which runs the MRT (tracking controller) loop. An empty list does not pin the thread. */
+  std::vector<int> mrtThreadAffinity_;
 };
 
 /**
@@ -159,8 +159,15 @@ class MRT_BASE {
   void addMrtObserver(std::shared_ptr<MrtObserver> mrtObserver) { observerPtrArray_.push_back(std::move(mrtObserver)); };
 
  protected:
-  void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
-                    std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
+  /**
+   * Moves a new MPC policy to the buffer.
+   *
+   * @return The primal solution which was replaced in the buffer, or nullptr. It is not used by the MRT anymore, hence the caller may
+   * reuse its memory for the next policy.
+   */
+  std::unique_ptr<PrimalSolution> moveToBuffer(std::unique_ptr<CommandData> commandDataPtr,
+                                               std::unique_ptr<PrimalSolution> primalSolutionPtr,
+                                               std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
   /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_BatchService.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_BatchService::MPC_BatchService(size_t nThreads, int threadPriority)
+    : nThreads_(std::max(nThreads, size_t(1))), threadPool_(nThreads_ - 1, threadPriority) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MPC_BatchService::addInstance(MPC_BASE& mpc, scalar_t deadline) {
+  std::unique_ptr<MPC_MRT_Interface> mpcMrtInterfacePtr(new MPC_MRT_Interface(mpc));
+  const size_t instanceId = addInstance(*mpcMrtInterfacePtr, deadline);
+  instances_[instanceId].ownedMpcMrtInterfacePtr = std::move(mpcMrtInterfacePtr);
+  return instanceId;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MPC_BatchService::addInstance(MPC_MRT_Interface& mpcMrtInterface, scalar_t deadline) {
+  instances_.push_back(Instance{&mpcMrtInterface, nullptr, deadline, Status()});
+  return instances_.size() - 1;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BatchService::setCurrentObservation(size_t instanceId, const SystemObservation& observation) {
+  instances_.at(instanceId).mpcMrtInterfacePtr->setCurrentObservation(observation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BatchService::advanceMpc() {
+  using clock = std::chrono::steady_clock;
+  const auto startTime = clock::now();
+  const auto elapsedTime = [&startTime]() { return std::chrono::duration<scalar_t>(clock::now() - startTime).count(); };
+
+  // earliest deadline first
+  schedule_.resize(instances_.size());
+  std::iota(schedule_.begin(), schedule_.end(), 0);
+  std::stable_sort(schedule_.begin(), schedule_.end(),
+                   [this](size_t a, size_t b) { return instances_[a].deadline < instances_[b].deadline; });
+
+  std::atomic_size_t scheduleIndex{0};
+  auto task = [&](int) {
+    size_t i = scheduleIndex++;
+    while (i < schedule_.size()) {
+      auto& instance = instances_[schedule_[i]];
+      instance.status = Status();
+
+      const scalar_t dispatchTime = elapsedTime();
+      if (dispatchTime > instance.deadline) {
+        instance.status.isSkipped = true;
+        instance.status.isDeadlineMissed = true;
+      } else {
+        instance.mpcMrtInterfacePtr->advanceMpc();
+        const scalar_t finishTime = elapsedTime();
+        instance.status.solveTime = finishTime - dispatchTime;
+        instance.status.isDeadlineMissed = finishTime > instance.deadline;
+      }
+
+      i = scheduleIndex++;
+    }
+  };
+  threadPool_.runParallel(std::move(task), std::min(nThreads_, instances_.size()));
+}
+
+}  // namespace ocs2
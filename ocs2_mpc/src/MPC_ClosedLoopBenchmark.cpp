@@ -0,0 +1,396 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_ClosedLoopBenchmark.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/misc/LoadData.h>
+
+#include "ocs2_mpc/MPC_MRT_Interface.h"
+
+namespace ocs2 {
+namespace benchmark {
+
+namespace {
+
+/** Adds uniformly distributed noise in [-amplitude, amplitude] to a vector. An empty amplitude adds no noise. */
+vector_t addUniformNoise(const vector_t& v, const vector_t& amplitude, std::mt19937& generator) {
+  if (amplitude.size() == 0) {
+    return v;
+  }
+  std::uniform_real_distribution<scalar_t> distribution(-1.0, 1.0);
+  vector_t noisy = v;
+  for (int i = 0; i < v.size(); i++) {
+    noisy(i) += amplitude(i) * distribution(generator);
+  }
+  return noisy;
+}
+
+/** Checks a statistic against its threshold and reports it if it is exceeded. A NaN statistic exceeds any threshold. */
+bool checkThreshold(std::ostream& stream, const std::string& name, scalar_t value, scalar_t threshold) {
+  if (!(value <= threshold)) {
+    stream << "[benchmark] " << name << " = " << value << " exceeds the threshold " << threshold << "\n";
+    return false;
+  }
+  return true;
+}
+
+/** Gets the mean of a sample set, or zero if it is empty. */
+scalar_t mean(const std::vector<scalar_t>& samples) {
+  return samples.empty() ? 0.0 : std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<scalar_t>(samples.size());
+}
+
+/** Gets the p-th percentile of a sorted non-empty sample set, with p in (0, 1]. */
+scalar_t percentile(const std::vector<scalar_t>& sortedSamples, scalar_t p) {
+  const auto index = static_cast<size_t>(std::ceil(p * static_cast<scalar_t>(sortedSamples.size()))) - 1;
+  return sortedSamples[std::min(index, sortedSamples.size() - 1)];
+}
+
+/** Escapes a string such that it can be written as a JSON string. */
+std::string escapeJson(const std::string& text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (const char c : text) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      case '\t':
+        escaped += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char code[7];
+          std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(c));
+          escaped += code;
+        } else {
+          escaped += c;
+        }
+    }
+  }
+  return escaped;
+}
+
+/** Parses a non-negative integer command line argument. Returns false if the whole argument is not a number in [0, maxValue]. */
+bool parseUnsigned(const char* text, unsigned long maxValue, unsigned long& value) {
+  // strtoul accepts a sign, which wraps negative numbers around
+  if (*text < '0' || *text > '9') {
+    return false;
+  }
+  char* end = nullptr;
+  errno = 0;
+  value = std::strtoul(text, &end, 10);
+  return errno == 0 && *end == '\0' && value <= maxValue;
+}
+
+/**
+ * Writes the distribution of a sample set as a JSON object. JSON has no representation of NaN and inf, hence the non-finite samples
+ * are only counted, and a statistic which overflows is written as null.
+ */
+void writeDistribution(std::ostream& stream, const std::string& name, std::vector<scalar_t> samples) {
+  const auto finiteEnd = std::partition(samples.begin(), samples.end(), [](scalar_t s) { return std::isfinite(s); });
+  const auto numNonFinite = std::distance(finiteEnd, samples.end());
+  samples.erase(finiteEnd, samples.end());
+
+  stream << "    \"" << name << "\": {\"numNonFinite\": " << numNonFinite;
+  if (samples.empty()) {
+    stream << "}";
+    return;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  const scalar_t mu = mean(samples);
+  const scalar_t variance =
+      std::accumulate(samples.begin(), samples.end(), 0.0, [mu](scalar_t sum, scalar_t s) { return sum + (s - mu) * (s - mu); }) /
+      static_cast<scalar_t>(samples.size());
+
+  // the moments of huge finite samples may still overflow
+  const auto writeNumber = [&](const char* key, scalar_t value) {
+    stream << ", \"" << key << "\": ";
+    if (std::isfinite(value)) {
+      stream << value;
+    } else {
+      stream << "null";
+    }
+  };
+  writeNumber("mean", mu);
+  writeNumber("std", std::sqrt(variance));
+  writeNumber("min", samples.front());
+  writeNumber("median", percentile(samples, 0.5));
+  writeNumber("p90", percentile(samples, 0.9));
+  writeNumber("p99", percentile(samples, 0.99));
+  writeNumber("max", samples.back());
+  stream << "}";
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ClosedLoopSamples runClosedLoopBenchmark(const ClosedLoopProblem& problem, const ClosedLoopSettings& settings) {
+  auto& mpc = problem.mpc;
+  std::mt19937 generator(settings.seed);
+  const scalar_t timeStep = 1.0 / settings.mpcFrequency;
+  const auto numCalls = static_cast<size_t>(std::ceil(settings.duration * settings.mpcFrequency));
+
+  if (problem.initStateNoise.size() > 0 && problem.initStateNoise.size() != problem.initState.size()) {
+    throw std::runtime_error("[runClosedLoopBenchmark] initStateNoise has size " + std::to_string(problem.initStateNoise.size()) +
+                             ", but the initial state has size " + std::to_string(problem.initState.size()) + "!");
+  }
+  if (problem.targetStateNoise.size() > 0) {
+    for (const auto& state : problem.targetTrajectories.stateTrajectory) {
+      if (problem.targetStateNoise.size() != state.size()) {
+        throw std::runtime_error("[runClosedLoopBenchmark] targetStateNoise has size " + std::to_string(problem.targetStateNoise.size()) +
+                                 ", but a target state has size " + std::to_string(state.size()) + "!");
+      }
+    }
+  }
+
+  ClosedLoopSamples samples;
+  samples.solveTimes.reserve(settings.numTrials * numCalls);
+
+  for (size_t trial = 0; trial < settings.numTrials; trial++) {
+    if (problem.resetTrial) {
+      problem.resetTrial();
+    }
+
+    // randomized target
+    TargetTrajectories target = problem.targetTrajectories;
+    if (problem.targetStateNoise.size() > 0) {
+      const vector_t targetOffset =
+          addUniformNoise(vector_t::Zero(problem.targetStateNoise.size()), problem.targetStateNoise, generator);
+      for (auto& state : target.stateTrajectory) {
+        state += targetOffset;
+      }
+    }
+
+    MPC_MRT_Interface mpcMrtInterface(mpc);
+    mpcMrtInterface.initRollout(&problem.rollout);
+    mpcMrtInterface.resetMpcNode(target);
+
+    // randomized initial state
+    SystemObservation observation;
+    observation.time = target.timeTrajectory.front();
+    observation.state = addUniformNoise(problem.initState, problem.initStateNoise, generator);
+    observation.input = target.inputTrajectory.front();
+
+    for (size_t i = 0; i < numCalls; i++) {
+      mpcMrtInterface.setCurrentObservation(observation);
+
+      const size_t numIterations = mpc.getSolverPtr()->getNumIterations();
+      const auto startTime = std::chrono::steady_clock::now();
+      mpcMrtInterface.advanceMpc();
+      const auto endTime = std::chrono::steady_clock::now();
+
+      const auto& performance = mpc.getSolverPtr()->getPerformanceIndeces();
+      samples.solveTimes.push_back(std::chrono::duration<scalar_t, std::milli>(endTime - startTime).count());
+      samples.numIterations.push_back(static_cast<scalar_t>(mpc.getSolverPtr()->getNumIterations() - numIterations));
+      samples.cost.push_back(performance.cost);
+      samples.dynamicsViolationSSE.push_back(performance.dynamicsViolationSSE);
+      samples.equalityConstraintsSSE.push_back(performance.equalityConstraintsSSE);
+      samples.inequalityLagrangian.push_back(performance.inequalityLagrangian);
+
+      // simulate the plant with the latest policy
+      mpcMrtInterface.updatePolicy();
+      vector_t nextState, nextInput;
+      size_t mode;
+      mpcMrtInterface.rolloutPolicy(observation.time, observation.state, timeStep, nextState, nextInput, mode);
+      observation.time += timeStep;
+      observation.state = std::move(nextState);
+      observation.input = std::move(nextInput);
+      observation.mode = mode;
+    }
+
+    const vector_t finalTargetState = target.getDesiredState(observation.time);
+    if (finalTargetState.size() == observation.state.size()) {
+      samples.finalTrackingError.push_back((observation.state - finalTargetState).norm());
+    }
+  }
+
+  return samples;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeJson(std::ostream& stream, const std::string& name, const ClosedLoopSettings& settings, const ClosedLoopSamples& samples) {
+  stream << "{\n";
+  stream << "  \"name\": \"" << escapeJson(name) << "\",\n";
+  stream << "  \"settings\": {\"numTrials\": " << settings.numTrials << ", \"duration\": " << settings.duration
+         << ", \"mpcFrequency\": " << settings.mpcFrequency << ", \"seed\": " << settings.seed << "},\n";
+  stream << "  \"numMpcCalls\": " << samples.solveTimes.size() << ",\n";
+  stream << "  \"statistics\": {\n";
+  writeDistribution(stream, "solveTime_ms", samples.solveTimes);
+  stream << ",\n";
+  writeDistribution(stream, "numIterations", samples.numIterations);
+  stream << ",\n";
+  writeDistribution(stream, "cost", samples.cost);
+  stream << ",\n";
+  writeDistribution(stream, "dynamicsViolationSSE", samples.dynamicsViolationSSE);
+  stream << ",\n";
+  writeDistribution(stream, "equalityConstraintsSSE", samples.equalityConstraintsSSE);
+  stream << ",\n";
+  writeDistribution(stream, "inequalityLagrangian", samples.inequalityLagrangian);
+  stream << ",\n";
+  writeDistribution(stream, "finalTrackingError", samples.finalTrackingError);
+  stream << "\n  }\n";
+  stream << "}\n";
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RegressionThresholds loadRegressionThresholds(const std::string& filename, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(filename, pt);
+
+  RegressionThresholds thresholds;
+
+  if (verbose) {
+    std::cerr << "\n #### Benchmark Regression Thresholds:";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  loadData::loadPtreeValue(pt, thresholds.solveTimeP90, fieldName + ".solveTimeP90", verbose);
+  loadData::loadPtreeValue(pt, thresholds.numIterationsMean, fieldName + ".numIterationsMean", verbose);
+  loadData::loadPtreeValue(pt, thresholds.finalTrackingErrorMean, fieldName + ".finalTrackingErrorMean", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return thresholds;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool checkRegressionThresholds(std::ostream& stream, const RegressionThresholds& thresholds, const ClosedLoopSamples& samples) {
+  bool isPassed = true;
+  if (!samples.solveTimes.empty()) {
+    auto sortedSolveTimes = samples.solveTimes;
+    std::sort(sortedSolveTimes.begin(), sortedSolveTimes.end());
+    isPassed &= checkThreshold(stream, "solveTimeP90", percentile(sortedSolveTimes, 0.9), thresholds.solveTimeP90);
+  }
+  isPassed &= checkThreshold(stream, "numIterationsMean", mean(samples.numIterations), thresholds.numIterationsMean);
+  isPassed &= checkThreshold(stream, "finalTrackingErrorMean", mean(samples.finalTrackingError), thresholds.finalTrackingErrorMean);
+  return isPassed;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int benchmarkMain(int argc, char** argv, const std::string& name, const ClosedLoopProblem& problem) {
+  ClosedLoopSettings settings;
+  if (problem.mpc.settings().mpcDesiredFrequency_ > 0.0) {
+    settings.mpcFrequency = problem.mpc.settings().mpcDesiredFrequency_;
+  }
+
+  std::string outputFile;
+  std::string thresholdsFile;
+  for (int i = 1; i < argc; i++) {
+    const bool hasValue = i + 1 < argc;
+    unsigned long number = 0;
+    bool isValid = hasValue;
+    if (hasValue && std::strcmp(argv[i], "--output") == 0) {
+      outputFile = argv[++i];
+    } else if (hasValue && std::strcmp(argv[i], "--thresholds") == 0) {
+      thresholdsFile = argv[++i];
+    } else if (hasValue && std::strcmp(argv[i], "--trials") == 0) {
+      isValid = parseUnsigned(argv[++i], std::numeric_limits<size_t>::max(), number);
+      settings.numTrials = number;
+    } else if (hasValue && std::strcmp(argv[i], "--seed") == 0) {
+      isValid = parseUnsigned(argv[++i], std::numeric_limits<unsigned int>::max(), number);
+      settings.seed = static_cast<unsigned int>(number);
+    } else {
+      isValid = false;
+    }
+
+    if (!isValid) {
+      std::cerr << "Invalid argument: " << argv[i] << "\n";
+      std::cerr << "Usage: " << argv[0] << " [--output <file.json>] [--thresholds <file.info>] [--trials <number>] [--seed <number>]\n";
+      return 2;
+    }
+  }
+
+  // open the output file before the benchmark runs, such that a bad path fails early
+  std::ofstream file;
+  if (!outputFile.empty()) {
+    file.open(outputFile);
+    if (!file.is_open()) {
+      std::cerr << "[benchmark] Cannot open the output file " << outputFile << "\n";
+      return 2;
+    }
+  }
+
+  const auto samples = runClosedLoopBenchmark(problem, settings);
+
+  if (outputFile.empty()) {
+    writeJson(std::cout, name, settings, samples);
+  } else {
+    writeJson(file, name, settings, samples);
+    file.close();
+    if (file.fail()) {
+      std::cerr << "[benchmark] Cannot write the output file " << outputFile << "\n";
+      return 2;
+    }
+  }
+
+  if (!thresholdsFile.empty() && !checkRegressionThresholds(std::cerr, loadRegressionThresholds(thresholdsFile), samples)) {
+    std::cerr << "[benchmark] " << name << " has regressed!\n";
+    return 1;
+  }
+
+  return 0;
+}
+
+}  // namespace benchmark
+}  // namespace ocs2
@@ -116,8 +116,11 @@ void MPC_MRT_Interface::advanceMpc() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
-  // policy
-  std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+  // policy, sliced into the solution which the previous call got back from the buffer such that its memory is reused
+  std::unique_ptr<PrimalSolution> primalSolutionPtr = std::move(sparePrimalSolutionPtr_);
+  if (primalSolutionPtr == nullptr) {
+    primalSolutionPtr.reset(new PrimalSolution);
+  }
   const scalar_t startTime = mpcInitObservation.time;
   const scalar_t finalTime =
       (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
@@ -132,7 +135,7 @@ void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation
   std::unique_ptr<PerformanceIndex> performanceIndicesPtr(new PerformanceIndex);
   *performanceIndicesPtr = mpc_.getSolverPtr()->getPerformanceIndeces();
 
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  sparePrimalSolutionPtr_ = this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,280 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_MultiStart.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+namespace ocs2 {
+
+/**
+ * The ReferenceManager of a candidate. The references are set to the shared ReferenceManager. Before the candidate is launched, it gets
+ * a copy of the active shared references, such that a running candidate never reads the shared ReferenceManager, and it applies its
+ * CandidateModifier on them at the start of its run.
+ */
+class MPC_MultiStart::CandidateReferenceManager final : public ReferenceManagerInterface {
+ public:
+  CandidateReferenceManager(const MPC_MultiStart& multiStartMpc, size_t candidateIndex)
+      : multiStartMpc_(multiStartMpc), candidateIndex_(candidateIndex) {}
+
+  ~CandidateReferenceManager() override = default;
+
+  void setActiveReferences(const ReferenceManagerInterface& sharedReferenceManager, CandidateModifier candidateModifier) {
+    modeSchedule_ = sharedReferenceManager.getModeSchedule();
+    targetTrajectories_ = sharedReferenceManager.getTargetTrajectories();
+    candidateModifier_ = std::move(candidateModifier);
+  }
+
+  void preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) override {
+    if (candidateModifier_) {
+      candidateModifier_(candidateIndex_, initTime, finalTime, initState, targetTrajectories_, modeSchedule_);
+    }
+  }
+
+  const ModeSchedule& getModeSchedule() const override { return modeSchedule_; }
+  void setModeSchedule(const ModeSchedule& modeSchedule) override { multiStartMpc_.referenceManagerPtr_->setModeSchedule(modeSchedule); }
+  void setModeSchedule(ModeSchedule&& modeSchedule) override {
+    multiStartMpc_.referenceManagerPtr_->setModeSchedule(std::move(modeSchedule));
+  }
+
+  const TargetTrajectories& getTargetTrajectories() const override { return targetTrajectories_; }
+  void setTargetTrajectories(const TargetTrajectories& targetTrajectories) override {
+    multiStartMpc_.referenceManagerPtr_->setTargetTrajectories(targetTrajectories);
+  }
+  void setTargetTrajectories(TargetTrajectories&& targetTrajectories) override {
+    multiStartMpc_.referenceManagerPtr_->setTargetTrajectories(std::move(targetTrajectories));
+  }
+
+ private:
+  const MPC_MultiStart& multiStartMpc_;
+  const size_t candidateIndex_;
+  ModeSchedule modeSchedule_;
+  TargetTrajectories targetTrajectories_;
+  CandidateModifier candidateModifier_;
+};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_MultiStart::MPC_MultiStart(mpc::Settings mpcSettings, std::vector<std::unique_ptr<SolverBase>> solverPtrs, scalar_t deadline,
+                               int threadPriority, const std::vector<std::vector<int>>& candidateCpus)
+    : MPC_BASE(std::move(mpcSettings)),
+      solverPtrs_(std::move(solverPtrs)),
+      referenceManagerPtr_(new ReferenceManager),
+      deadline_(deadline),
+      candidateStatus_(solverPtrs_.size()),
+      candidateExceptions_(solverPtrs_.size()),
+      candidateFutures_(solverPtrs_.size()) {
+  if (solverPtrs_.empty()) {
+    throw std::runtime_error("[MPC_MultiStart] At least one candidate solver is required!");
+  }
+  if (!candidateCpus.empty() && candidateCpus.size() != solverPtrs_.size()) {
+    throw std::runtime_error("[MPC_MultiStart] candidateCpus should either be empty or have one entry per candidate!");
+  }
+
+  if (deadline_ <= 0.0) {
+    deadline_ = (settings().mpcDesiredFrequency_ > 0.0) ? 1.0 / settings().mpcDesiredFrequency_ : std::numeric_limits<scalar_t>::infinity();
+  }
+
+  candidateReferenceManagerPtrs_.reserve(solverPtrs_.size());
+  candidateThreadPools_.reserve(solverPtrs_.size());
+  for (size_t i = 0; i < solverPtrs_.size(); i++) {
+    if (solverPtrs_[i] == nullptr) {
+      throw std::runtime_error("[MPC_MultiStart] The candidate solver pointers cannot be nullptr!");
+    }
+    candidateReferenceManagerPtrs_.emplace_back(new CandidateReferenceManager(*this, i));
+    solverPtrs_[i]->setReferenceManager(candidateReferenceManagerPtrs_.back());
+    candidateThreadPools_.emplace_back(new ThreadPool(1, threadPriority, candidateCpus.empty() ? std::vector<int>() : candidateCpus[i]));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_MultiStart::~MPC_MultiStart() {
+  waitForCandidates();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::reset() {
+  waitForCandidates();
+  MPC_BASE::reset();
+  for (auto& solverPtr : solverPtrs_) {
+    solverPtr->reset();
+  }
+  bestCandidateIndex_ = 0;
+  std::fill(candidateStatus_.begin(), candidateStatus_.end(), CandidateStatus());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::setReferenceManager(std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr) {
+  if (referenceManagerPtr == nullptr) {
+    throw std::runtime_error("[MPC_MultiStart] ReferenceManager pointer cannot be a nullptr!");
+  }
+  referenceManagerPtr_ = std::move(referenceManagerPtr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto MPC_MultiStart::getCandidateStatus(size_t candidateIndex) const -> CandidateStatus {
+  std::lock_guard<std::mutex> lock(candidateMutex_);
+  return candidateStatus_.at(candidateIndex);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::waitForCandidates() {
+  for (auto& future : candidateFutures_) {
+    if (future.valid()) {
+      future.get();
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::runCandidate(size_t candidateIndex, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                  std::chrono::steady_clock::time_point deadlineTime) {
+  using clock = std::chrono::steady_clock;
+  const auto dispatchTime = clock::now();
+
+  std::exception_ptr exception;
+  try {
+    if (settings().coldStart_) {
+      solverPtrs_[candidateIndex]->reset();
+    }
+    solverPtrs_[candidateIndex]->run(initTime, initState, finalTime);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  const auto finishTime = clock::now();
+  {
+    std::lock_guard<std::mutex> lock(candidateMutex_);
+    auto& status = candidateStatus_[candidateIndex];
+    status.isRunning = false;
+    status.isFailed = (exception != nullptr);
+    status.isDeadlineMissed = finishTime > deadlineTime;
+    status.solveTime = std::chrono::duration<scalar_t>(finishTime - dispatchTime).count();
+    candidateExceptions_[candidateIndex] = std::move(exception);
+  }
+  candidateFinishedCondition_.notify_all();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_MultiStart::calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  using clock = std::chrono::steady_clock;
+  const bool hasDeadline = std::isfinite(deadline_);
+  const auto deadlineDuration = hasDeadline ? std::chrono::duration<scalar_t>(deadline_) : std::chrono::duration<scalar_t>(0.0);
+  const auto deadlineTime = clock::now() + std::chrono::duration_cast<clock::duration>(deadlineDuration);
+
+  // the shared references are updated once for all the candidates
+  referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
+
+  std::unique_lock<std::mutex> lock(candidateMutex_);
+  const auto isAnyIdle = [this]() {
+    return std::any_of(candidateStatus_.cbegin(), candidateStatus_.cend(), [](const CandidateStatus& s) { return !s.isRunning; });
+  };
+  // all the candidates are still running from the previous iterations: wait for one to become available
+  candidateFinishedCondition_.wait(lock, isAnyIdle);
+
+  // launch the idle candidates, the running ones are left to finish in the background
+  std::vector<size_t> launchedCandidates;
+  launchedCandidates.reserve(solverPtrs_.size());
+  for (size_t i = 0; i < solverPtrs_.size(); i++) {
+    if (candidateStatus_[i].isRunning) {
+      continue;
+    }
+    if (candidateFutures_[i].valid()) {
+      candidateFutures_[i].get();
+    }
+    candidateStatus_[i] = CandidateStatus();
+    candidateStatus_[i].isRunning = true;
+    candidateExceptions_[i] = nullptr;
+    candidateReferenceManagerPtrs_[i]->setActiveReferences(*referenceManagerPtr_, candidateModifier_);
+    candidateFutures_[i] = candidateThreadPools_[i]->run(
+        [this, i, initTime, initState, finalTime, deadlineTime](int) { runCandidate(i, initTime, initState, finalTime, deadlineTime); });
+    launchedCandidates.push_back(i);
+  }
+
+  // wait until all the launched candidates finish or the deadline passes
+  const auto isAllFinished = [&]() {
+    return std::none_of(launchedCandidates.cbegin(), launchedCandidates.cend(), [this](size_t i) { return candidateStatus_[i].isRunning; });
+  };
+  if (hasDeadline) {
+    candidateFinishedCondition_.wait_until(lock, deadlineTime, isAllFinished);
+  } else {
+    candidateFinishedCondition_.wait(lock, isAllFinished);
+  }
+
+  // if no candidate has succeeded by the deadline, wait for the first one to succeed
+  const auto isSucceeded = [this](size_t i) { return !candidateStatus_[i].isRunning && !candidateStatus_[i].isFailed; };
+  candidateFinishedCondition_.wait(lock, [&]() {
+    return isAllFinished() || std::any_of(launchedCandidates.cbegin(), launchedCandidates.cend(), isSucceeded);
+  });
+
+  // select the finished candidate with the lowest merit, preferring the ones which finished in time
+  constexpr auto inf = std::numeric_limits<scalar_t>::infinity();
+  auto bestIndex = solverPtrs_.size();
+  bool bestIsInTime = false;
+  scalar_t bestMerit = inf;
+  for (const auto i : launchedCandidates) {
+    if (!isSucceeded(i)) {
+      continue;
+    }
+    const bool isInTime = !candidateStatus_[i].isDeadlineMissed;
+    const scalar_t merit = solverPtrs_[i]->getPerformanceIndeces().merit;
+    const bool isBetter =
+        (bestIndex == solverPtrs_.size()) || (isInTime && !bestIsInTime) || (isInTime == bestIsInTime && merit < bestMerit);
+    if (isBetter) {
+      bestIndex = i;
+      bestIsInTime = isInTime;
+      bestMerit = merit;
+    }
+  }
+
+  if (bestIndex == solverPtrs_.size()) {
+    std::rethrow_exception(candidateExceptions_[launchedCandidates.front()]);
+  }
+  bestCandidateIndex_ = bestIndex;
+}
+
+}  // namespace ocs2
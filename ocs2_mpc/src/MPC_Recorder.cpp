@@ -0,0 +1,444 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_Recorder.h"
+
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ocs2 {
+namespace recording {
+
+namespace {
+
+constexpr char fileMagic[8] = {'O', 'C', 'S', '2', 'R', 'E', 'C', '1'};
+
+// Each record starts with its type and the size of its payload
+constexpr size_t recordHeaderSize = sizeof(uint8_t) + sizeof(uint64_t);
+
+/** Serialization of the recorded types into a byte buffer */
+template <typename T>
+void writePod(std::vector<char>& buffer, const T& value) {
+  const auto* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void writeVector(std::vector<char>& buffer, const vector_t& v) {
+  writePod(buffer, static_cast<uint64_t>(v.size()));
+  const auto* bytes = reinterpret_cast<const char*>(v.data());
+  buffer.insert(buffer.end(), bytes, bytes + v.size() * sizeof(scalar_t));
+}
+
+template <typename T>
+void writePodArray(std::vector<char>& buffer, const std::vector<T>& array) {
+  static_assert(std::is_trivially_copyable<T>::value, "Only arrays of trivially copyable types can be written as bytes.");
+  writePod(buffer, static_cast<uint64_t>(array.size()));
+  const auto* bytes = reinterpret_cast<const char*>(array.data());
+  buffer.insert(buffer.end(), bytes, bytes + array.size() * sizeof(T));
+}
+
+void writeVectorArray(std::vector<char>& buffer, const vector_array_t& array) {
+  writePod(buffer, static_cast<uint64_t>(array.size()));
+  for (const auto& v : array) {
+    writeVector(buffer, v);
+  }
+}
+
+void writeModeSchedule(std::vector<char>& buffer, const ModeSchedule& modeSchedule) {
+  writePodArray(buffer, modeSchedule.eventTimes);
+  writePodArray(buffer, modeSchedule.modeSequence);
+}
+
+void writeTargetTrajectories(std::vector<char>& buffer, const TargetTrajectories& targetTrajectories) {
+  writePodArray(buffer, targetTrajectories.timeTrajectory);
+  writeVectorArray(buffer, targetTrajectories.stateTrajectory);
+  writeVectorArray(buffer, targetTrajectories.inputTrajectory);
+}
+
+void writePrimalSolution(std::vector<char>& buffer, const PrimalSolution& primalSolution) {
+  writePodArray(buffer, primalSolution.timeTrajectory_);
+  writeVectorArray(buffer, primalSolution.stateTrajectory_);
+  writeVectorArray(buffer, primalSolution.inputTrajectory_);
+  writePodArray(buffer, primalSolution.postEventIndices_);
+  writeModeSchedule(buffer, primalSolution.modeSchedule_);
+}
+
+/** Deserialization from a memory range, the read values reuse the memory of the outputs */
+class ByteReader {
+ public:
+  ByteReader(const char* begin, const char* end) : current_(begin), end_(end) {}
+
+  template <typename T>
+  void readPod(T& value) {
+    readBytes(&value, sizeof(T));
+  }
+
+  void readVector(vector_t& v) {
+    uint64_t size;
+    readPod(size);
+    v.resize(size);
+    readBytes(v.data(), size * sizeof(scalar_t));
+  }
+
+  template <typename T>
+  void readPodArray(std::vector<T>& array) {
+    uint64_t size;
+    readPod(size);
+    array.resize(size);
+    readBytes(array.data(), size * sizeof(T));
+  }
+
+  void readVectorArray(vector_array_t& array) {
+    uint64_t size;
+    readPod(size);
+    array.resize(size);
+    for (auto& v : array) {
+      readVector(v);
+    }
+  }
+
+  void readModeSchedule(ModeSchedule& modeSchedule) {
+    readPodArray(modeSchedule.eventTimes);
+    readPodArray(modeSchedule.modeSequence);
+  }
+
+  void readTargetTrajectories(TargetTrajectories& targetTrajectories) {
+    readPodArray(targetTrajectories.timeTrajectory);
+    readVectorArray(targetTrajectories.stateTrajectory);
+    readVectorArray(targetTrajectories.inputTrajectory);
+  }
+
+  void readPrimalSolution(PrimalSolution& primalSolution) {
+    readPodArray(primalSolution.timeTrajectory_);
+    readVectorArray(primalSolution.stateTrajectory_);
+    readVectorArray(primalSolution.inputTrajectory_);
+    readPodArray(primalSolution.postEventIndices_);
+    readModeSchedule(primalSolution.modeSchedule_);
+    primalSolution.controllerPtr_.reset();
+  }
+
+ private:
+  void readBytes(void* destination, size_t numBytes) {
+    if (static_cast<size_t>(end_ - current_) < numBytes) {
+      throw std::runtime_error("[RecordReader] The recording is truncated or corrupted.");
+    }
+    if (numBytes > 0) {
+      std::memcpy(destination, current_, numBytes);
+    }
+    current_ += numBytes;
+  }
+
+  const char* current_;
+  const char* end_;
+};
+
+/**
+ * Sets a reference manager to replay mode and restores it on destruction: the replay mode is disabled and the references which were
+ * active before the replay are set again.
+ */
+class ReplayModeGuard {
+ public:
+  explicit ReplayModeGuard(ReferenceManagerInterface& referenceManager)
+      : referenceManager_(referenceManager),
+        targetTrajectories_(referenceManager.getTargetTrajectories()),
+        modeSchedule_(referenceManager.getModeSchedule()) {
+    referenceManager_.setReplayMode(true);
+  }
+  ~ReplayModeGuard() {
+    referenceManager_.setReplayMode(false);
+    referenceManager_.setTargetTrajectories(std::move(targetTrajectories_));
+    referenceManager_.setModeSchedule(std::move(modeSchedule_));
+  }
+
+  ReplayModeGuard(const ReplayModeGuard&) = delete;
+  ReplayModeGuard& operator=(const ReplayModeGuard&) = delete;
+
+ private:
+  ReferenceManagerInterface& referenceManager_;
+  TargetTrajectories targetTrajectories_;
+  ModeSchedule modeSchedule_;
+};
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RecordWriter::RecordWriter(const std::string& fileName) : stream_(fileName, std::ios::binary | std::ios::trunc) {
+  if (!stream_.is_open()) {
+    throw std::runtime_error("[RecordWriter] Could not open " + fileName);
+  }
+  stream_.write(fileMagic, sizeof(fileMagic));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RecordWriter::~RecordWriter() {
+  flush();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RecordWriter::writeMpcInput(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                 const TargetTrajectories& targetTrajectories, const ModeSchedule& modeSchedule) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer_.resize(recordHeaderSize);
+  writePod(buffer_, initTime);
+  writePod(buffer_, finalTime);
+  writeVector(buffer_, initState);
+  writeTargetTrajectories(buffer_, targetTrajectories);
+  writeModeSchedule(buffer_, modeSchedule);
+  writeBuffer(RecordType::MpcInput);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RecordWriter::writeMpcOutput(const PrimalSolution& primalSolution, const std::vector<PerformanceIndex>& performanceIndices) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer_.resize(recordHeaderSize);
+  writePrimalSolution(buffer_, primalSolution);
+  writePodArray(buffer_, performanceIndices);
+  writeBuffer(RecordType::MpcOutput);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RecordWriter::writeMrtCommand(const CommandData& command, const PrimalSolution& primalSolution) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffer_.resize(recordHeaderSize);
+  const auto& observation = command.mpcInitObservation_;
+  writePod(buffer_, static_cast<uint64_t>(observation.mode));
+  writePod(buffer_, observation.time);
+  writeVector(buffer_, observation.state);
+  writeVector(buffer_, observation.input);
+  writeTargetTrajectories(buffer_, command.mpcTargetTrajectories_);
+  writePrimalSolution(buffer_, primalSolution);
+  writeBuffer(RecordType::MrtCommand);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RecordWriter::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stream_.flush();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RecordWriter::writeBuffer(RecordType type) {
+  // fill in the header that was reserved at the front of the buffer
+  const auto typeByte = static_cast<uint8_t>(type);
+  const auto payloadSize = static_cast<uint64_t>(buffer_.size() - recordHeaderSize);
+  std::memcpy(buffer_.data(), &typeByte, sizeof(uint8_t));
+  std::memcpy(buffer_.data() + sizeof(uint8_t), &payloadSize, sizeof(uint64_t));
+  stream_.write(buffer_.data(), buffer_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RecordReader::RecordReader(const std::string& fileName) {
+  const int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+  if (fileDescriptor < 0) {
+    throw std::runtime_error("[RecordReader] Could not open " + fileName);
+  }
+
+  struct stat fileStatus;
+  if (::fstat(fileDescriptor, &fileStatus) != 0 || static_cast<size_t>(fileStatus.st_size) < sizeof(fileMagic)) {
+    ::close(fileDescriptor);
+    throw std::runtime_error("[RecordReader] " + fileName + " is not a recording.");
+  }
+  size_ = static_cast<size_t>(fileStatus.st_size);
+
+  void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  ::close(fileDescriptor);  // the mapping stays valid after closing the file
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("[RecordReader] Could not map " + fileName);
+  }
+  data_ = static_cast<const char*>(mapping);
+
+  if (std::memcmp(data_, fileMagic, sizeof(fileMagic)) != 0) {
+    ::munmap(const_cast<char*>(data_), size_);
+    throw std::runtime_error("[RecordReader] " + fileName + " is not a recording.");
+  }
+  rewind();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+RecordReader::~RecordReader() {
+  ::munmap(const_cast<char*>(data_), size_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RecordReader::rewind() {
+  position_ = sizeof(fileMagic);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool RecordReader::readNext(Record& record) {
+  // A partially written record at the end is ignored, e.g. if the recording process was killed
+  if (size_ - position_ < recordHeaderSize) {
+    return false;
+  }
+  uint8_t typeByte;
+  uint64_t payloadSize;
+  std::memcpy(&typeByte, data_ + position_, sizeof(uint8_t));
+  std::memcpy(&payloadSize, data_ + position_ + sizeof(uint8_t), sizeof(uint64_t));
+  if (size_ - position_ - recordHeaderSize < payloadSize) {
+    return false;
+  }
+
+  const char* payloadBegin = data_ + position_ + recordHeaderSize;
+  ByteReader reader(payloadBegin, payloadBegin + payloadSize);
+  position_ += recordHeaderSize + payloadSize;
+
+  record.type = static_cast<RecordType>(typeByte);
+  switch (record.type) {
+    case RecordType::MpcInput: {
+      auto& mpcInput = record.mpcInput;
+      reader.readPod(mpcInput.initTime);
+      reader.readPod(mpcInput.finalTime);
+      reader.readVector(mpcInput.initState);
+      reader.readTargetTrajectories(mpcInput.targetTrajectories);
+      reader.readModeSchedule(mpcInput.modeSchedule);
+      break;
+    }
+    case RecordType::MpcOutput: {
+      auto& mpcOutput = record.mpcOutput;
+      reader.readPrimalSolution(mpcOutput.primalSolution);
+      reader.readPodArray(mpcOutput.performanceIndices);
+      break;
+    }
+    case RecordType::MrtCommand: {
+      auto& observation = record.mrtCommand.command.mpcInitObservation_;
+      uint64_t mode;
+      reader.readPod(mode);
+      observation.mode = static_cast<size_t>(mode);
+      reader.readPod(observation.time);
+      reader.readVector(observation.state);
+      reader.readVector(observation.input);
+      reader.readTargetTrajectories(record.mrtCommand.command.mpcTargetTrajectories_);
+      reader.readPrimalSolution(record.mrtCommand.primalSolution);
+      break;
+    }
+    default:
+      throw std::runtime_error("[RecordReader] Unknown record type " + std::to_string(typeByte));
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverRecorder::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                  const ReferenceManagerInterface& referenceManager) {
+  writerPtr_->writeMpcInput(initTime, finalTime, initState, referenceManager.getTargetTrajectories(), referenceManager.getModeSchedule());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SolverRecorder::postSolverRun(const PrimalSolution& primalSolution) {
+  writerPtr_->writeMpcOutput(primalSolution, solver_.getIterationsLog());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MrtRecorder::modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {
+  writerPtr_->writeMrtCommand(commandBuffer, primalSolutionBuffer);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ReplaySamples replayRecording(MPC_BASE& mpc, const std::string& fileName) {
+  RecordReader reader(fileName);
+
+  mpc.reset();
+  auto& referenceManager = mpc.getSolverPtr()->getReferenceManager();
+  const ReplayModeGuard replayModeGuard(referenceManager);
+
+  ReplaySamples samples;
+  Record record;
+  while (reader.readNext(record)) {
+    if (record.type == RecordType::MpcInput) {
+      // the output of the previous run was not recorded
+      if (samples.recordedCost.size() < samples.replayedCost.size()) {
+        samples.recordedCost.push_back(std::numeric_limits<scalar_t>::quiet_NaN());
+      }
+
+      referenceManager.setTargetTrajectories(record.mpcInput.targetTrajectories);
+      referenceManager.setModeSchedule(record.mpcInput.modeSchedule);
+
+      const auto startTime = std::chrono::steady_clock::now();
+      mpc.run(record.mpcInput.initTime, record.mpcInput.initState);
+      const auto endTime = std::chrono::steady_clock::now();
+
+      samples.solveTimes.push_back(std::chrono::duration<scalar_t, std::milli>(endTime - startTime).count());
+      samples.numIterations.push_back(static_cast<scalar_t>(mpc.getSolverPtr()->getIterationsLog().size()));
+      samples.replayedCost.push_back(mpc.getSolverPtr()->getPerformanceIndeces().cost);
+
+    } else if (record.type == RecordType::MpcOutput && samples.recordedCost.size() < samples.replayedCost.size()) {
+      const auto& performanceIndices = record.mpcOutput.performanceIndices;
+      samples.recordedCost.push_back(performanceIndices.empty() ? std::numeric_limits<scalar_t>::quiet_NaN()
+                                                                : performanceIndices.back().cost);
+    }
+  }
+
+  if (samples.recordedCost.size() < samples.replayedCost.size()) {
+    samples.recordedCost.push_back(std::numeric_limits<scalar_t>::quiet_NaN());
+  }
+
+  return samples;
+}
+
+}  // namespace recording
+}  // namespace ocs2
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/property_tree/ptree.hpp>
 
 #include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 
 namespace ocs2 {
 namespace mpc {
@@ -57,6 +58,13 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.mpcDesiredFrequency_, fieldName + ".mpcDesiredFrequency", verbose);
   loadData::loadPtreeValue(pt, settings.mrtDesiredFrequency_, fieldName + ".mrtDesiredFrequency", verbose);
 
+  std::string mpcThreadAffinity;
+  loadData::loadPtreeValue(pt, mpcThreadAffinity, fieldName + ".mpcThreadAffinity", verbose);
+  settings.mpcThreadAffinity_ = parseCpuList(mpcThreadAffinity);
+  std::string mrtThreadAffinity;
+  loadData::loadPtreeValue(pt, mrtThreadAffinity, fieldName + ".mrtThreadAffinity", verbose);
+  settings.mrtThreadAffinity_ = parseCpuList(mrtThreadAffinity);
+
   if (verbose) {
     std::cerr << " #### =============================================================================" << std::endl;
   }
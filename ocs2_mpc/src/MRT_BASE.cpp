@@ -182,8 +182,9 @@ bool MRT_BASE::updatePolicy() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
-                            std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
+std::unique_ptr<PrimalSolution> MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr,
+                                                       std::unique_ptr<PrimalSolution> primalSolutionPtr,
+                                                       std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
   if (commandDataPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::moveToBuffer] commandDataPtr cannot be a null pointer!");
   }
@@ -207,6 +208,9 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
 
   newPolicyInBuffer_ = true;
   policyReceivedEver_ = true;
+
+  // the replaced solution is either a policy which was never swapped in, or the policy which was active before the last update
+  return primalSolutionPtr;
 }
 
 /******************************************************************************************************/
@@ -1,5 +1,9 @@
 #include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_mpc/MPC_BatchService.h>
+#include <ocs2_mpc/MPC_ClosedLoopBenchmark.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_mpc/MPC_MultiStart.h>
+#include <ocs2_mpc/MPC_Recorder.h>
 #include <ocs2_mpc/MPC_Settings.h>
 #include <ocs2_mpc/MRT_BASE.h>
 
@@ -0,0 +1,138 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+#include "ocs2_mpc/MPC_BASE.h"
+
+namespace ocs2 {
+namespace mpc_test {
+
+/** A solver which sleeps for a given time and reports a given merit. */
+class DummySolver final : public SolverBase {
+ public:
+  DummySolver(scalar_t merit, scalar_t solveTime, bool isThrowing = false) : solveTime_(solveTime), isThrowing_(isThrowing) {
+    performanceIndex_.merit = merit;
+  }
+  ~DummySolver() override = default;
+
+  /** Sets a function which is called at the start of each run. */
+  void setRunCallback(std::function<void()> runCallback) { runCallback_ = std::move(runCallback); }
+  size_t getNumRuns() const { return numRuns_; }
+  /** The number of getPrimalSolution calls which got a solution filled by an earlier call */
+  size_t getNumReusedSolutions() const { return numReusedSolutions_; }
+  /** Sets a constant input which the primal solution applies through a feedforward controller. By default, it has no controller. */
+  void setNominalInput(vector_t nominalInput) { nominalInput_ = std::move(nominalInput); }
+
+  void reset() override {}
+  const OptimalControlProblem& getOptimalControlProblem() const override { return problem_; }
+  const PerformanceIndex& getPerformanceIndeces() const override { return performanceIndex_; }
+  size_t getNumIterations() const override { return 1; }
+  const std::vector<PerformanceIndex>& getIterationsLog() const override { return iterationsLog_; }
+  scalar_t getFinalTime() const override { return finalTime_; }
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override {
+    if (!primalSolutionPtr->timeTrajectory_.empty()) {
+      ++numReusedSolutions_;
+    }
+    primalSolutionPtr->timeTrajectory_.assign(1, finalTime);
+    if (nominalInput_.size() > 0) {
+      primalSolutionPtr->inputTrajectory_.assign(1, nominalInput_);
+      primalSolutionPtr->controllerPtr_.reset(
+          new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+    }
+  }
+  const DualSolution& getDualSolution() const override { return dualSolution_; }
+  const ProblemMetrics& getSolutionMetrics() const override { return problemMetrics_; }
+  ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override { return {}; }
+  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override { return {}; }
+  vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override { return {}; }
+  MultiplierCollection getIntermediateDualSolution(scalar_t time) const override { return {}; }
+
+ private:
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    if (runCallback_) {
+      runCallback_();
+    }
+    std::this_thread::sleep_for(std::chrono::duration<scalar_t>(solveTime_));
+    finalTime_ = finalTime;
+    ++numRuns_;
+    if (isThrowing_) {
+      throw std::runtime_error("[DummySolver] failed");
+    }
+  }
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) override {
+    runImpl(initTime, initState, finalTime);
+  }
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override {
+    runImpl(initTime, initState, finalTime);
+  }
+
+  const scalar_t solveTime_;
+  const bool isThrowing_;
+  std::function<void()> runCallback_;
+  std::atomic_size_t numRuns_{0};
+  mutable size_t numReusedSolutions_ = 0;
+  vector_t nominalInput_;
+  scalar_t finalTime_ = 0.0;
+  PerformanceIndex performanceIndex_;
+  std::vector<PerformanceIndex> iterationsLog_;
+  OptimalControlProblem problem_;
+  DualSolution dualSolution_;
+  ProblemMetrics problemMetrics_;
+};
+
+/** An MPC which runs a DummySolver. */
+class DummyMpc final : public MPC_BASE {
+ public:
+  explicit DummyMpc(scalar_t solveTime, scalar_t merit = 0.0) : MPC_BASE(mpc::Settings()), solver_(merit, solveTime) {}
+  ~DummyMpc() override = default;
+
+  DummySolver* getSolverPtr() override { return &solver_; }
+  const DummySolver* getSolverPtr() const override { return &solver_; }
+
+ private:
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    solver_.run(initTime, initState, finalTime);
+  }
+
+  DummySolver solver_;
+};
+
+}  // namespace mpc_test
+}  // namespace ocs2
@@ -0,0 +1,153 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+#include <ocs2_mpc/MPC_BatchService.h>
+
+#include "ocs2_mpc/test/DummySolver.h"
+
+using namespace ocs2;
+using mpc_test::DummyMpc;
+
+namespace {
+
+SystemObservation getObservation() {
+  SystemObservation observation;
+  observation.time = 0.0;
+  observation.state = vector_t::Zero(2);
+  observation.input = vector_t::Zero(1);
+  return observation;
+}
+
+}  // unnamed namespace
+
+TEST(testMPC_BatchService, earliestDeadlineFirst) {
+  constexpr scalar_t solveTime = 0.05;
+  std::vector<std::unique_ptr<DummyMpc>> mpcPtrs;
+  for (size_t i = 0; i < 4; i++) {
+    mpcPtrs.emplace_back(new DummyMpc(solveTime));
+  }
+
+  // a single thread runs the instances one after the other
+  MPC_BatchService service(1);
+  std::mutex orderMutex;
+  std::vector<size_t> order;
+  const std::vector<scalar_t> deadlines{10.0, 1.0, 5.0, 2.0};
+  for (size_t i = 0; i < mpcPtrs.size(); i++) {
+    EXPECT_EQ(service.addInstance(*mpcPtrs[i], deadlines[i]), i);
+    mpcPtrs[i]->getSolverPtr()->setRunCallback([&, i]() {
+      std::lock_guard<std::mutex> lock(orderMutex);
+      order.push_back(i);
+    });
+    service.setCurrentObservation(i, getObservation());
+  }
+
+  service.advanceMpc();
+  EXPECT_EQ(order, (std::vector<size_t>{1, 3, 2, 0}));
+  for (size_t i = 0; i < mpcPtrs.size(); i++) {
+    EXPECT_FALSE(service.getStatus(i).isSkipped);
+    EXPECT_FALSE(service.getStatus(i).isDeadlineMissed);
+    EXPECT_GE(service.getStatus(i).solveTime, solveTime);
+    EXPECT_TRUE(service.getMpcMrtInterface(i).updatePolicy());
+  }
+}
+
+TEST(testMPC_BatchService, skipsInstancesPastTheirDeadline) {
+  DummyMpc slowMpc(0.1);
+  DummyMpc lateMpc(0.0);
+  DummyMpc relaxedMpc(0.0);
+
+  MPC_BatchService service(1);
+  const auto slowId = service.addInstance(slowMpc, 0.01);
+  const auto lateId = service.addInstance(lateMpc, 0.05);
+  const auto relaxedId = service.addInstance(relaxedMpc);
+  for (size_t i = 0; i < service.numInstances(); i++) {
+    service.setCurrentObservation(i, getObservation());
+  }
+
+  // the slow instance misses its deadline, after which the deadline of the late one has passed too
+  service.advanceMpc();
+  EXPECT_FALSE(service.getStatus(slowId).isSkipped);
+  EXPECT_TRUE(service.getStatus(slowId).isDeadlineMissed);
+  EXPECT_TRUE(service.getStatus(lateId).isSkipped);
+  EXPECT_TRUE(service.getStatus(lateId).isDeadlineMissed);
+  EXPECT_EQ(lateMpc.getSolverPtr()->getNumRuns(), 0);
+  EXPECT_FALSE(service.getStatus(relaxedId).isSkipped);
+  EXPECT_EQ(relaxedMpc.getSolverPtr()->getNumRuns(), 1);
+
+  // with a relaxed deadline, the late instance runs in the next call
+  service.setDeadline(lateId, 1.0);
+  service.advanceMpc();
+  EXPECT_FALSE(service.getStatus(lateId).isSkipped);
+  EXPECT_EQ(lateMpc.getSolverPtr()->getNumRuns(), 1);
+}
+
+TEST(testMPC_BatchService, runsAllInstancesOnThePool) {
+  constexpr size_t numInstances = 7;
+  std::vector<std::unique_ptr<DummyMpc>> mpcPtrs;
+  std::vector<std::unique_ptr<MPC_MRT_Interface>> mpcMrtInterfacePtrs;
+  MPC_BatchService service(3);
+  for (size_t i = 0; i < numInstances; i++) {
+    mpcPtrs.emplace_back(new DummyMpc(0.01));
+    // half of the instances are registered through their own MPC_MRT_Interface
+    if (i % 2 == 0) {
+      service.addInstance(*mpcPtrs.back());
+    } else {
+      mpcMrtInterfacePtrs.emplace_back(new MPC_MRT_Interface(*mpcPtrs.back()));
+      EXPECT_EQ(&service.getMpcMrtInterface(service.addInstance(*mpcMrtInterfacePtrs.back())), mpcMrtInterfacePtrs.back().get());
+    }
+    service.setCurrentObservation(i, getObservation());
+  }
+
+  for (size_t iter = 0; iter < 3; iter++) {
+    service.advanceMpc();
+  }
+  for (size_t i = 0; i < numInstances; i++) {
+    EXPECT_EQ(mpcPtrs[i]->getSolverPtr()->getNumRuns(), 3);
+    EXPECT_FALSE(service.getStatus(i).isDeadlineMissed);
+  }
+}
+
+TEST(testMPC_BatchService, recyclesThePolicyMemory) {
+  DummyMpc mpc(0.0);
+  MPC_MRT_Interface mpcMrtInterface(mpc);
+  mpcMrtInterface.setCurrentObservation(getObservation());
+
+  // the buffer holds a replaced policy from the second update on, hence only the first three policies are new
+  constexpr size_t numIterations = 10;
+  for (size_t iter = 0; iter < numIterations; iter++) {
+    mpcMrtInterface.advanceMpc();
+    EXPECT_TRUE(mpcMrtInterface.updatePolicy());
+  }
+  EXPECT_EQ(mpc.getSolverPtr()->getNumReusedSolutions(), numIterations - 3);
+}
@@ -0,0 +1,146 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_mpc/MPC_ClosedLoopBenchmark.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+#include "ocs2_mpc/test/DummySolver.h"
+
+using namespace ocs2;
+using namespace ocs2::benchmark;
+using mpc_test::DummyMpc;
+
+namespace {
+
+ClosedLoopSamples getDivergedSamples() {
+  constexpr scalar_t nan = std::numeric_limits<scalar_t>::quiet_NaN();
+  constexpr scalar_t inf = std::numeric_limits<scalar_t>::infinity();
+  ClosedLoopSamples samples;
+  samples.solveTimes = {1.0, 2.0, 3.0};
+  samples.numIterations = {1.0, 1.0, 1.0};
+  samples.cost = {1.0, inf, nan};
+  samples.dynamicsViolationSSE = {nan, nan, nan};
+  samples.equalityConstraintsSSE = {0.0, 0.0, 0.0};
+  samples.inequalityLagrangian = {0.0, 0.0, 0.0};
+  samples.finalTrackingError = {nan};
+  return samples;
+}
+
+/** A closed-loop problem of a double integrator, where the dummy MPC applies zero input. */
+class DoubleIntegratorBenchmark {
+ public:
+  DoubleIntegratorBenchmark()
+      : mpc_(0.0),
+        dynamics_((matrix_t(2, 2) << 0.0, 1.0, 0.0, 0.0).finished(), (matrix_t(2, 1) << 0.0, 1.0).finished()),
+        rollout_(dynamics_),
+        problem(mpc_, rollout_) {
+    mpc_.getSolverPtr()->setNominalInput(vector_t::Zero(1));
+    problem.initState = (vector_t(2) << 1.0, -1.0).finished();
+    problem.targetTrajectories = TargetTrajectories({0.0}, {vector_t::Zero(2)}, {vector_t::Zero(1)});
+  }
+
+ private:
+  DummyMpc mpc_;
+  LinearSystemDynamics dynamics_;
+  TimeTriggeredRollout rollout_;
+
+ public:
+  ClosedLoopProblem problem;
+};
+
+ClosedLoopSettings getShortSettings() {
+  ClosedLoopSettings settings;
+  settings.numTrials = 2;
+  settings.duration = 0.1;
+  return settings;
+}
+
+}  // unnamed namespace
+
+TEST(testMPC_ClosedLoopBenchmark, runsWithoutNoise) {
+  DoubleIntegratorBenchmark benchmark;
+  const auto settings = getShortSettings();
+  const auto samples = runClosedLoopBenchmark(benchmark.problem, settings);
+
+  // without noise and input, every trial coasts from the same initial state
+  EXPECT_EQ(samples.solveTimes.size(), settings.numTrials * 5);
+  ASSERT_EQ(samples.finalTrackingError.size(), settings.numTrials);
+  const scalar_t expectedError = (vector_t(2) << 1.0 - 0.1, -1.0).finished().norm();
+  for (const auto error : samples.finalTrackingError) {
+    EXPECT_NEAR(error, expectedError, 1e-6);
+  }
+}
+
+TEST(testMPC_ClosedLoopBenchmark, rejectsMismatchedNoise) {
+  DoubleIntegratorBenchmark benchmark;
+  benchmark.problem.initStateNoise = vector_t::Ones(3);
+  EXPECT_THROW(runClosedLoopBenchmark(benchmark.problem, getShortSettings()), std::runtime_error);
+
+  benchmark.problem.initStateNoise = vector_t::Ones(2);
+  benchmark.problem.targetStateNoise = vector_t::Ones(1);
+  EXPECT_THROW(runClosedLoopBenchmark(benchmark.problem, getShortSettings()), std::runtime_error);
+
+  benchmark.problem.targetStateNoise = vector_t::Ones(2);
+  EXPECT_NO_THROW(runClosedLoopBenchmark(benchmark.problem, getShortSettings()));
+}
+
+TEST(testMPC_ClosedLoopBenchmark, writesValidJson) {
+  std::stringstream stream;
+  writeJson(stream, "cart\"pole\\sqp\n", ClosedLoopSettings(), getDivergedSamples());
+
+  boost::property_tree::ptree pt;
+  ASSERT_NO_THROW(boost::property_tree::read_json(stream, pt)) << stream.str();
+  EXPECT_EQ(pt.get<std::string>("name"), "cart\"pole\\sqp\n");
+  EXPECT_EQ(pt.get<size_t>("statistics.solveTime_ms.numNonFinite"), 0);
+  EXPECT_DOUBLE_EQ(pt.get<scalar_t>("statistics.solveTime_ms.median"), 2.0);
+  // the non-finite samples are counted, and excluded from the distribution
+  EXPECT_EQ(pt.get<size_t>("statistics.cost.numNonFinite"), 2);
+  EXPECT_DOUBLE_EQ(pt.get<scalar_t>("statistics.cost.max"), 1.0);
+  EXPECT_EQ(pt.get<size_t>("statistics.dynamicsViolationSSE.numNonFinite"), 3);
+  EXPECT_FALSE(pt.get_child_optional("statistics.dynamicsViolationSSE.mean"));
+}
+
+TEST(testMPC_ClosedLoopBenchmark, nonFiniteStatisticExceedsThreshold) {
+  RegressionThresholds thresholds;
+  thresholds.finalTrackingErrorMean = 1.0;
+  std::stringstream stream;
+  EXPECT_FALSE(checkRegressionThresholds(stream, thresholds, getDivergedSamples()));
+  EXPECT_NE(stream.str().find("finalTrackingErrorMean"), std::string::npos);
+}
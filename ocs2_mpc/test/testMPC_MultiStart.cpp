@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <ocs2_mpc/MPC_MultiStart.h>
+
+#include "ocs2_mpc/test/DummySolver.h"
+
+using namespace ocs2;
+using mpc_test::DummySolver;
+
+namespace {
+
+scalar_t elapsedTime(std::chrono::steady_clock::time_point startTime) {
+  return std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+}  // unnamed namespace
+
+TEST(testMPC_MultiStart, selectsLowestMerit) {
+  std::vector<std::unique_ptr<SolverBase>> solverPtrs;
+  solverPtrs.emplace_back(new DummySolver(3.0, 0.01));
+  solverPtrs.emplace_back(new DummySolver(1.0, 0.02));
+  solverPtrs.emplace_back(new DummySolver(2.0, 0.0));
+  MPC_MultiStart mpc(mpc::Settings(), std::move(solverPtrs), 5.0);
+
+  ASSERT_TRUE(mpc.run(0.0, vector_t::Zero(2)));
+  EXPECT_EQ(mpc.getBestCandidateIndex(), 1);
+  EXPECT_EQ(mpc.getSolverPtr(), &mpc.getCandidateSolver(1));
+  for (size_t i = 0; i < mpc.numCandidates(); i++) {
+    const auto status = mpc.getCandidateStatus(i);
+    EXPECT_FALSE(status.isRunning);
+    EXPECT_FALSE(status.isFailed);
+    EXPECT_FALSE(status.isDeadlineMissed);
+  }
+}
+
+TEST(testMPC_MultiStart, returnsAtDeadline) {
+  constexpr scalar_t deadline = 0.1;
+  constexpr scalar_t slowSolveTime = 0.5;
+  std::vector<std::unique_ptr<SolverBase>> solverPtrs;
+  solverPtrs.emplace_back(new DummySolver(5.0, 0.0));
+  solverPtrs.emplace_back(new DummySolver(1.0, slowSolveTime));
+  MPC_MultiStart mpc(mpc::Settings(), std::move(solverPtrs), deadline);
+  const auto& slowSolver = dynamic_cast<const DummySolver&>(mpc.getCandidateSolver(1));
+
+  // the slow candidate has a lower merit, but it is not waited for
+  const auto startTime = std::chrono::steady_clock::now();
+  ASSERT_TRUE(mpc.run(0.0, vector_t::Zero(2)));
+  EXPECT_LT(elapsedTime(startTime), slowSolveTime);
+  EXPECT_EQ(mpc.getBestCandidateIndex(), 0);
+  EXPECT_TRUE(mpc.getCandidateStatus(1).isRunning);
+
+  // the still running candidate is not restarted
+  ASSERT_TRUE(mpc.run(0.01, vector_t::Zero(2)));
+  EXPECT_EQ(mpc.getBestCandidateIndex(), 0);
+
+  // once finished, the late candidate is flagged and restarted in the next iteration
+  mpc.waitForCandidates();
+  EXPECT_EQ(slowSolver.getNumRuns(), 1);
+  EXPECT_TRUE(mpc.getCandidateStatus(1).isDeadlineMissed);
+  ASSERT_TRUE(mpc.run(0.02, vector_t::Zero(2)));
+  EXPECT_EQ(mpc.getBestCandidateIndex(), 0);
+  mpc.waitForCandidates();
+  EXPECT_EQ(slowSolver.getNumRuns(), 2);
+}
+
+TEST(testMPC_MultiStart, waitsForFirstCandidateIfNoneInTime) {
+  constexpr scalar_t deadline = 0.01;
+  std::vector<std::unique_ptr<SolverBase>> solverPtrs;
+  solverPtrs.emplace_back(new DummySolver(1.0, 1.0));
+  solverPtrs.emplace_back(new DummySolver(5.0, 0.1));
+  MPC_MultiStart mpc(mpc::Settings(), std::move(solverPtrs), deadline);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  ASSERT_TRUE(mpc.run(0.0, vector_t::Zero(2)));
+  EXPECT_LT(elapsedTime(startTime), 1.0);
+  EXPECT_EQ(mpc.getBestCandidateIndex(), 1);
+  EXPECT_TRUE(mpc.getCandidateStatus(1).isDeadlineMissed);
+  EXPECT_TRUE(mpc.getCandidateStatus(0).isRunning);
+}
+
+TEST(testMPC_MultiStart, skipsFailedCandidates) {
+  std::vector<std::unique_ptr<SolverBase>> solverPtrs;
+  solverPtrs.emplace_back(new DummySolver(1.0, 0.0, true));
+  solverPtrs.emplace_back(new DummySolver(2.0, 0.0));
+  MPC_MultiStart mpc(mpc::Settings(), std::move(solverPtrs), 5.0);
+  ASSERT_TRUE(mpc.run(0.0, vector_t::Zero(2)));
+  EXPECT_EQ(mpc.getBestCandidateIndex(), 1);
+  EXPECT_TRUE(mpc.getCandidateStatus(0).isFailed);
+
+  std::vector<std::unique_ptr<SolverBase>> failingSolverPtrs;
+  failingSolverPtrs.emplace_back(new DummySolver(1.0, 0.0, true));
+  MPC_MultiStart failingMpc(mpc::Settings(), std::move(failingSolverPtrs), 5.0);
+  EXPECT_THROW(failingMpc.run(0.0, vector_t::Zero(2)), std::runtime_error);
+}
@@ -0,0 +1,263 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <ocs2_mpc/MPC_Recorder.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include "ocs2_mpc/test/DummySolver.h"
+
+using namespace ocs2;
+using namespace ocs2::recording;
+
+namespace {
+
+const std::string recordingFile = "/tmp/ocs2_mpc_recorder_test.rec";
+
+TargetTrajectories getTargetTrajectories(scalar_t offset) {
+  return {{offset, offset + 1.0}, {vector_t::Random(3), vector_t::Random(3)}, {vector_t::Random(2), vector_t::Random(2)}};
+}
+
+ModeSchedule getModeSchedule() {
+  return {{0.3, 0.6}, {0, 1, 2}};
+}
+
+PrimalSolution getPrimalSolution() {
+  PrimalSolution primalSolution;
+  primalSolution.timeTrajectory_ = {0.0, 0.3, 0.3, 1.0};
+  primalSolution.stateTrajectory_ = {vector_t::Random(3), vector_t::Random(3), vector_t::Random(3), vector_t::Random(3)};
+  primalSolution.inputTrajectory_ = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  primalSolution.postEventIndices_ = {2};
+  primalSolution.modeSchedule_ = getModeSchedule();
+  return primalSolution;
+}
+
+void expectEqual(const TargetTrajectories& lhs, const TargetTrajectories& rhs) {
+  EXPECT_EQ(lhs.timeTrajectory, rhs.timeTrajectory);
+  EXPECT_EQ(lhs.stateTrajectory, rhs.stateTrajectory);
+  EXPECT_EQ(lhs.inputTrajectory, rhs.inputTrajectory);
+}
+
+void expectEqual(const ModeSchedule& lhs, const ModeSchedule& rhs) {
+  EXPECT_EQ(lhs.eventTimes, rhs.eventTimes);
+  EXPECT_EQ(lhs.modeSequence, rhs.modeSequence);
+}
+
+void expectEqual(const PrimalSolution& lhs, const PrimalSolution& rhs) {
+  EXPECT_EQ(lhs.timeTrajectory_, rhs.timeTrajectory_);
+  EXPECT_EQ(lhs.stateTrajectory_, rhs.stateTrajectory_);
+  EXPECT_EQ(lhs.inputTrajectory_, rhs.inputTrajectory_);
+  EXPECT_EQ(lhs.postEventIndices_, rhs.postEventIndices_);
+  expectEqual(lhs.modeSchedule_, rhs.modeSchedule_);
+}
+
+/** Truncates the recording by the given number of bytes */
+void truncateRecording(size_t numBytes) {
+  std::ifstream input(recordingFile, std::ios::binary);
+  const std::vector<char> bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+  input.close();
+  ASSERT_GT(bytes.size(), numBytes);
+  std::ofstream output(recordingFile, std::ios::binary | std::ios::trunc);
+  output.write(bytes.data(), bytes.size() - numBytes);
+}
+
+/** A reference manager which generates the mode schedule, as e.g. a gait planner */
+class PlanningReferenceManager final : public ReferenceManager {
+ public:
+  explicit PlanningReferenceManager(TargetTrajectories targetTrajectories) : ReferenceManager(std::move(targetTrajectories)) {}
+
+  const ModeSchedule plannedModeSchedule{{0.1}, {3, 4}};
+  size_t numModified = 0;
+  size_t numReplayed = 0;
+
+ private:
+  void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
+                        ModeSchedule& modeSchedule) override {
+    modeSchedule = plannedModeSchedule;
+    numModified++;
+  }
+
+  void updateReplayedReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                const TargetTrajectories& targetTrajectories, const ModeSchedule& modeSchedule) override {
+    numReplayed++;
+  }
+};
+
+}  // unnamed namespace
+
+TEST(testMPC_Recorder, roundTrip) {
+  const vector_t initState = vector_t::Random(3);
+  const auto targetTrajectories = getTargetTrajectories(0.0);
+  const auto modeSchedule = getModeSchedule();
+  const auto primalSolution = getPrimalSolution();
+  std::vector<PerformanceIndex> performanceIndices(2);
+  performanceIndices[0].merit = 2.0;
+  performanceIndices[1].cost = 1.0;
+  CommandData command;
+  command.mpcInitObservation_.mode = 1;
+  command.mpcInitObservation_.time = 0.1;
+  command.mpcInitObservation_.state = vector_t::Random(3);
+  command.mpcInitObservation_.input = vector_t::Random(2);
+  command.mpcTargetTrajectories_ = getTargetTrajectories(0.1);
+
+  {
+    RecordWriter writer(recordingFile);
+    writer.writeMpcInput(0.0, 1.0, initState, targetTrajectories, modeSchedule);
+    writer.writeMpcOutput(primalSolution, performanceIndices);
+    writer.writeMrtCommand(command, primalSolution);
+  }
+
+  RecordReader reader(recordingFile);
+  Record record;
+  for (size_t pass = 0; pass < 2; pass++) {
+    ASSERT_TRUE(reader.readNext(record));
+    ASSERT_EQ(record.type, RecordType::MpcInput);
+    EXPECT_EQ(record.mpcInput.initTime, 0.0);
+    EXPECT_EQ(record.mpcInput.finalTime, 1.0);
+    EXPECT_EQ(record.mpcInput.initState, initState);
+    expectEqual(record.mpcInput.targetTrajectories, targetTrajectories);
+    expectEqual(record.mpcInput.modeSchedule, modeSchedule);
+
+    ASSERT_TRUE(reader.readNext(record));
+    ASSERT_EQ(record.type, RecordType::MpcOutput);
+    expectEqual(record.mpcOutput.primalSolution, primalSolution);
+    EXPECT_EQ(record.mpcOutput.primalSolution.controllerPtr_, nullptr);
+    ASSERT_EQ(record.mpcOutput.performanceIndices.size(), performanceIndices.size());
+    EXPECT_EQ(record.mpcOutput.performanceIndices[0].merit, performanceIndices[0].merit);
+    EXPECT_EQ(record.mpcOutput.performanceIndices[1].cost, performanceIndices[1].cost);
+
+    ASSERT_TRUE(reader.readNext(record));
+    ASSERT_EQ(record.type, RecordType::MrtCommand);
+    const auto& observation = record.mrtCommand.command.mpcInitObservation_;
+    EXPECT_EQ(observation.mode, command.mpcInitObservation_.mode);
+    EXPECT_EQ(observation.time, command.mpcInitObservation_.time);
+    EXPECT_EQ(observation.state, command.mpcInitObservation_.state);
+    EXPECT_EQ(observation.input, command.mpcInitObservation_.input);
+    expectEqual(record.mrtCommand.command.mpcTargetTrajectories_, command.mpcTargetTrajectories_);
+    expectEqual(record.mrtCommand.primalSolution, primalSolution);
+
+    EXPECT_FALSE(reader.readNext(record));
+    reader.rewind();
+  }
+}
+
+TEST(testMPC_Recorder, truncatedLastRecord) {
+  const vector_t initState = vector_t::Random(3);
+  const auto targetTrajectories = getTargetTrajectories(0.0);
+  {
+    RecordWriter writer(recordingFile);
+    writer.writeMpcInput(0.0, 1.0, initState, targetTrajectories, getModeSchedule());
+    writer.writeMpcOutput(getPrimalSolution(), std::vector<PerformanceIndex>(1));
+  }
+
+  // the payload of the last record is partially written
+  truncateRecording(8);
+  {
+    RecordReader reader(recordingFile);
+    Record record;
+    ASSERT_TRUE(reader.readNext(record));
+    EXPECT_EQ(record.type, RecordType::MpcInput);
+    EXPECT_EQ(record.mpcInput.initState, initState);
+    EXPECT_FALSE(reader.readNext(record));
+  }
+
+  // only a part of the header of the last record is written
+  {
+    RecordWriter writer(recordingFile);
+    writer.writeMpcInput(0.0, 1.0, initState, targetTrajectories, getModeSchedule());
+    writer.writeMpcInput(1.0, 2.0, initState, targetTrajectories, getModeSchedule());
+  }
+  std::ifstream input(recordingFile, std::ios::binary | std::ios::ate);
+  const size_t fileSize = input.tellg();
+  input.close();
+  const size_t recordSize = (fileSize - 8) / 2;
+  truncateRecording(recordSize - 4);
+  {
+    RecordReader reader(recordingFile);
+    Record record;
+    ASSERT_TRUE(reader.readNext(record));
+    EXPECT_EQ(record.mpcInput.initTime, 0.0);
+    EXPECT_FALSE(reader.readNext(record));
+  }
+}
+
+TEST(testMPC_Recorder, replayBypassesReferenceModification) {
+  const vector_t initState = vector_t::Random(3);
+  const std::vector<TargetTrajectories> targetTrajectories{getTargetTrajectories(0.0), getTargetTrajectories(1.0)};
+  std::vector<PerformanceIndex> performanceIndices(1);
+  performanceIndices[0].cost = 3.0;
+  {
+    RecordWriter writer(recordingFile);
+    writer.writeMpcInput(0.0, 1.0, initState, targetTrajectories[0], getModeSchedule());
+    writer.writeMpcOutput(getPrimalSolution(), performanceIndices);
+    writer.writeMpcInput(0.5, 1.5, initState, targetTrajectories[1], getModeSchedule());
+  }
+
+  mpc_test::DummyMpc mpc(0.0);
+  auto& solver = *mpc.getSolverPtr();
+  const auto originalTargetTrajectories = getTargetTrajectories(2.0);
+  const auto referenceManagerPtr = std::make_shared<PlanningReferenceManager>(originalTargetTrajectories);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // the solver runs on the recorded references of its own reference manager
+  std::vector<TargetTrajectories> replayedTargetTrajectories;
+  std::vector<ModeSchedule> replayedModeSchedules;
+  solver.setRunCallback([&]() {
+    EXPECT_EQ(&solver.getReferenceManager(), referenceManagerPtr.get());
+    replayedTargetTrajectories.push_back(solver.getReferenceManager().getTargetTrajectories());
+    replayedModeSchedules.push_back(solver.getReferenceManager().getModeSchedule());
+  });
+
+  const auto samples = replayRecording(mpc, recordingFile);
+  ASSERT_EQ(samples.solveTimes.size(), 2);
+  ASSERT_EQ(samples.recordedCost.size(), 2);
+  EXPECT_EQ(samples.recordedCost[0], performanceIndices[0].cost);
+  EXPECT_TRUE(std::isnan(samples.recordedCost[1]));
+  ASSERT_EQ(replayedTargetTrajectories.size(), 2);
+  for (size_t i = 0; i < 2; i++) {
+    expectEqual(replayedTargetTrajectories[i], targetTrajectories[i]);
+    expectEqual(replayedModeSchedules[i], getModeSchedule());
+  }
+  EXPECT_EQ(referenceManagerPtr->numModified, 0);
+  EXPECT_EQ(referenceManagerPtr->numReplayed, 2);
+
+  // afterwards, the references active before the replay are set again and modified as usual
+  referenceManagerPtr->preSolverRun(0.0, 1.0, initState);
+  EXPECT_EQ(referenceManagerPtr->numModified, 1);
+  EXPECT_EQ(referenceManagerPtr->numReplayed, 2);
+  expectEqual(referenceManagerPtr->getTargetTrajectories(), originalTargetTrajectories);
+  expectEqual(referenceManagerPtr->getModeSchedule(), referenceManagerPtr->plannedModeSchedule);
+}
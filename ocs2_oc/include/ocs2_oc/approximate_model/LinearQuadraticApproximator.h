@@ -51,6 +51,21 @@ namespace ocs2 {
 void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t time, const vector_t& state, const vector_t& input,
                                const MultiplierCollection& multipliers, ModelData& modelData);
 
+/**
+ * Calculates an LQ approximate of the constrained optimal control problem at a given time, state, and input. The inequality
+ * Lagrangian terms which are locally constant at the given metrics only contribute their value, without evaluating their constraints.
+ *
+ * @param [in] problem: The optimal control problem
+ * @param [in] time: The current time.
+ * @param [in] state: The current state.
+ * @param [in] input: The current input.
+ * @param [in] multipliers: The current multipliers associated to the equality and inequality Lagrangians.
+ * @param [in] metrics: The metrics computed at the same time, state, input, and multipliers.
+ * @param [out] modelData: The output data model.
+ */
+void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t time, const vector_t& state, const vector_t& input,
+                               const MultiplierCollection& multipliers, const MetricsCollection& metrics, ModelData& modelData);
+
 /**
  * Calculates an LQ approximate of the constrained optimal control problem at a given time, state, and input.
  *
@@ -80,6 +95,20 @@ inline ModelData approximateIntermediateLQ(OptimalControlProblem& problem, const
 void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
                           const MultiplierCollection& multipliers, ModelData& modelData);
 
+/**
+ * Calculates an LQ approximate of the constrained optimal control problem at a jump event time. The inequality Lagrangian terms
+ * which are locally constant at the given metrics only contribute their value, without evaluating their constraints.
+ *
+ * @param [in] problem: The optimal control problem
+ * @param [in] time: The current time.
+ * @param [in] state: The current state.
+ * @param [in] multipliers: The current multipliers associated to the equality and inequality Lagrangians.
+ * @param [in] metrics: The metrics computed at the same time, state, and multipliers.
+ * @param [out] modelData: The output data model.
+ */
+void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          const MultiplierCollection& multipliers, const MetricsCollection& metrics, ModelData& modelData);
+
 /**
  * Calculates an LQ approximate of the constrained optimal control problem at a jump event time.
  *
@@ -108,6 +137,20 @@ inline ModelData approximatePreJumpLQ(OptimalControlProblem& problem, const scal
 void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
                         const MultiplierCollection& multipliers, ModelData& modelData);
 
+/**
+ * Calculates an LQ approximate of the constrained optimal control problem at final time. The inequality Lagrangian terms which are
+ * locally constant at the given metrics only contribute their value, without evaluating their constraints.
+ *
+ * @param [in] problem: The optimal control problem
+ * @param [in] time: The current time.
+ * @param [in] state: The current state.
+ * @param [in] multipliers: The current multipliers associated to the equality and inequality Lagrangians.
+ * @param [in] metrics: The metrics computed at the same time, state, and multipliers.
+ * @param [out] modelData: The output data model.
+ */
+void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                        const MultiplierCollection& multipliers, const MetricsCollection& metrics, ModelData& modelData);
+
 /**
  * Calculates an LQ approximate of the constrained optimal control problem at final time.
  *
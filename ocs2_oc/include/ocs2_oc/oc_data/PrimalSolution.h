@@ -106,4 +106,36 @@ struct PrimalSolution {
   std::unique_ptr<ControllerBase> controllerPtr_;
 };
 
+/**
+ * Copies the part of a controller up to the requested final time into a destination controller. One node beyond the final time is
+ * included such that the controller can be interpolated up to the final time. Linear and feedforward controllers are sliced into the
+ * memory of the destination if it holds a controller of the same type. Other controller types are cloned.
+ *
+ * @param [in] controller : The controller to be sliced.
+ * @param [in] finalTime : The final time of the requested window.
+ * @param [in, out] slicePtr : The destination controller.
+ */
+void getTimeSlicedController(const ControllerBase& controller, scalar_t finalTime, std::unique_ptr<ControllerBase>& slicePtr);
+
+/**
+ * Copies the trajectories, the post-event indices, and the mode schedule of a primal solution up to the requested final time into a
+ * destination solution, reusing the memory of the destination. One node beyond the final time is included. The controller of the
+ * destination is not modified.
+ *
+ * @param [in] primalSolution : The primal solution to be sliced.
+ * @param [in] finalTime : The final time of the requested window.
+ * @param [in, out] slice : The destination primal solution.
+ */
+void getTimeSlicedTrajectories(const PrimalSolution& primalSolution, scalar_t finalTime, PrimalSolution& slice);
+
+/**
+ * Copies a primal solution up to the requested final time into a destination solution, reusing the memory of the destination.
+ * Equivalent to calling getTimeSlicedTrajectories and getTimeSlicedController.
+ *
+ * @param [in] primalSolution : The primal solution to be sliced.
+ * @param [in] finalTime : The final time of the requested window.
+ * @param [in, out] slice : The destination primal solution.
+ */
+void getTimeSlicedPrimalSolution(const PrimalSolution& primalSolution, scalar_t finalTime, PrimalSolution& slice);
+
 }  // namespace ocs2
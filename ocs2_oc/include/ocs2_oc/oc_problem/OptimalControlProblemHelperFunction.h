@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/model_data/Metrics.h>
 #include <ocs2_core/model_data/Multiplier.h>
+#include <ocs2_core/model_data/MultiplierTrajectory.h>
 
 #include "ocs2_oc/oc_data/DualSolution.h"
 #include "ocs2_oc/oc_data/PrimalSolution.h"
@@ -51,6 +52,31 @@ namespace ocs2 {
 void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, const DualSolution& cachedDualSolution,
                             DualSolution& dualSolution);
 
+/**
+ * Initializes the dual solution based on the cached dual solution whose intermediates are already packed. Use this overload when the
+ * same cached dual solution initializes several dual solutions, e.g. in the line search, so that it is packed only once.
+ *
+ * @param [in] ocp : A const reference to the optimal control problem.
+ * @param [in] primalSolution : The primal solution.
+ * @param [in] cachedDualSolution : The cached dual solution which will be used for interpolation. Its intermediates are not read.
+ * @param [in] cachedIntermediates : The packed intermediates of cachedDualSolution.
+ * @param [out] dualSolution : The initialized dual solution.
+ */
+void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, const DualSolution& cachedDualSolution,
+                            const MultiplierTrajectory& cachedIntermediates, DualSolution& dualSolution);
+
+/**
+ * Shifts the cached dual solution of the previous MPC iteration to the new initial time. The nodes which are not needed to interpolate
+ * from initTime on are dropped from the packed intermediates with a single memmove, and the time trajectory, the event indices, and the
+ * pre-jump multipliers are shifted accordingly. The unpacked intermediates of cachedDualSolution are released since they are superseded
+ * by cachedIntermediates.
+ *
+ * @param [in] initTime : The initial time of the new MPC iteration.
+ * @param [in, out] cachedDualSolution : The cached dual solution.
+ * @param [in, out] cachedIntermediates : The packed intermediates of cachedDualSolution.
+ */
+void shiftDualSolution(scalar_t initTime, DualSolution& cachedDualSolution, MultiplierTrajectory& cachedIntermediates);
+
 /**
  * Initializes final MultiplierCollection for equality and inequality Lagrangians.
  *
@@ -0,0 +1,146 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/dynamics/ControlledSystemBase.h>
+#include <ocs2_core/integration/FixedStepIntegrator.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/rollout/RolloutSettings.h"
+
+namespace ocs2 {
+
+/**
+ * Forward rollout of many environments of the same system on a common time grid, e.g. for generating learning data from a policy.
+ *
+ * The time grid is the one of TimeTriggeredRollout with a fixed-step integrator: equidistant steps of rollout::Settings::timeStep in
+ * each mode, where the last step of each mode is shortened to end on the event. On the events, the post-event state is given by the
+ * jump map. Supported integrator types are EULER, EULER_OCS2, RK4, RK4_OCS2, and IMPLICIT_MIDPOINT_OCS2.
+ *
+ * The environments are distributed over a thread pool. Each thread holds a clone of the system dynamics and a fixed-step integrator,
+ * and advances one environment at a time over the whole grid. The trajectories are stored in one column per environment, such that
+ * the trajectory of an environment is contiguous in memory.
+ */
+class BatchRollout {
+ public:
+  /** The trajectories of a batch of M environments on a time grid of K time points. */
+  struct Trajectories {
+    /** The common time grid (K) */
+    scalar_array_t timeTrajectory;
+    /** The indices of the post-event time points */
+    size_array_t postEventIndices;
+    /** The state trajectories (nx * K, M). Column m holds the states of environment m, i.e. the state at time k is segment(k * nx, nx). */
+    matrix_t stateTrajectories;
+    /** The input trajectories (nu * K, M). Column m holds the inputs of environment m, i.e. the input at time k is segment(k * nu, nu). */
+    matrix_t inputTrajectories;
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param [in] systemDynamics: The system dynamics for forward rollout.
+   * @param [in] rolloutSettings: The rollout settings.
+   * @param [in] nThreads: The number of threads including the calling one.
+   * @param [in] threadPriority: The priority of the worker threads.
+   * @param [in] cpus: The CPUs to pin the worker threads to. If empty, the threads are not pinned.
+   */
+  BatchRollout(const ControlledSystemBase& systemDynamics, rollout::Settings rolloutSettings, size_t nThreads = 1, int threadPriority = 0,
+               const std::vector<int>& cpus = {});
+
+  ~BatchRollout() = default;
+  BatchRollout(const BatchRollout&) = delete;
+  BatchRollout& operator=(const BatchRollout&) = delete;
+
+  /** Returns the rollout settings. */
+  const rollout::Settings& settings() const { return rolloutSettings_; }
+
+  /**
+   * Rolls out all environments with a shared policy. The controller is cloned for each thread.
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] initStates: The initial states (nx, M), one column per environment.
+   * @param [in] finalTime: The final time.
+   * @param [in] controller: The shared control policy.
+   * @param [in] modeSchedule: The mode schedule.
+   * @param [out] trajectories: The resulting trajectories.
+   */
+  void run(scalar_t initTime, const matrix_t& initStates, scalar_t finalTime, const ControllerBase& controller,
+           const ModeSchedule& modeSchedule, Trajectories& trajectories);
+
+  /**
+   * Rolls out environment m with the policy controllers[m]. A controller may appear several times, but is then called from different
+   * threads and therefore must be thread-safe.
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] initStates: The initial states (nx, M), one column per environment.
+   * @param [in] finalTime: The final time.
+   * @param [in] controllers: The control policy of each environment.
+   * @param [in] modeSchedule: The mode schedule.
+   * @param [out] trajectories: The resulting trajectories.
+   */
+  void run(scalar_t initTime, const matrix_t& initStates, scalar_t finalTime, const std::vector<ControllerBase*>& controllers,
+           const ModeSchedule& modeSchedule, Trajectories& trajectories);
+
+ private:
+  /** The thread local resources. */
+  struct Worker {
+    std::unique_ptr<ControlledSystemBase> systemDynamicsPtr;
+    std::unique_ptr<FixedStepIntegrator> integratorPtr;
+    std::unique_ptr<ControllerBase> sharedControllerPtr;
+    vector_t state;
+  };
+
+  /** Computes the common time grid and the size of each step of the grid. */
+  void computeTimeGrid(scalar_t initTime, scalar_t finalTime, const scalar_array_t& eventTimes, Trajectories& trajectories);
+
+  /** Rolls out environment m with the given controller and writes its columns of the trajectories. */
+  void rolloutEnvironment(Worker& worker, ControllerBase& controller, size_t m, const matrix_t& initStates, Trajectories& trajectories);
+
+  /**
+   * Resizes the trajectories and rolls out the environments in parallel.
+   * @param [in] getController: Returns the controller of environment m for the given worker.
+   */
+  void runParallel(const matrix_t& initStates, const std::function<ControllerBase&(Worker&, size_t)>& getController,
+                   Trajectories& trajectories);
+
+  const rollout::Settings rolloutSettings_;
+  ThreadPool threadPool_;
+  std::vector<Worker> workers_;
+  scalar_array_t stepSizes_;
+};
+
+}  // namespace ocs2
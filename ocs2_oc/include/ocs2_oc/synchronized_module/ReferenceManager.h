@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+
 #include "ocs2_core/thread_support/BufferedValue.h"
 #include "ocs2_oc/synchronized_module/ReferenceManagerInterface.h"
 
@@ -59,6 +61,8 @@ class ReferenceManager : public ReferenceManagerInterface {
     return targetTrajectories_.setBuffer(std::move(targetTrajectories));
   }
 
+  void setReplayMode(bool replayMode) override { replayMode_ = replayMode; }
+
  protected:
   /**
    * Modifies the active ModeSchedule and TargetTrajectories.
@@ -74,9 +78,23 @@ class ReferenceManager : public ReferenceManagerInterface {
   virtual void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
                                 ModeSchedule& modeSchedule) {}
 
+  /**
+   * Updates the internal state which depends on the active references, while recorded references are replayed. In this mode,
+   * modifyReferences() is not called and the set references are used as they are.
+   *
+   * @param [in] initTime : Start time of the optimization horizon.
+   * @param [in] finalTime : Final time of the optimization horizon.
+   * @param [in] initState : State at the start of the optimization horizon.
+   * @param [in] targetTrajectories : The active TargetTrajectories.
+   * @param [in] modeSchedule : The active ModeSchedule.
+   */
+  virtual void updateReplayedReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                        const TargetTrajectories& targetTrajectories, const ModeSchedule& modeSchedule) {}
+
  private:
   BufferedValue<ModeSchedule> modeSchedule_;
   BufferedValue<TargetTrajectories> targetTrajectories_;
+  std::atomic_bool replayMode_{false};
 };
 
 }  // namespace ocs2
@@ -64,6 +64,8 @@ class ReferenceManagerDecorator : public ReferenceManagerInterface {
     referenceManagerPtr_->setTargetTrajectories(std::move(targetTrajectories));
   }
 
+  void setReplayMode(bool replayMode) override { referenceManagerPtr_->setReplayMode(replayMode); }
+
  protected:
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
 };
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <stdexcept>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
@@ -90,6 +92,16 @@ class ReferenceManagerInterface {
    * @note: This method must be thread safe.
    */
   virtual void setTargetTrajectories(TargetTrajectories&& targetTrajectories) = 0;
+
+  /**
+   * Enables or disables the replay of recorded references. While enabled, preSolverRun() activates the set ModeSchedule and
+   * TargetTrajectories as they are, without the modifications that generated them (e.g., a gait planner), and only updates the
+   * internal state which depends on the active references.
+   * @note: This method must be thread safe.
+   */
+  virtual void setReplayMode(bool replayMode) {
+    throw std::runtime_error("[ReferenceManagerInterface] This reference manager does not support the replay of recorded references!");
+  }
 };
 
 }  // namespace ocs2
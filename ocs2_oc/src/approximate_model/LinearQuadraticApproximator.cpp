@@ -35,11 +35,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t time, const vector_t& state, const vector_t& input,
-                               const MultiplierCollection& multipliers, ModelData& modelData) {
+namespace {
+
+void approximateIntermediateLQImpl(OptimalControlProblem& problem, const scalar_t time, const vector_t& state, const vector_t& input,
+                                   const MultiplierCollection& multipliers, const MetricsCollection* metricsPtr, ModelData& modelData) {
   auto& preComputation = *problem.preComputationPtr;
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics + Request::Approximation;
   preComputation.request(request, time, state, input);
@@ -68,7 +67,10 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
     modelData.cost.dfdxx += approx.dfdxx;
   }
   if (!problem.stateInequalityLagrangianPtr->empty()) {
-    auto approx = problem.stateInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
+    auto approx = (metricsPtr != nullptr)
+                      ? problem.stateInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq,
+                                                                                        metricsPtr->stateIneqLagrangian, preComputation)
+                      : problem.stateInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
     modelData.cost.f += approx.f;
     modelData.cost.dfdx += approx.dfdx;
     modelData.cost.dfdxx += approx.dfdxx;
@@ -78,16 +80,16 @@ void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t ti
         problem.equalityLagrangianPtr->getQuadraticApproximation(time, state, input, multipliers.stateInputEq, preComputation);
   }
   if (!problem.inequalityLagrangianPtr->empty()) {
-    modelData.cost +=
-        problem.inequalityLagrangianPtr->getQuadraticApproximation(time, state, input, multipliers.stateInputIneq, preComputation);
+    modelData.cost += (metricsPtr != nullptr)
+                          ? problem.inequalityLagrangianPtr->getQuadraticApproximation(time, state, input, multipliers.stateInputIneq,
+                                                                                       metricsPtr->stateInputIneqLagrangian, preComputation)
+                          : problem.inequalityLagrangianPtr->getQuadraticApproximation(time, state, input, multipliers.stateInputIneq,
+                                                                                       preComputation);
   }
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
-                          const MultiplierCollection& multipliers, ModelData& modelData) {
+void approximatePreJumpLQImpl(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                              const MultiplierCollection& multipliers, const MetricsCollection* metricsPtr, ModelData& modelData) {
   auto& preComputation = *problem.preComputationPtr;
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics + Request::Approximation;
   preComputation.requestPreJump(request, time, state);
@@ -114,18 +116,19 @@ void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time,
     modelData.cost.dfdxx += approx.dfdxx;
   }
   if (!problem.preJumpInequalityLagrangianPtr->empty()) {
-    auto approx = problem.preJumpInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
+    auto approx = (metricsPtr != nullptr)
+                      ? problem.preJumpInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq,
+                                                                                          metricsPtr->stateIneqLagrangian, preComputation)
+                      : problem.preJumpInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq,
+                                                                                          preComputation);
     modelData.cost.f += approx.f;
     modelData.cost.dfdx += approx.dfdx;
     modelData.cost.dfdxx += approx.dfdxx;
   }
 }
 
-/******************************************************************************************************/
-/******************************************************************************************************/
-/******************************************************************************************************/
-void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
-                        const MultiplierCollection& multipliers, ModelData& modelData) {
+void approximateFinalLQImpl(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                            const MultiplierCollection& multipliers, const MetricsCollection* metricsPtr, ModelData& modelData) {
   auto& preComputation = *problem.preComputationPtr;
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   preComputation.requestFinal(request, time, state);
@@ -152,13 +155,66 @@ void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, co
     modelData.cost.dfdxx += approx.dfdxx;
   }
   if (!problem.finalInequalityLagrangianPtr->empty()) {
-    auto approx = problem.finalInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
+    auto approx = (metricsPtr != nullptr)
+                      ? problem.finalInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq,
+                                                                                        metricsPtr->stateIneqLagrangian, preComputation)
+                      : problem.finalInequalityLagrangianPtr->getQuadraticApproximation(time, state, multipliers.stateIneq, preComputation);
     modelData.cost.f += approx.f;
     modelData.cost.dfdx += approx.dfdx;
     modelData.cost.dfdxx += approx.dfdxx;
   }
 }
 
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t time, const vector_t& state, const vector_t& input,
+                               const MultiplierCollection& multipliers, ModelData& modelData) {
+  approximateIntermediateLQImpl(problem, time, state, input, multipliers, nullptr, modelData);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximateIntermediateLQ(OptimalControlProblem& problem, const scalar_t time, const vector_t& state, const vector_t& input,
+                               const MultiplierCollection& multipliers, const MetricsCollection& metrics, ModelData& modelData) {
+  approximateIntermediateLQImpl(problem, time, state, input, multipliers, &metrics, modelData);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          const MultiplierCollection& multipliers, ModelData& modelData) {
+  approximatePreJumpLQImpl(problem, time, state, multipliers, nullptr, modelData);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximatePreJumpLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                          const MultiplierCollection& multipliers, const MetricsCollection& metrics, ModelData& modelData) {
+  approximatePreJumpLQImpl(problem, time, state, multipliers, &metrics, modelData);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                        const MultiplierCollection& multipliers, ModelData& modelData) {
+  approximateFinalLQImpl(problem, time, state, multipliers, nullptr, modelData);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void approximateFinalLQ(OptimalControlProblem& problem, const scalar_t& time, const vector_t& state,
+                        const MultiplierCollection& multipliers, const MetricsCollection& metrics, ModelData& modelData) {
+  approximateFinalLQImpl(problem, time, state, multipliers, &metrics, modelData);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -289,6 +345,12 @@ MetricsCollection computeIntermediateMetrics(OptimalControlProblem& problem, con
   metrics.stateInputIneqLagrangian =
       problem.inequalityLagrangianPtr->getValue(time, state, input, multipliers.stateInputIneq, preComputation);
 
+  // Inequality active-set statistics
+  problem.stateInequalityLagrangianPtr->countLocallyConstantTerms(time, metrics.stateIneqLagrangian, multipliers.stateIneq,
+                                                                  metrics.numSkippedIneqTerms, metrics.numEvaluatedIneqTerms);
+  problem.inequalityLagrangianPtr->countLocallyConstantTerms(time, metrics.stateInputIneqLagrangian, multipliers.stateInputIneq,
+                                                             metrics.numSkippedIneqTerms, metrics.numEvaluatedIneqTerms);
+
   return metrics;
 }
 
@@ -311,6 +373,10 @@ MetricsCollection computePreJumpMetrics(OptimalControlProblem& problem, const sc
   metrics.stateEqLagrangian = problem.preJumpEqualityLagrangianPtr->getValue(time, state, multipliers.stateEq, preComputation);
   metrics.stateIneqLagrangian = problem.preJumpInequalityLagrangianPtr->getValue(time, state, multipliers.stateIneq, preComputation);
 
+  // Inequality active-set statistics
+  problem.preJumpInequalityLagrangianPtr->countLocallyConstantTerms(time, metrics.stateIneqLagrangian, multipliers.stateIneq,
+                                                                    metrics.numSkippedIneqTerms, metrics.numEvaluatedIneqTerms);
+
   return metrics;
 }
 
@@ -333,6 +399,10 @@ MetricsCollection computeFinalMetrics(OptimalControlProblem& problem, const scal
   metrics.stateEqLagrangian = problem.finalEqualityLagrangianPtr->getValue(time, state, multipliers.stateEq, preComputation);
   metrics.stateIneqLagrangian = problem.finalInequalityLagrangianPtr->getValue(time, state, multipliers.stateIneq, preComputation);
 
+  // Inequality active-set statistics
+  problem.finalInequalityLagrangianPtr->countLocallyConstantTerms(time, metrics.stateIneqLagrangian, multipliers.stateIneq,
+                                                                  metrics.numSkippedIneqTerms, metrics.numEvaluatedIneqTerms);
+
   return metrics;
 }
 
@@ -0,0 +1,123 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_data/PrimalSolution.h"
+
+#include <algorithm>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Number of nodes up to the final time, including one node beyond it */
+size_t getRequestedDataLength(const scalar_array_t& timeTrajectory, scalar_t finalTime) {
+  size_t length = std::distance(timeTrajectory.cbegin(), std::upper_bound(timeTrajectory.cbegin(), timeTrajectory.cend(), finalTime));
+  length += (length != timeTrajectory.size()) ? 1 : 0;
+  return length;
+}
+
+/** Copies the first elements of the source into the destination. The elements already held by the destination are assigned to. */
+template <typename T, typename Alloc>
+void assignFront(const std::vector<T, Alloc>& source, size_t length, std::vector<T, Alloc>& destination) {
+  destination.assign(source.cbegin(), source.cbegin() + length);
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void getTimeSlicedController(const ControllerBase& controller, scalar_t finalTime, std::unique_ptr<ControllerBase>& slicePtr) {
+  if (const auto* linearControllerPtr = dynamic_cast<const LinearController*>(&controller)) {
+    auto* linearSlicePtr = dynamic_cast<LinearController*>(slicePtr.get());
+    if (linearSlicePtr == nullptr) {
+      linearSlicePtr = new LinearController;
+      slicePtr.reset(linearSlicePtr);
+    }
+    const auto length = getRequestedDataLength(linearControllerPtr->timeStamp_, finalTime);
+    assignFront(linearControllerPtr->timeStamp_, length, linearSlicePtr->timeStamp_);
+    assignFront(linearControllerPtr->biasArray_, length, linearSlicePtr->biasArray_);
+    assignFront(linearControllerPtr->gainArray_, length, linearSlicePtr->gainArray_);
+    // deltaBiasArray can be of different, incompatible size.
+    if (length < linearControllerPtr->deltaBiasArray_.size()) {
+      assignFront(linearControllerPtr->deltaBiasArray_, length, linearSlicePtr->deltaBiasArray_);
+    } else {
+      linearSlicePtr->deltaBiasArray_.clear();
+    }
+
+  } else if (const auto* feedforwardControllerPtr = dynamic_cast<const FeedforwardController*>(&controller)) {
+    auto* feedforwardSlicePtr = dynamic_cast<FeedforwardController*>(slicePtr.get());
+    if (feedforwardSlicePtr == nullptr) {
+      feedforwardSlicePtr = new FeedforwardController;
+      slicePtr.reset(feedforwardSlicePtr);
+    }
+    const auto length = getRequestedDataLength(feedforwardControllerPtr->timeStamp_, finalTime);
+    assignFront(feedforwardControllerPtr->timeStamp_, length, feedforwardSlicePtr->timeStamp_);
+    assignFront(feedforwardControllerPtr->uffArray_, length, feedforwardSlicePtr->uffArray_);
+
+  } else {
+    slicePtr.reset(controller.clone());
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void getTimeSlicedTrajectories(const PrimalSolution& primalSolution, scalar_t finalTime, PrimalSolution& slice) {
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& postEventIndices = primalSolution.postEventIndices_;
+
+  const auto length = getRequestedDataLength(timeTrajectory, finalTime);
+  // post-event indices that point into the slice
+  const auto eventLength =
+      std::distance(postEventIndices.cbegin(), std::lower_bound(postEventIndices.cbegin(), postEventIndices.cend(), length));
+
+  assignFront(timeTrajectory, length, slice.timeTrajectory_);
+  assignFront(primalSolution.stateTrajectory_, length, slice.stateTrajectory_);
+  assignFront(primalSolution.inputTrajectory_, length, slice.inputTrajectory_);
+  assignFront(postEventIndices, eventLength, slice.postEventIndices_);
+  slice.modeSchedule_ = primalSolution.modeSchedule_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void getTimeSlicedPrimalSolution(const PrimalSolution& primalSolution, scalar_t finalTime, PrimalSolution& slice) {
+  getTimeSlicedTrajectories(primalSolution, finalTime, slice);
+  if (primalSolution.controllerPtr_ != nullptr) {
+    getTimeSlicedController(*primalSolution.controllerPtr_, finalTime, slice.controllerPtr_);
+  } else {
+    slice.controllerPtr_.reset();
+  }
+}
+
+}  // namespace ocs2
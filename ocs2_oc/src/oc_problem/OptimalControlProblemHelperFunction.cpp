@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h"
 
+#include <algorithm>
+#include <cassert>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -36,14 +39,26 @@ namespace ocs2 {
 /******************************************************************************************************/
 void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, const DualSolution& cachedDualSolution,
                             DualSolution& dualSolution) {
+  const MultiplierTrajectory cachedIntermediates(cachedDualSolution.intermediates);
+  initializeDualSolution(ocp, primalSolution, cachedDualSolution, cachedIntermediates, dualSolution);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSolution& primalSolution, const DualSolution& cachedDualSolution,
+                            const MultiplierTrajectory& cachedIntermediates, DualSolution& dualSolution) {
+  assert(cachedIntermediates.size() == cachedDualSolution.timeTrajectory.size());
+
   // find the time period that we can interpolate the cached dual solution
   const auto timePeriod = std::make_pair(primalSolution.timeTrajectory_.front(), primalSolution.timeTrajectory_.back());
   const auto interpolatableTimePeriod =
       findIntersectionToExtendableInterval(cachedDualSolution.timeTrajectory, primalSolution.modeSchedule_.eventTimes, timePeriod);
   const bool interpolateTillFinalTime = numerics::almost_eq(interpolatableTimePeriod.second, timePeriod.second);
 
-  // clear and set time
-  dualSolution.clear();
+  // clear and set time. The intermediates are all overwritten below, therefore their memory is reused.
+  dualSolution.final.clear();
+  dualSolution.preJumps.clear();
   dualSolution.timeTrajectory = primalSolution.timeTrajectory_;
   dualSolution.postEventIndices = primalSolution.postEventIndices_;
 
@@ -79,13 +94,41 @@ void initializeDualSolution(const OptimalControlProblem& ocp, const PrimalSoluti
     const auto& time = primalSolution.timeTrajectory_[i];
     auto& multiplierCollection = dualSolution.intermediates[i];
     if (interpolatableTimePeriod.first <= time && time <= interpolatableTimePeriod.second) {
-      multiplierCollection = getIntermediateDualSolutionAtTime(cachedDualSolution, time);
+      cachedIntermediates.interpolate(LinearInterpolation::timeSegment(time, cachedDualSolution.timeTrajectory), multiplierCollection);
     } else {
       initializeIntermediateMultiplierCollection(ocp, time, multiplierCollection);
     }
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void shiftDualSolution(scalar_t initTime, DualSolution& cachedDualSolution, MultiplierTrajectory& cachedIntermediates) {
+  assert(cachedIntermediates.size() == cachedDualSolution.timeTrajectory.size());
+  auto& timeTrajectory = cachedDualSolution.timeTrajectory;
+  cachedDualSolution.intermediates.clear();
+
+  // keep the last node at or before initTime as the lower end of the first interpolation segment
+  const auto firstNodeItr = std::upper_bound(timeTrajectory.cbegin(), timeTrajectory.cend(), initTime);
+  const size_t numNodes = (firstNodeItr == timeTrajectory.cbegin()) ? 0 : std::distance(timeTrajectory.cbegin(), firstNodeItr) - 1;
+  if (numNodes == 0) {
+    return;
+  }
+
+  cachedIntermediates.shift(numNodes);
+  timeTrajectory.erase(timeTrajectory.begin(), timeTrajectory.begin() + numNodes);
+
+  // drop the events whose pre-event node is removed
+  auto& postEventIndices = cachedDualSolution.postEventIndices;
+  const auto firstEventItr = std::upper_bound(postEventIndices.cbegin(), postEventIndices.cend(), numNodes);
+  const size_t numEvents = std::distance(postEventIndices.cbegin(), firstEventItr);
+  postEventIndices.erase(postEventIndices.begin(), postEventIndices.begin() + numEvents);
+  std::for_each(postEventIndices.begin(), postEventIndices.end(), [numNodes](size_t& index) { index -= numNodes; });
+  auto& preJumps = cachedDualSolution.preJumps;
+  preJumps.erase(preJumps.begin(), preJumps.begin() + std::min(numEvents, preJumps.size()));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,238 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/rollout/BatchRollout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include <ocs2_core/NumericTraits.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Returns the fixed-step scheme of the integrator type. */
+FixedStepIntegrator::Scheme fixedStepScheme(IntegratorType integratorType) {
+  switch (integratorType) {
+    case IntegratorType::EULER:
+    case IntegratorType::EULER_OCS2:
+      return FixedStepIntegrator::Scheme::EULER;
+    case IntegratorType::RK4:
+    case IntegratorType::RK4_OCS2:
+      return FixedStepIntegrator::Scheme::RK4;
+    case IntegratorType::IMPLICIT_MIDPOINT_OCS2:
+      return FixedStepIntegrator::Scheme::IMPLICIT_MIDPOINT;
+    default:
+      throw std::runtime_error("[BatchRollout] Integrator of type " + integrator_type::toString(integratorType) +
+                               " is not a fixed-step integrator.");
+  }
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchRollout::BatchRollout(const ControlledSystemBase& systemDynamics, rollout::Settings rolloutSettings, size_t nThreads,
+                           int threadPriority, const std::vector<int>& cpus)
+    : rolloutSettings_(std::move(rolloutSettings)), threadPool_(std::max(nThreads, size_t(1)) - 1, threadPriority, cpus) {
+  if (rolloutSettings_.timeStep <= 0.0) {
+    throw std::runtime_error("[BatchRollout] The time step should be positive!");
+  }
+  const auto scheme = fixedStepScheme(rolloutSettings_.integratorType);
+
+  // the caller thread has the last worker index
+  workers_.resize(threadPool_.numThreads() + 1);
+  for (auto& worker : workers_) {
+    worker.systemDynamicsPtr.reset(systemDynamics.clone());
+    worker.integratorPtr.reset(new FixedStepIntegrator(scheme));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::run(scalar_t initTime, const matrix_t& initStates, scalar_t finalTime, const ControllerBase& controller,
+                       const ModeSchedule& modeSchedule, Trajectories& trajectories) {
+  computeTimeGrid(initTime, finalTime, modeSchedule.eventTimes, trajectories);
+
+  for (auto& worker : workers_) {
+    worker.sharedControllerPtr.reset(controller.clone());
+  }
+  runParallel(
+      initStates, [](Worker& worker, size_t) -> ControllerBase& { return *worker.sharedControllerPtr; }, trajectories);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::run(scalar_t initTime, const matrix_t& initStates, scalar_t finalTime, const std::vector<ControllerBase*>& controllers,
+                       const ModeSchedule& modeSchedule, Trajectories& trajectories) {
+  if (controllers.size() != static_cast<size_t>(initStates.cols())) {
+    throw std::runtime_error("[BatchRollout::run] The number of controllers (" + std::to_string(controllers.size()) +
+                             ") does not match the number of environments (" + std::to_string(initStates.cols()) + ")!");
+  }
+  if (std::any_of(controllers.cbegin(), controllers.cend(), [](const ControllerBase* c) { return c == nullptr; })) {
+    throw std::runtime_error("[BatchRollout::run] Controller is not set!");
+  }
+
+  computeTimeGrid(initTime, finalTime, modeSchedule.eventTimes, trajectories);
+
+  runParallel(
+      initStates, [&](Worker&, size_t m) -> ControllerBase& { return *controllers[m]; }, trajectories);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::computeTimeGrid(scalar_t initTime, scalar_t finalTime, const scalar_array_t& eventTimes, Trajectories& trajectories) {
+  if (initTime > finalTime) {
+    throw std::runtime_error("[BatchRollout::run] The initial time should be less-equal to the final time!");
+  }
+
+  auto& timeTrajectory = trajectories.timeTrajectory;
+  auto& postEventIndices = trajectories.postEventIndices;
+  timeTrajectory.clear();
+  postEventIndices.clear();
+  stepSizes_.clear();
+
+  // switching times as in RolloutBase::findActiveModesTimeInterval
+  const auto firstIndex = std::upper_bound(eventTimes.cbegin(), eventTimes.cend(), initTime);  // no event at initial time
+  const auto lastIndex = std::upper_bound(eventTimes.cbegin(), eventTimes.cend(), finalTime);  // can be an event at final time
+  scalar_array_t switchingTimes;
+  switchingTimes.push_back(initTime);
+  switchingTimes.insert(switchingTimes.end(), firstIndex, lastIndex);
+  switchingTimes.push_back(finalTime);
+
+  // the steps of FixedStepIntegrator::integrateAdaptive in each mode
+  const scalar_t dt = rolloutSettings_.timeStep;
+  const auto numSteps = static_cast<size_t>((finalTime - initTime) / dt) + 2 * switchingTimes.size();
+  timeTrajectory.reserve(numSteps);
+  stepSizes_.reserve(numSteps);
+  for (size_t i = 0; i + 1 < switchingTimes.size(); i++) {
+    const scalar_t endTime = switchingTimes[i + 1];
+    const scalar_t beginTime = std::min(switchingTimes[i] + numeric_traits::weakEpsilon<scalar_t>(), endTime);
+
+    if (i > 0) {
+      // the transition to the post-event time is the jump map
+      postEventIndices.push_back(timeTrajectory.size());
+      stepSizes_.push_back(0.0);
+    }
+
+    timeTrajectory.push_back(beginTime);
+    scalar_t t = beginTime;
+    size_t numModeSteps = 0;
+    while (t + dt - endTime <= std::numeric_limits<scalar_t>::epsilon()) {
+      numModeSteps++;
+      // direct computation of the time avoids accumulation of round-off errors
+      t = beginTime + numModeSteps * dt;
+      timeTrajectory.push_back(t);
+      stepSizes_.push_back(dt);
+    }
+    // the last step ends exactly at the end of the mode
+    if (endTime - t > std::numeric_limits<scalar_t>::epsilon()) {
+      timeTrajectory.push_back(endTime);
+      stepSizes_.push_back(endTime - t);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::rolloutEnvironment(Worker& worker, ControllerBase& controller, size_t m, const matrix_t& initStates,
+                                      Trajectories& trajectories) {
+  const auto& timeTrajectory = trajectories.timeTrajectory;
+  const auto& postEventIndices = trajectories.postEventIndices;
+  const size_t stateDim = initStates.rows();
+  const size_t inputDim = trajectories.inputTrajectories.rows() / timeTrajectory.size();
+  auto states = trajectories.stateTrajectories.col(m);
+  auto inputs = trajectories.inputTrajectories.col(m);
+
+  auto& systemDynamics = *worker.systemDynamicsPtr;
+  systemDynamics.setController(&controller);
+
+  auto& x = worker.state;
+  x = initStates.col(m);
+  auto eventItr = postEventIndices.cbegin();
+  for (size_t k = 0; k < timeTrajectory.size(); k++) {
+    if (k > 0) {
+      if (eventItr != postEventIndices.cend() && *eventItr == k) {
+        x = systemDynamics.computeJumpMap(timeTrajectory[k - 1], x);
+        ++eventItr;
+      } else {
+        worker.integratorPtr->integrateStep(systemDynamics, timeTrajectory[k - 1], stepSizes_[k - 1], x);
+      }
+    }
+
+    if (rolloutSettings_.checkNumericalStability && !x.allFinite()) {
+      throw std::runtime_error("[BatchRollout::run] The state of environment " + std::to_string(m) +
+                               " is not finite at time: " + std::to_string(timeTrajectory[k]));
+    }
+
+    states.segment(k * stateDim, stateDim) = x;
+    inputs.segment(k * inputDim, inputDim) = controller.computeInput(timeTrajectory[k], x);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::runParallel(const matrix_t& initStates, const std::function<ControllerBase&(Worker&, size_t)>& getController,
+                               Trajectories& trajectories) {
+  const size_t numEnvironments = initStates.cols();
+  const size_t numTimePoints = trajectories.timeTrajectory.size();
+  if (numEnvironments == 0) {
+    trajectories.stateTrajectories.resize(initStates.rows() * numTimePoints, 0);
+    trajectories.inputTrajectories.resize(0, 0);
+    return;
+  }
+
+  // the input dimension of the first environment
+  auto& callerWorker = workers_.back();
+  const auto inputDim = getController(callerWorker, 0).computeInput(trajectories.timeTrajectory.front(), initStates.col(0)).size();
+  trajectories.stateTrajectories.resize(initStates.rows() * numTimePoints, numEnvironments);
+  trajectories.inputTrajectories.resize(inputDim * numTimePoints, numEnvironments);
+
+  // each environment writes only its own columns
+  std::atomic_size_t nextEnvironment{0};
+  auto task = [&](int workerIndex) {
+    auto& worker = workers_[workerIndex];
+    size_t m = nextEnvironment++;
+    while (m < numEnvironments) {
+      rolloutEnvironment(worker, getController(worker, m), m, initStates, trajectories);
+      m = nextEnvironment++;
+    }
+  };
+  threadPool_.runParallel(task, static_cast<int>(std::min(workers_.size(), numEnvironments)));
+}
+
+}  // namespace ocs2
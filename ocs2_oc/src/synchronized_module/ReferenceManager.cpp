@@ -43,7 +43,11 @@ ReferenceManager::ReferenceManager(TargetTrajectories initialTargetTrajectories,
 void ReferenceManager::preSolverRun(scalar_t initTime, scalar_t finalTime, const vector_t& initState) {
   targetTrajectories_.updateFromBuffer();
   modeSchedule_.updateFromBuffer();
-  modifyReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
+  if (replayMode_) {
+    updateReplayedReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
+  } else {
+    modifyReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
+  }
 }
 
 }  // namespace ocs2
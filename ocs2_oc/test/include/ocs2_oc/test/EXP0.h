@@ -120,7 +120,7 @@ class EXP0_Cost final : public QuadraticStateInputCost {
   EXP0_Cost(const EXP0_Cost& other) = default;
 
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
+                                                       const TargetTrajectories& targetTrajectories, const PreComputation&) const override {
     return {state - targetTrajectories.stateTrajectory[0], input - targetTrajectories.inputTrajectory[0]};
   }
 };
@@ -137,7 +137,8 @@ class EXP0_FinalCost final : public QuadraticStateCost {
  private:
   EXP0_FinalCost(const EXP0_FinalCost& other) = default;
 
-  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
+  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                             const PreComputation&) const override {
     return state - targetTrajectories.stateTrajectory[0];
   }
 };
@@ -177,7 +177,7 @@ class EXP1_Cost final : public QuadraticStateInputCost {
   EXP1_Cost(const EXP1_Cost& other) = default;
 
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
+                                                       const TargetTrajectories& targetTrajectories, const PreComputation&) const override {
     return {state - targetTrajectories.stateTrajectory[0], input - targetTrajectories.inputTrajectory[0]};
   }
 };
@@ -194,7 +194,8 @@ class EXP1_FinalCost final : public QuadraticStateCost {
  private:
   EXP1_FinalCost(const EXP1_FinalCost& other) = default;
 
-  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
+  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                             const PreComputation&) const override {
     return state - targetTrajectories.stateTrajectory[0];
   }
 };
@@ -0,0 +1,116 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+#include "ocs2_oc/oc_data/PrimalSolution.h"
+
+using namespace ocs2;
+
+namespace {
+PrimalSolution getRandomPrimalSolution(size_t numNodes) {
+  constexpr size_t stateDim = 4;
+  constexpr size_t inputDim = 2;
+
+  PrimalSolution primalSolution;
+  matrix_array_t gains;
+  for (size_t i = 0; i < numNodes; i++) {
+    primalSolution.timeTrajectory_.push_back(0.1 * i);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(inputDim));
+    gains.push_back(matrix_t::Random(inputDim, stateDim));
+  }
+  primalSolution.postEventIndices_ = {3, 12};
+  primalSolution.modeSchedule_ = ModeSchedule({0.25, 1.15}, {0, 1, 2});
+  primalSolution.controllerPtr_.reset(
+      new LinearController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_, std::move(gains)));
+  return primalSolution;
+}
+}  // namespace
+
+TEST(testPrimalSolution, timeSlice) {
+  const auto primalSolution = getRandomPrimalSolution(20);
+
+  PrimalSolution slice;
+  getTimeSlicedPrimalSolution(primalSolution, 0.55, slice);
+
+  // nodes up to t = 0.55 and one beyond
+  ASSERT_EQ(slice.timeTrajectory_.size(), 7);
+  ASSERT_EQ(slice.stateTrajectory_.size(), 7);
+  ASSERT_EQ(slice.inputTrajectory_.size(), 7);
+  EXPECT_DOUBLE_EQ(slice.timeTrajectory_.back(), primalSolution.timeTrajectory_[6]);
+  EXPECT_TRUE(slice.stateTrajectory_.back().isApprox(primalSolution.stateTrajectory_[6]));
+  ASSERT_EQ(slice.postEventIndices_.size(), 1);
+  EXPECT_EQ(slice.postEventIndices_.front(), 3);
+  EXPECT_EQ(slice.modeSchedule_.modeSequence, primalSolution.modeSchedule_.modeSequence);
+
+  const auto* linearControllerPtr = dynamic_cast<const LinearController*>(slice.controllerPtr_.get());
+  ASSERT_NE(linearControllerPtr, nullptr);
+  ASSERT_EQ(linearControllerPtr->size(), 7);
+  const auto& linearController = dynamic_cast<const LinearController&>(*primalSolution.controllerPtr_);
+  EXPECT_TRUE(linearControllerPtr->gainArray_.back().isApprox(linearController.gainArray_[6]));
+}
+
+TEST(testPrimalSolution, timeSliceBeyondHorizon) {
+  const auto primalSolution = getRandomPrimalSolution(20);
+
+  PrimalSolution slice;
+  getTimeSlicedPrimalSolution(primalSolution, 10.0, slice);
+
+  ASSERT_EQ(slice.timeTrajectory_, primalSolution.timeTrajectory_);
+  ASSERT_EQ(slice.postEventIndices_, primalSolution.postEventIndices_);
+  ASSERT_EQ(slice.controllerPtr_->size(), primalSolution.controllerPtr_->size());
+}
+
+TEST(testPrimalSolution, timeSliceReusesMemory) {
+  const auto primalSolution = getRandomPrimalSolution(20);
+
+  PrimalSolution slice;
+  getTimeSlicedPrimalSolution(primalSolution, 1.0, slice);
+  const auto* controllerPtr = slice.controllerPtr_.get();
+  const auto* stateDataPtr = slice.stateTrajectory_.front().data();
+  const auto* gainDataPtr = dynamic_cast<const LinearController*>(controllerPtr)->gainArray_.front().data();
+
+  // A shorter window is sliced into the existing storage
+  getTimeSlicedPrimalSolution(primalSolution, 0.5, slice);
+  EXPECT_EQ(slice.controllerPtr_.get(), controllerPtr);
+  EXPECT_EQ(slice.stateTrajectory_.front().data(), stateDataPtr);
+  EXPECT_EQ(dynamic_cast<const LinearController*>(controllerPtr)->gainArray_.front().data(), gainDataPtr);
+
+  // A feedforward controller replaces the linear controller
+  PrimalSolution feedforwardSolution = getRandomPrimalSolution(20);
+  feedforwardSolution.controllerPtr_.reset(
+      new FeedforwardController(feedforwardSolution.timeTrajectory_, feedforwardSolution.inputTrajectory_));
+  getTimeSlicedPrimalSolution(feedforwardSolution, 0.5, slice);
+  ASSERT_NE(dynamic_cast<const FeedforwardController*>(slice.controllerPtr_.get()), nullptr);
+  EXPECT_EQ(slice.controllerPtr_->size(), slice.timeTrajectory_.size());
+}
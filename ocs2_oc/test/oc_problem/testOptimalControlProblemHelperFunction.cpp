@@ -0,0 +1,117 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h"
+
+using namespace ocs2;
+
+namespace {
+/** A dual solution over [0, 1] with an event at 0.5 and two constraint structures. */
+DualSolution getRandomDualSolution() {
+  auto randomMultipliers = [](const size_array_t& termsSize) {
+    std::vector<Multiplier> multipliers;
+    for (const auto size : termsSize) {
+      multipliers.push_back({vector_t::Random(1)(0), vector_t::Random(size)});
+    }
+    return multipliers;
+  };
+
+  DualSolution dualSolution;
+  dualSolution.timeTrajectory = {0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0};
+  dualSolution.postEventIndices = {6};
+  for (size_t i = 0; i < dualSolution.timeTrajectory.size(); i++) {
+    MultiplierCollection multiplierCollection;
+    multiplierCollection.stateInputIneq = (i < 6) ? randomMultipliers({2, 3}) : randomMultipliers({4});
+    dualSolution.intermediates.push_back(multiplierCollection);
+  }
+  dualSolution.preJumps.resize(1);
+  dualSolution.preJumps[0].stateIneq = randomMultipliers({2});
+  dualSolution.final.stateIneq = randomMultipliers({1});
+  return dualSolution;
+}
+
+PrimalSolution getPrimalSolution(const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices) {
+  PrimalSolution primalSolution;
+  primalSolution.timeTrajectory_ = timeTrajectory;
+  primalSolution.postEventIndices_ = postEventIndices;
+  primalSolution.modeSchedule_ = ModeSchedule({0.5}, {0, 1});
+  return primalSolution;
+}
+
+bool isEqual(const MultiplierCollection& lhs, const MultiplierCollection& rhs) {
+  return toVector(lhs.stateEq) == toVector(rhs.stateEq) && toVector(lhs.stateIneq) == toVector(rhs.stateIneq) &&
+         toVector(lhs.stateInputEq) == toVector(rhs.stateInputEq) && toVector(lhs.stateInputIneq) == toVector(rhs.stateInputIneq);
+}
+
+/** Checks that the shifted warm start initializes the same dual solution as the full cached dual solution. */
+void testShift(const PrimalSolution& primalSolution, size_t expectedSize, const size_array_t& expectedPostEventIndices) {
+  const OptimalControlProblem ocp;
+  const auto cachedDualSolution = getRandomDualSolution();
+
+  DualSolution expected;
+  initializeDualSolution(ocp, primalSolution, cachedDualSolution, expected);
+
+  auto shiftedDualSolution = cachedDualSolution;
+  MultiplierTrajectory shiftedIntermediates(shiftedDualSolution.intermediates);
+  shiftDualSolution(primalSolution.timeTrajectory_.front(), shiftedDualSolution, shiftedIntermediates);
+  ASSERT_EQ(shiftedIntermediates.size(), expectedSize);
+  ASSERT_EQ(shiftedDualSolution.timeTrajectory.size(), expectedSize);
+  EXPECT_EQ(shiftedDualSolution.postEventIndices, expectedPostEventIndices);
+  EXPECT_EQ(shiftedDualSolution.preJumps.size(), expectedPostEventIndices.size());
+
+  DualSolution dualSolution;
+  initializeDualSolution(ocp, primalSolution, shiftedDualSolution, shiftedIntermediates, dualSolution);
+  EXPECT_TRUE(isEqual(dualSolution.final, expected.final));
+  ASSERT_EQ(dualSolution.preJumps.size(), expected.preJumps.size());
+  for (size_t i = 0; i < expected.preJumps.size(); i++) {
+    EXPECT_TRUE(isEqual(dualSolution.preJumps[i], expected.preJumps[i]));
+  }
+  ASSERT_EQ(dualSolution.intermediates.size(), expected.intermediates.size());
+  for (size_t i = 0; i < expected.intermediates.size(); i++) {
+    EXPECT_TRUE(isEqual(dualSolution.intermediates[i], expected.intermediates[i])) << "at time " << primalSolution.timeTrajectory_[i];
+  }
+}
+}  // namespace
+
+TEST(testOptimalControlProblemHelperFunction, shiftDualSolutionBeforeEvent) {
+  const auto primalSolution = getPrimalSolution({0.33, 0.4, 0.5, 0.5, 0.65, 0.8, 1.0}, {3});
+  testShift(primalSolution, 9, {3});
+}
+
+TEST(testOptimalControlProblemHelperFunction, shiftDualSolutionAfterEvent) {
+  const auto primalSolution = getPrimalSolution({0.55, 0.65, 0.8, 0.95, 1.0}, {});
+  testShift(primalSolution, 6, {});
+}
+
+TEST(testOptimalControlProblemHelperFunction, shiftDualSolutionAtNode) {
+  const auto primalSolution = getPrimalSolution({0.0, 0.25, 0.5, 0.5, 0.75, 1.0}, {3});
+  testShift(primalSolution, 12, {6});
+}
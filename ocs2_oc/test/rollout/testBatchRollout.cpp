@@ -0,0 +1,134 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+using namespace ocs2;
+
+class BatchRolloutTest : public testing::TestWithParam<IntegratorType> {
+ protected:
+  static constexpr size_t nx = 2;
+  static constexpr size_t nu = 1;
+  static constexpr size_t numEnvironments = 13;
+  static constexpr scalar_t initTime = 0.0;
+  static constexpr scalar_t finalTime = 2.0;
+
+  BatchRolloutTest()
+      : systemDynamics((matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished(), (matrix_t(nx, nu) << 1.0, 0.0).finished()),
+        modeSchedule({0.5, 1.2, 1.2}, {0, 1, 2, 3}) {
+    rolloutSettings.timeStep = 7e-3;
+    rolloutSettings.integratorType = GetParam();
+
+    initStates = matrix_t::Random(nx, numEnvironments);
+
+    const scalar_array_t timeStamp{initTime, finalTime};
+    for (size_t m = 0; m < numEnvironments; m++) {
+      const vector_array_t uff(2, vector_t::Constant(nu, 0.1 * m));
+      const matrix_array_t k(2, matrix_t::Constant(nu, nx, -0.5));
+      controllers.emplace_back(timeStamp, uff, k);
+    }
+  }
+
+  /** Checks the trajectories of environment m against TimeTriggeredRollout */
+  void checkEnvironment(const BatchRollout::Trajectories& trajectories, size_t m, ControllerBase& controller) {
+    TimeTriggeredRollout rollout(systemDynamics, rolloutSettings);
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    auto modeScheduleCopy = modeSchedule;
+    rollout.run(initTime, initStates.col(m), finalTime, &controller, modeScheduleCopy, timeTrajectory, postEventIndices, stateTrajectory,
+                inputTrajectory);
+
+    ASSERT_EQ(trajectories.timeTrajectory.size(), timeTrajectory.size());
+    EXPECT_EQ(trajectories.postEventIndices, postEventIndices);
+    for (size_t k = 0; k < timeTrajectory.size(); k++) {
+      EXPECT_NEAR(trajectories.timeTrajectory[k], timeTrajectory[k], 1e-12);
+      EXPECT_TRUE(trajectories.stateTrajectories.col(m).segment(k * nx, nx).isApprox(stateTrajectory[k], 1e-9)) << "k: " << k;
+      EXPECT_TRUE(trajectories.inputTrajectories.col(m).segment(k * nu, nu).isApprox(inputTrajectory[k], 1e-9)) << "k: " << k;
+    }
+  }
+
+  LinearSystemDynamics systemDynamics;
+  ModeSchedule modeSchedule;
+  rollout::Settings rolloutSettings;
+  matrix_t initStates;
+  std::vector<LinearController> controllers;
+};
+
+constexpr size_t BatchRolloutTest::numEnvironments;
+constexpr scalar_t BatchRolloutTest::initTime;
+constexpr scalar_t BatchRolloutTest::finalTime;
+
+TEST_P(BatchRolloutTest, sharedPolicy) {
+  BatchRollout batchRollout(systemDynamics, rolloutSettings, 4);
+  BatchRollout::Trajectories trajectories;
+  batchRollout.run(initTime, initStates, finalTime, controllers.front(), modeSchedule, trajectories);
+
+  ASSERT_EQ(trajectories.stateTrajectories.rows(), nx * trajectories.timeTrajectory.size());
+  ASSERT_EQ(trajectories.stateTrajectories.cols(), numEnvironments);
+  ASSERT_EQ(trajectories.inputTrajectories.rows(), nu * trajectories.timeTrajectory.size());
+  for (size_t m = 0; m < numEnvironments; m++) {
+    checkEnvironment(trajectories, m, controllers.front());
+  }
+}
+
+TEST_P(BatchRolloutTest, environmentPolicies) {
+  std::vector<ControllerBase*> controllerPtrs;
+  for (auto& controller : controllers) {
+    controllerPtrs.push_back(&controller);
+  }
+
+  BatchRollout batchRollout(systemDynamics, rolloutSettings, 3);
+  BatchRollout::Trajectories trajectories;
+  batchRollout.run(initTime, initStates, finalTime, controllerPtrs, modeSchedule, trajectories);
+
+  for (size_t m = 0; m < numEnvironments; m++) {
+    checkEnvironment(trajectories, m, controllers[m]);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(BatchRolloutTestCase, BatchRolloutTest,
+                        testing::Values(IntegratorType::EULER_OCS2, IntegratorType::RK4_OCS2, IntegratorType::IMPLICIT_MIDPOINT_OCS2),
+                        [](const testing::TestParamInfo<BatchRolloutTest::ParamType>& info) {
+                          return integrator_type::toString(info.param);
+                        });
+
+TEST(BatchRolloutSettingsTest, adaptiveIntegrator) {
+  const LinearSystemDynamics systemDynamics(matrix_t::Zero(1, 1), matrix_t::Zero(1, 1));
+  rollout::Settings rolloutSettings;
+  rolloutSettings.integratorType = IntegratorType::ODE45;
+  EXPECT_THROW(BatchRollout(systemDynamics, rolloutSettings), std::runtime_error);
+}
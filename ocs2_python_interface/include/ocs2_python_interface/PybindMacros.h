@@ -29,14 +29,37 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <vector>
+
 #include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include <ocs2_core/Types.h>
+#include <ocs2_python_interface/PythonBatchService.h>
 
 using namespace pybind11::literals;
 
+namespace ocs2 {
+namespace python {
+
+/**
+ * Returns a (N, rows, cols) numpy view of a row-major (N, rows * cols) batch matrix without copying. The view keeps owner alive.
+ */
+template <typename Matrix>
+pybind11::array_t<scalar_t> batchMatrixView(const Matrix& batch, Eigen::Index rows, pybind11::handle owner) {
+  const Eigen::Index cols = rows > 0 ? batch.cols() / rows : 0;
+  const auto s = static_cast<pybind11::ssize_t>(sizeof(scalar_t));
+  const std::vector<pybind11::ssize_t> shape{batch.rows(), rows, cols};
+  const std::vector<pybind11::ssize_t> strides{batch.cols() * s, cols * s, s};
+  return pybind11::array_t<scalar_t>(shape, strides, batch.data(), owner);
+}
+
+}  // namespace python
+}  // namespace ocs2
+
 //! convenience macro to bind all kinds of std::vector-like types
 #define VECTOR_TYPE_BINDING(VTYPE, NAME)                                                    \
   pybind11::class_<VTYPE>(m, NAME)                                                          \
@@ -94,6 +117,36 @@ using namespace pybind11::literals;
         .def_readwrite("dfdxx", &ocs2::ScalarFunctionQuadraticApproximation::dfdxx)                                                        \
         .def_readwrite("dfdux", &ocs2::ScalarFunctionQuadraticApproximation::dfdux)                                                        \
         .def_readwrite("dfduu", &ocs2::ScalarFunctionQuadraticApproximation::dfduu);                                                       \
+    /* bind batch approximation classes, the matrices are exposed as (N, rows, cols) views */                                              \
+    pybind11::class_<PY_INTERFACE::BatchLinearApproximation>(m, "BatchLinearApproximation")                                                \
+        .def_readonly("f", &PY_INTERFACE::BatchLinearApproximation::f)                                                                     \
+        .def_property_readonly("dfdx",                                                                                                     \
+                               [](pybind11::object self) {                                                                                 \
+                                 const auto& a = self.cast<const PY_INTERFACE::BatchLinearApproximation&>();                               \
+                                 return ocs2::python::batchMatrixView(a.dfdx, a.f.cols(), self);                                           \
+                               })                                                                                                          \
+        .def_property_readonly("dfdu", [](pybind11::object self) {                                                                         \
+          const auto& a = self.cast<const PY_INTERFACE::BatchLinearApproximation&>();                                                      \
+          return ocs2::python::batchMatrixView(a.dfdu, a.f.cols(), self);                                                                  \
+        });                                                                                                                                \
+    pybind11::class_<PY_INTERFACE::BatchQuadraticApproximation>(m, "BatchQuadraticApproximation")                                          \
+        .def_readonly("f", &PY_INTERFACE::BatchQuadraticApproximation::f)                                                                  \
+        .def_readonly("dfdx", &PY_INTERFACE::BatchQuadraticApproximation::dfdx)                                                            \
+        .def_readonly("dfdu", &PY_INTERFACE::BatchQuadraticApproximation::dfdu)                                                            \
+        .def_property_readonly("dfdxx",                                                                                                    \
+                               [](pybind11::object self) {                                                                                 \
+                                 const auto& a = self.cast<const PY_INTERFACE::BatchQuadraticApproximation&>();                            \
+                                 return ocs2::python::batchMatrixView(a.dfdxx, a.dfdx.cols(), self);                                       \
+                               })                                                                                                          \
+        .def_property_readonly("dfdux",                                                                                                    \
+                               [](pybind11::object self) {                                                                                 \
+                                 const auto& a = self.cast<const PY_INTERFACE::BatchQuadraticApproximation&>();                            \
+                                 return ocs2::python::batchMatrixView(a.dfdux, a.dfdu.cols(), self);                                       \
+                               })                                                                                                          \
+        .def_property_readonly("dfduu", [](pybind11::object self) {                                                                        \
+          const auto& a = self.cast<const PY_INTERFACE::BatchQuadraticApproximation&>();                                                   \
+          return ocs2::python::batchMatrixView(a.dfduu, a.dfdu.cols(), self);                                                              \
+        });                                                                                                                                \
     /* bind TargetTrajectories class */                                                                                                    \
     pybind11::class_<ocs2::TargetTrajectories>(m, "TargetTrajectories")                                                                    \
         .def(pybind11::init<ocs2::scalar_array_t, ocs2::vector_array_t, ocs2::vector_array_t>());                                          \
@@ -103,22 +156,75 @@ using namespace pybind11::literals;
         .def("getStateDim", &PY_INTERFACE::getStateDim)                                                                                    \
         .def("getInputDim", &PY_INTERFACE::getInputDim)                                                                                    \
         .def("setObservation", &PY_INTERFACE::setObservation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                 \
-        .def("setTargetTrajectories", &PY_INTERFACE::setTargetTrajectories, "targetTrajectories"_a)                                        \
-        .def("reset", &PY_INTERFACE::reset, "targetTrajectories"_a)                                                                        \
-        .def("advanceMpc", &PY_INTERFACE::advanceMpc)                                                                                      \
-        .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert())                     \
-        .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert())                                             \
-        .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                               \
-        .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
-        .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())                                                     \
-        .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())         \
-        .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert())                                                      \
-        .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert())                        \
-        .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert())     \
+        .def("setTargetTrajectories", &PY_INTERFACE::setTargetTrajectories, "targetTrajectories"_a,                                        \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("reset", &PY_INTERFACE::reset, "targetTrajectories"_a, pybind11::call_guard<pybind11::gil_scoped_release>())                  \
+        .def("advanceMpc", &PY_INTERFACE::advanceMpc, pybind11::call_guard<pybind11::gil_scoped_release>())                                \
+        .def("getMpcSolution", &PY_INTERFACE::getMpcSolution, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(),                     \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("getMpcSolutionArrays", &PY_INTERFACE::getMpcSolutionArrays, pybind11::call_guard<pybind11::gil_scoped_release>())            \
+        .def("getLinearFeedbackGain", &PY_INTERFACE::getLinearFeedbackGain, "t"_a.noconvert(),                                             \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("flowMap", &PY_INTERFACE::flowMap, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),                                               \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("flowMapLinearApproximation", &PY_INTERFACE::flowMapLinearApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),         \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("cost", &PY_INTERFACE::cost, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),                                                     \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("costQuadraticApproximation", &PY_INTERFACE::costQuadraticApproximation, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),         \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("valueFunction", &PY_INTERFACE::valueFunction, "t"_a, "x"_a.noconvert(),                                                      \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("valueFunctionStateDerivative", &PY_INTERFACE::valueFunctionStateDerivative, "t"_a, "x"_a.noconvert(),                        \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("stateInputEqualityConstraint", &PY_INTERFACE::stateInputEqualityConstraint, "t"_a, "x"_a.noconvert(), "u"_a.noconvert(),     \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
         .def("stateInputEqualityConstraintLinearApproximation", &PY_INTERFACE::stateInputEqualityConstraintLinearApproximation, "t"_a,     \
-             "x"_a.noconvert(), "u"_a.noconvert())                                                                                         \
+             "x"_a.noconvert(), "u"_a.noconvert(), pybind11::call_guard<pybind11::gil_scoped_release>())                                   \
         .def("stateInputEqualityConstraintLagrangian", &PY_INTERFACE::stateInputEqualityConstraintLagrangian, "t"_a, "x"_a.noconvert(),    \
-             "u"_a.noconvert())                                                                                                            \
+             "u"_a.noconvert(), pybind11::call_guard<pybind11::gil_scoped_release>())                                                      \
+        .def("setNumBatchThreads", &PY_INTERFACE::setNumBatchThreads, "numThreads"_a,                                                      \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("flowMapBatch", &PY_INTERFACE::flowMapBatch, "t"_a, "x"_a, "u"_a, pybind11::call_guard<pybind11::gil_scoped_release>())       \
+        .def("flowMapLinearApproximationBatch", &PY_INTERFACE::flowMapLinearApproximationBatch, "t"_a, "x"_a, "u"_a,                       \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("costBatch", &PY_INTERFACE::costBatch, "t"_a, "x"_a, "u"_a, pybind11::call_guard<pybind11::gil_scoped_release>())             \
+        .def("costQuadraticApproximationBatch", &PY_INTERFACE::costQuadraticApproximationBatch, "t"_a, "x"_a, "u"_a,                       \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def("valueFunctionBatch", &PY_INTERFACE::valueFunctionBatch, "t"_a, "x"_a, pybind11::call_guard<pybind11::gil_scoped_release>())  \
+        .def("valueFunctionStateDerivativeBatch", &PY_INTERFACE::valueFunctionStateDerivativeBatch, "t"_a, "x"_a,                          \
+             pybind11::call_guard<pybind11::gil_scoped_release>())                                                                         \
+        .def(                                                                                                                              \
+            "rolloutBatch",                                                                                                                \
+            [](PY_INTERFACE& self, ocs2::scalar_t t, Eigen::Ref<const PY_INTERFACE::row_matrix_t> x, ocs2::scalar_t finalTime,             \
+               ocs2::scalar_t timeStep) {                                                                                                  \
+              auto result = [&] {                                                                                                          \
+                pybind11::gil_scoped_release release;                                                                                      \
+                return self.rolloutBatch(t, x, finalTime, timeStep);                                                                       \
+              }();                                                                                                                         \
+              /* the moved column-major trajectories are transposed to (M, K*n) row-major views without copying */                         \
+              pybind11::object states = pybind11::cast(std::move(std::get<1>(result)));                                                    \
+              pybind11::object inputs = pybind11::cast(std::move(std::get<2>(result)));                                                    \
+              return pybind11::make_tuple(std::move(std::get<0>(result)), states.attr("T"), inputs.attr("T"));                             \
+            },                                                                                                                             \
+            "t"_a, "x"_a, "finalTime"_a, "timeStep"_a)                                                                                     \
         .def("visualizeTrajectory", &PY_INTERFACE::visualizeTrajectory, "t"_a.noconvert(), "x"_a.noconvert(), "u"_a.noconvert(),           \
              "speed"_a);                                                                                                                   \
+    /* bind the batch service which advances the MPCs of several mpc_interface instances on one thread pool */                             \
+    pybind11::class_<ocs2::MPC_BatchService::Status>(m, "MpcBatchStatus", pybind11::module_local())                                        \
+        .def_readonly("isSkipped", &ocs2::MPC_BatchService::Status::isSkipped)                                                             \
+        .def_readonly("isDeadlineMissed", &ocs2::MPC_BatchService::Status::isDeadlineMissed)                                               \
+        .def_readonly("solveTime", &ocs2::MPC_BatchService::Status::solveTime);                                                            \
+    pybind11::class_<ocs2::PythonBatchService>(m, "mpc_batch_service", pybind11::module_local())                                           \
+        .def(pybind11::init<size_t>(), "numThreads"_a)                                                                                     \
+        .def(                                                                                                                              \
+            "addInstance",                                                                                                                 \
+            [](ocs2::PythonBatchService& self, PY_INTERFACE& mpcInterface, ocs2::scalar_t deadline) {                                      \
+              return self.addInstance(mpcInterface, deadline);                                                                             \
+            },                                                                                                                             \
+            "mpcInterface"_a, "deadline"_a = std::numeric_limits<ocs2::scalar_t>::infinity(), pybind11::keep_alive<1, 2>())                \
+        .def("numInstances", &ocs2::PythonBatchService::numInstances)                                                                      \
+        .def("setDeadline", &ocs2::PythonBatchService::setDeadline, "instanceId"_a, "deadline"_a)                                          \
+        .def("advanceMpc", &ocs2::PythonBatchService::advanceMpc, pybind11::call_guard<pybind11::gil_scoped_release>())                    \
+        .def("getStatus", &ocs2::PythonBatchService::getStatus, "instanceId"_a);                                                           \
   }
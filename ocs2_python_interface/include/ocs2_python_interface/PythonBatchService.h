@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <ocs2_mpc/MPC_BatchService.h>
+
+#include "ocs2_python_interface/PythonInterface.h"
+
+namespace ocs2 {
+
+/**
+ * Python interface of MPC_BatchService, which advances the MPCs of several PythonInterface instances on one thread pool.
+ * While the instances are advanced, the other calls on these instances wait as for PythonInterface::advanceMpc().
+ */
+class PythonBatchService {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] numThreads: The number of threads used to run the instances, including the calling thread.
+   */
+  explicit PythonBatchService(size_t numThreads) : service_(numThreads) {}
+
+  /**
+   * Registers the MPC of a PythonInterface. The service does not take the ownership of the interface.
+   *
+   * @param [in] mpcInterface: The Python interface whose MPC is advanced by the service. It can only be registered once.
+   * @param [in] deadline: The deadline [s] of this instance, measured from the start of each advanceMpc() call.
+   * @return The ID of the instance.
+   */
+  size_t addInstance(PythonInterface& mpcInterface, scalar_t deadline = std::numeric_limits<scalar_t>::infinity());
+
+  /** Gets the number of registered instances. */
+  size_t numInstances() const { return service_.numInstances(); }
+
+  /** Sets the deadline [s] of an instance, measured from the start of each advanceMpc() call. */
+  void setDeadline(size_t instanceId, scalar_t deadline) { service_.setDeadline(instanceId, deadline); }
+
+  /**
+   * Advances the MPCs of all the instances for one iteration. The observations are set through PythonInterface::setObservation().
+   * @note The Python binding releases the GIL during the call.
+   */
+  void advanceMpc();
+
+  /** Gets the status of an instance in the latest advanceMpc() call. */
+  MPC_BatchService::Status getStatus(size_t instanceId) const { return service_.getStatus(instanceId); }
+
+ private:
+  MPC_BatchService service_;
+  std::vector<PythonInterface*> instances_;  // sorted by address, which is the order in which their mutexes are locked
+};
+
+}  // namespace ocs2
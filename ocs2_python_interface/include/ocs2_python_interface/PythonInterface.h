@@ -29,10 +29,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
 #include <ocs2_core/dynamics/SystemDynamicsBase.h>
 #include <ocs2_core/penalties/penalties/PenaltyBase.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 
 namespace ocs2 {
@@ -42,6 +50,27 @@ namespace ocs2 {
  * to the MPC_MRT_Interface to be used for Python bindings
  */
 class PythonInterface {
+ public:
+  /** Row-major matrix which holds one sample per row, i.e. it maps to a C-contiguous (N, n) numpy array. */
+  using row_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /** Linear approximations of a batch. The Jacobians of the i-th sample are stored row-major in the i-th row, e.g. dfdx is (N, nf * nx). */
+  struct BatchLinearApproximation {
+    row_matrix_t f;
+    row_matrix_t dfdx;
+    row_matrix_t dfdu;
+  };
+
+  /** Quadratic approximations of a batch. The matrices of the i-th sample are stored row-major in its row, e.g. dfdxx is (N, nx*nx). */
+  struct BatchQuadraticApproximation {
+    vector_t f;
+    row_matrix_t dfdx;
+    row_matrix_t dfdu;
+    row_matrix_t dfdxx;
+    row_matrix_t dfdux;
+    row_matrix_t dfduu;
+  };
+
  protected:
   /** Constructor */
   PythonInterface() = default;
@@ -95,6 +124,8 @@ class PythonInterface {
   /**
    * @brief run MPC
    * @note This call is blocking in synchronous mode
+   * @note The Python binding releases the GIL during the solve. The calls which read the solver, the reference or the batch
+   *       resources wait until the solve is finished.
    */
   void advanceMpc();
 
@@ -106,6 +137,12 @@ class PythonInterface {
    */
   void getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u);
 
+  /**
+   * @brief Obtain the full MPC solution as contiguous arrays
+   * @return The tuple of time (N), state (N, nx) and input (N, nu) arrays
+   */
+  std::tuple<vector_t, row_matrix_t, row_matrix_t> getMpcSolutionArrays();
+
   /**
    * @brief Obtains feedback gain matrix, if the underlying MPC algorithm computes it
    * @param[in] t: Query time
@@ -169,6 +206,44 @@ class PythonInterface {
    */
   vector_t stateInputEqualityConstraintLagrangian(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u);
 
+  /**
+   * @brief Sets the number of threads used by the batch evaluations. Each thread evaluates a clone of the optimal control problem.
+   * @param[in] numThreads: The number of threads including the calling one.
+   */
+  void setNumBatchThreads(size_t numThreads);
+
+  /** Batched flowMap, returns (N, nx) */
+  row_matrix_t flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /** Batched flowMapLinearApproximation */
+  BatchLinearApproximation flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                           Eigen::Ref<const row_matrix_t> u);
+
+  /** Batched cost, returns (N) */
+  vector_t costBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u);
+
+  /** Batched costQuadraticApproximation */
+  BatchQuadraticApproximation costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                              Eigen::Ref<const row_matrix_t> u);
+
+  /** Batched valueFunction, returns (N) */
+  vector_t valueFunctionBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x);
+
+  /** Batched valueFunctionStateDerivative, returns (N, nx) */
+  row_matrix_t valueFunctionStateDerivativeBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x);
+
+  /**
+   * @brief Rolls out a batch of environments with the current MPC policy and a fixed-step RK4 integrator, @see BatchRollout.
+   * @param[in] t: Initial time.
+   * @param[in] x: Initial states (M, nx).
+   * @param[in] finalTime: Final time.
+   * @param[in] timeStep: Integration time step.
+   * @return The tuple of time (K), state (nx*K, M) and input (nu*K, M) trajectories, where column m holds environment m. Their
+   *         transposes are the row-major (M, K*nx) and (M, K*nu) arrays, which the Python binding returns without copying.
+   */
+  std::tuple<vector_t, matrix_t, matrix_t> rolloutBatch(scalar_t t, Eigen::Ref<const row_matrix_t> x, scalar_t finalTime,
+                                                        scalar_t timeStep);
+
   /**
    * @brief Visualize the time-state-input trajectory
    * @param[in] t Array of times
@@ -186,11 +261,39 @@ class PythonInterface {
   int inputDim_ = -1;  // -1 indicates that it is not initialized
 
  private:
+  friend class PythonBatchService;
+
+  /** Cost function with added penalty term, evaluated on the given problem */
+  scalar_t cost(OptimalControlProblem& problem, scalar_t t, const vector_t& x, const vector_t& u);
+
+  /** Cost function quadratic approximation with added penalty term, evaluated on the given problem */
+  ScalarFunctionQuadraticApproximation costQuadraticApproximation(OptimalControlProblem& problem, scalar_t t, const vector_t& x,
+                                                                  const vector_t& u);
+
+  /** Linear approximation of the state-input equality constraints, evaluated on the given problem */
+  VectorFunctionLinearApproximation stateInputEqualityConstraintLinearApproximation(OptimalControlProblem& problem, scalar_t t,
+                                                                                    const vector_t& x, const vector_t& u);
+
+  /**
+   * Evaluates sampleTask(problem, i) for i in [0, numSamples) on the batch threads, where problem is the clone of the thread.
+   */
+  void runBatch(size_t numSamples, const std::function<void(OptimalControlProblem&, size_t)>& sampleTask);
+
+  /**
+   * Serializes the access to the solver, the target trajectories and the batch resources. Every binding of a method which locks it
+   * releases the GIL first, such that a Python thread waiting for the lock does not stall the others during a solve.
+   */
+  std::mutex mutex_;
+
   std::unique_ptr<MPC_BASE> mpcPtr_;
   std::unique_ptr<MPC_MRT_Interface> mpcMrtInterface_;
 
   TargetTrajectories targetTrajectories_;
   OptimalControlProblem problem_;
+
+  std::unique_ptr<ThreadPool> batchThreadPoolPtr_;
+  std::vector<OptimalControlProblem> batchProblemStock_;
+  std::unique_ptr<BatchRollout> batchRolloutPtr_;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,63 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_python_interface/PythonBatchService.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t PythonBatchService::addInstance(PythonInterface& mpcInterface, scalar_t deadline) {
+  const auto it = std::lower_bound(instances_.begin(), instances_.end(), &mpcInterface);
+  if (it != instances_.end() && *it == &mpcInterface) {
+    throw std::runtime_error("[PythonBatchService] The interface is already registered!");
+  }
+  instances_.insert(it, &mpcInterface);
+  return service_.addInstance(*mpcInterface.mpcMrtInterface_, deadline);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonBatchService::advanceMpc() {
+  // the mutexes are locked in a fixed order, such that two services which share instances do not deadlock
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(instances_.size());
+  for (auto* instancePtr : instances_) {
+    locks.emplace_back(instancePtr->mutex_);
+  }
+  service_.advanceMpc();
+}
+
+}  // namespace ocs2
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_python_interface/PythonInterface.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
 
@@ -48,12 +51,15 @@ void PythonInterface::init(const RobotInterface& robot, std::unique_ptr<MPC_BASE
   mpcMrtInterface_.reset(new MPC_MRT_Interface(*mpcPtr_));
 
   problem_ = robot.getOptimalControlProblem();
+  problem_.targetTrajectoriesPtr = &targetTrajectories_;
+  setNumBatchThreads(1);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::reset(TargetTrajectories targetTrajectories) {
+  std::lock_guard<std::mutex> lock(mutex_);
   targetTrajectories_ = std::move(targetTrajectories);
   mpcMrtInterface_->resetMpcNode(targetTrajectories_);
   problem_.targetTrajectoriesPtr = &targetTrajectories_;
@@ -74,6 +80,7 @@ void PythonInterface::setObservation(scalar_t t, Eigen::Ref<const vector_t> x, E
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::setTargetTrajectories(TargetTrajectories targetTrajectories) {
+  std::lock_guard<std::mutex> lock(mutex_);
   targetTrajectories_ = std::move(targetTrajectories);
   problem_.targetTrajectoriesPtr = &targetTrajectories_;
   mpcMrtInterface_->getReferenceManager().setTargetTrajectories(targetTrajectories_);
@@ -83,6 +90,7 @@ void PythonInterface::setTargetTrajectories(TargetTrajectories targetTrajectorie
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::advanceMpc() {
+  std::lock_guard<std::mutex> lock(mutex_);
   mpcMrtInterface_->advanceMpc();
 }
 
@@ -90,16 +98,40 @@ void PythonInterface::advanceMpc() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void PythonInterface::getMpcSolution(scalar_array_t& t, vector_array_t& x, vector_array_t& u) {
+  std::lock_guard<std::mutex> lock(mutex_);
   mpcMrtInterface_->updatePolicy();
   t = mpcMrtInterface_->getPolicy().timeTrajectory_;
   x = mpcMrtInterface_->getPolicy().stateTrajectory_;
   u = mpcMrtInterface_->getPolicy().inputTrajectory_;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::tuple<vector_t, PythonInterface::row_matrix_t, PythonInterface::row_matrix_t> PythonInterface::getMpcSolutionArrays() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  mpcMrtInterface_->updatePolicy();
+  const auto& policy = mpcMrtInterface_->getPolicy();
+  const size_t N = policy.timeTrajectory_.size();
+  const size_t nx = N > 0 ? policy.stateTrajectory_.front().size() : 0;
+  const size_t nu = N > 0 ? policy.inputTrajectory_.front().size() : 0;
+
+  vector_t t(N);
+  row_matrix_t x(N, nx);
+  row_matrix_t u(N, nu);
+  for (size_t i = 0; i < N; i++) {
+    t(i) = policy.timeTrajectory_[i];
+    x.row(i) = policy.stateTrajectory_[i].transpose();
+    u.row(i) = policy.inputTrajectory_[i].transpose();
+  }
+  return std::make_tuple(std::move(t), std::move(x), std::move(u));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t PythonInterface::getLinearFeedbackGain(scalar_t time) {
+  std::lock_guard<std::mutex> lock(mutex_);
   return mpcMrtInterface_->getLinearFeedbackGain(time);
 }
 
@@ -107,6 +139,7 @@ matrix_t PythonInterface::getLinearFeedbackGain(scalar_t time) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t PythonInterface::flowMap(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
   return problem_.dynamicsPtr->computeFlowMap(t, x, u);
 }
 
@@ -115,6 +148,7 @@ vector_t PythonInterface::flowMap(scalar_t t, Eigen::Ref<const vector_t> x, Eige
 /******************************************************************************************************/
 VectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
                                                                               Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
   return problem_.dynamicsPtr->linearApproximation(t, x, u);
 }
 
@@ -122,26 +156,34 @@ VectorFunctionLinearApproximation PythonInterface::flowMapLinearApproximation(sc
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
-  auto& preComputation = *problem_.preComputationPtr;
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cost(problem_, t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t PythonInterface::cost(OptimalControlProblem& problem, scalar_t t, const vector_t& x, const vector_t& u) {
+  auto& preComputation = *problem.preComputationPtr;
   const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
   preComputation.request(request, t, x, u);
 
   // cost
-  scalar_t cost = computeCost(problem_, t, x, u);
+  scalar_t cost = computeCost(problem, t, x, u);
 
   // Lagrangians
   const auto m = mpcMrtInterface_->getIntermediateDualSolution(t);
-  if (!problem_.stateEqualityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
+  if (!problem.stateEqualityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateEqualityLagrangianPtr->getValue(t, x, m.stateEq, preComputation));
   }
-  if (!problem_.stateInequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
+  if (!problem.stateInequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.stateInequalityLagrangianPtr->getValue(t, x, m.stateIneq, preComputation));
   }
-  if (!problem_.equalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
+  if (!problem.equalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.equalityLagrangianPtr->getValue(t, x, u, m.stateInputEq, preComputation));
   }
-  if (!problem_.inequalityLagrangianPtr->empty()) {
-    cost += sumPenalties(problem_.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
+  if (!problem.inequalityLagrangianPtr->empty()) {
+    cost += sumPenalties(problem.inequalityLagrangianPtr->getValue(t, x, u, m.stateInputIneq, preComputation));
   }
 
   return cost;
@@ -152,32 +194,41 @@ scalar_t PythonInterface::cost(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
                                                                                  Eigen::Ref<const vector_t> u) {
-  auto& preComputation = *problem_.preComputationPtr;
+  std::lock_guard<std::mutex> lock(mutex_);
+  return costQuadraticApproximation(problem_, t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation(OptimalControlProblem& problem, scalar_t t,
+                                                                                 const vector_t& x, const vector_t& u) {
+  auto& preComputation = *problem.preComputationPtr;
   const auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   preComputation.request(request, t, x, u);
 
   // cost
-  auto cost = approximateCost(problem_, t, x, u);
+  auto cost = approximateCost(problem, t, x, u);
 
   // Lagrangians
   const auto m = mpcMrtInterface_->getIntermediateDualSolution(t);
-  if (!problem_.stateEqualityLagrangianPtr->empty()) {
-    auto approx = problem_.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, m.stateEq, preComputation);
+  if (!problem.stateEqualityLagrangianPtr->empty()) {
+    auto approx = problem.stateEqualityLagrangianPtr->getQuadraticApproximation(t, x, m.stateEq, preComputation);
     cost.f += approx.f;
     cost.dfdx += approx.dfdx;
     cost.dfdxx += approx.dfdxx;
   }
-  if (!problem_.stateInequalityLagrangianPtr->empty()) {
-    auto approx = problem_.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, m.stateIneq, preComputation);
+  if (!problem.stateInequalityLagrangianPtr->empty()) {
+    auto approx = problem.stateInequalityLagrangianPtr->getQuadraticApproximation(t, x, m.stateIneq, preComputation);
     cost.f += approx.f;
     cost.dfdx += approx.dfdx;
     cost.dfdxx += approx.dfdxx;
   }
-  if (!problem_.equalityLagrangianPtr->empty()) {
-    cost += problem_.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputEq, preComputation);
+  if (!problem.equalityLagrangianPtr->empty()) {
+    cost += problem.equalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputEq, preComputation);
   }
-  if (!problem_.inequalityLagrangianPtr->empty()) {
-    cost += problem_.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputIneq, preComputation);
+  if (!problem.inequalityLagrangianPtr->empty()) {
+    cost += problem.inequalityLagrangianPtr->getQuadraticApproximation(t, x, u, m.stateInputIneq, preComputation);
   }
 
   return cost;
@@ -187,6 +238,7 @@ ScalarFunctionQuadraticApproximation PythonInterface::costQuadraticApproximation
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t PythonInterface::valueFunction(scalar_t t, Eigen::Ref<const vector_t> x) {
+  std::lock_guard<std::mutex> lock(mutex_);
   return mpcMrtInterface_->getValueFunction(t, x).f;
 }
 
@@ -194,13 +246,196 @@ scalar_t PythonInterface::valueFunction(scalar_t t, Eigen::Ref<const vector_t> x
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t PythonInterface::valueFunctionStateDerivative(scalar_t t, Eigen::Ref<const vector_t> x) {
+  std::lock_guard<std::mutex> lock(mutex_);
   return mpcMrtInterface_->getValueFunction(t, x).dfdx;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::setNumBatchThreads(size_t numThreads) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  numThreads = std::max<size_t>(numThreads, 1);
+  batchThreadPoolPtr_.reset(new ThreadPool(numThreads - 1));
+  batchProblemStock_.clear();
+  batchProblemStock_.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; i++) {
+    batchProblemStock_.push_back(problem_);
+  }
+  batchRolloutPtr_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PythonInterface::runBatch(size_t numSamples, const std::function<void(OptimalControlProblem&, size_t)>& sampleTask) {
+  std::atomic_size_t nextSample{0};
+  auto task = [&](int workerId) {
+    auto& problem = batchProblemStock_[workerId];
+    size_t i = nextSample++;
+    while (i < numSamples) {
+      sampleTask(problem, i);
+      i = nextSample++;
+    }
+  };
+  const size_t numTasks = std::max<size_t>(std::min(batchProblemStock_.size(), numSamples), 1);
+  batchThreadPoolPtr_->runParallel(task, static_cast<int>(numTasks));
+}
+
+namespace {
+void checkBatchSize(Eigen::Index numSamples, Eigen::Index rows, const std::string& name) {
+  if (rows != numSamples) {
+    throw std::runtime_error("[PythonInterface] " + name + " has " + std::to_string(rows) + " rows but the batch has " +
+                             std::to_string(numSamples) + " samples.");
+  }
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PythonInterface::row_matrix_t PythonInterface::flowMapBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x,
+                                                            Eigen::Ref<const row_matrix_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  checkBatchSize(t.size(), x.rows(), "x");
+  checkBatchSize(t.size(), u.rows(), "u");
+
+  row_matrix_t dxdt(t.size(), x.cols());
+  runBatch(t.size(), [&](OptimalControlProblem& problem, size_t i) {
+    dxdt.row(i) = problem.dynamicsPtr->computeFlowMap(t(i), x.row(i).transpose(), u.row(i).transpose()).transpose();
+  });
+  return dxdt;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PythonInterface::BatchLinearApproximation PythonInterface::flowMapLinearApproximationBatch(Eigen::Ref<const vector_t> t,
+                                                                                          Eigen::Ref<const row_matrix_t> x,
+                                                                                          Eigen::Ref<const row_matrix_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  checkBatchSize(t.size(), x.rows(), "x");
+  checkBatchSize(t.size(), u.rows(), "u");
+
+  const auto nx = x.cols();
+  const auto nu = u.cols();
+  BatchLinearApproximation batch;
+  batch.f.resize(t.size(), nx);
+  batch.dfdx.resize(t.size(), nx * nx);
+  batch.dfdu.resize(t.size(), nx * nu);
+  runBatch(t.size(), [&](OptimalControlProblem& problem, size_t i) {
+    const auto approx = problem.dynamicsPtr->linearApproximation(t(i), x.row(i).transpose(), u.row(i).transpose());
+    batch.f.row(i) = approx.f.transpose();
+    Eigen::Map<row_matrix_t>(batch.dfdx.row(i).data(), nx, nx) = approx.dfdx;
+    Eigen::Map<row_matrix_t>(batch.dfdu.row(i).data(), nx, nu) = approx.dfdu;
+  });
+  return batch;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t PythonInterface::costBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x, Eigen::Ref<const row_matrix_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  checkBatchSize(t.size(), x.rows(), "x");
+  checkBatchSize(t.size(), u.rows(), "u");
+
+  vector_t L(t.size());
+  runBatch(t.size(), [&](OptimalControlProblem& problem, size_t i) {
+    L(i) = cost(problem, t(i), x.row(i).transpose(), u.row(i).transpose());
+  });
+  return L;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PythonInterface::BatchQuadraticApproximation PythonInterface::costQuadraticApproximationBatch(Eigen::Ref<const vector_t> t,
+                                                                                              Eigen::Ref<const row_matrix_t> x,
+                                                                                              Eigen::Ref<const row_matrix_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  checkBatchSize(t.size(), x.rows(), "x");
+  checkBatchSize(t.size(), u.rows(), "u");
+
+  const auto nx = x.cols();
+  const auto nu = u.cols();
+  BatchQuadraticApproximation batch;
+  batch.f.resize(t.size());
+  batch.dfdx.resize(t.size(), nx);
+  batch.dfdu.resize(t.size(), nu);
+  batch.dfdxx.resize(t.size(), nx * nx);
+  batch.dfdux.resize(t.size(), nu * nx);
+  batch.dfduu.resize(t.size(), nu * nu);
+  runBatch(t.size(), [&](OptimalControlProblem& problem, size_t i) {
+    const auto approx = costQuadraticApproximation(problem, t(i), x.row(i).transpose(), u.row(i).transpose());
+    batch.f(i) = approx.f;
+    batch.dfdx.row(i) = approx.dfdx.transpose();
+    batch.dfdu.row(i) = approx.dfdu.transpose();
+    Eigen::Map<row_matrix_t>(batch.dfdxx.row(i).data(), nx, nx) = approx.dfdxx;
+    Eigen::Map<row_matrix_t>(batch.dfdux.row(i).data(), nu, nx) = approx.dfdux;
+    Eigen::Map<row_matrix_t>(batch.dfduu.row(i).data(), nu, nu) = approx.dfduu;
+  });
+  return batch;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t PythonInterface::valueFunctionBatch(Eigen::Ref<const vector_t> t, Eigen::Ref<const row_matrix_t> x) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  checkBatchSize(t.size(), x.rows(), "x");
+
+  vector_t V(t.size());
+  runBatch(t.size(), [&](OptimalControlProblem&, size_t i) { V(i) = mpcMrtInterface_->getValueFunction(t(i), x.row(i).transpose()).f; });
+  return V;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PythonInterface::row_matrix_t PythonInterface::valueFunctionStateDerivativeBatch(Eigen::Ref<const vector_t> t,
+                                                                                 Eigen::Ref<const row_matrix_t> x) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  checkBatchSize(t.size(), x.rows(), "x");
+
+  row_matrix_t dVdx(t.size(), x.cols());
+  runBatch(t.size(), [&](OptimalControlProblem&, size_t i) {
+    dVdx.row(i) = mpcMrtInterface_->getValueFunction(t(i), x.row(i).transpose()).dfdx.transpose();
+  });
+  return dVdx;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::tuple<vector_t, matrix_t, matrix_t> PythonInterface::rolloutBatch(scalar_t t, Eigen::Ref<const row_matrix_t> x, scalar_t finalTime,
+                                                                       scalar_t timeStep) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  mpcMrtInterface_->updatePolicy();
+  const auto& policy = mpcMrtInterface_->getPolicy();
+  if (policy.controllerPtr_ == nullptr) {
+    throw std::runtime_error("[PythonInterface::rolloutBatch] The MPC policy is not available.");
+  }
+
+  if (batchRolloutPtr_ == nullptr || batchRolloutPtr_->settings().timeStep != timeStep) {
+    rollout::Settings rolloutSettings;
+    rolloutSettings.integratorType = IntegratorType::RK4_OCS2;
+    rolloutSettings.timeStep = timeStep;
+    batchRolloutPtr_.reset(new BatchRollout(*problem_.dynamicsPtr, rolloutSettings, batchProblemStock_.size()));
+  }
+
+  BatchRollout::Trajectories trajectories;
+  batchRolloutPtr_->run(t, x.transpose(), finalTime, *policy.controllerPtr_, policy.modeSchedule_, trajectories);
+
+  vector_t time = Eigen::Map<const vector_t>(trajectories.timeTrajectory.data(), trajectories.timeTrajectory.size());
+  return std::make_tuple(std::move(time), std::move(trajectories.stateTrajectories), std::move(trajectories.inputTrajectories));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t PythonInterface::stateInputEqualityConstraint(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
   problem_.preComputationPtr->request(Request::Constraint, t, x, u);
   return problem_.equalityConstraintPtr->getValue(t, x, u, *problem_.preComputationPtr);
 }
@@ -210,32 +445,43 @@ vector_t PythonInterface::stateInputEqualityConstraint(scalar_t t, Eigen::Ref<co
 /******************************************************************************************************/
 VectorFunctionLinearApproximation PythonInterface::stateInputEqualityConstraintLinearApproximation(scalar_t t, Eigen::Ref<const vector_t> x,
                                                                                                    Eigen::Ref<const vector_t> u) {
-  problem_.preComputationPtr->request(Request::Constraint + Request::Approximation, t, x, u);
-  return problem_.equalityConstraintPtr->getLinearApproximation(t, x, u, *problem_.preComputationPtr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stateInputEqualityConstraintLinearApproximation(problem_, t, x, u);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation PythonInterface::stateInputEqualityConstraintLinearApproximation(OptimalControlProblem& problem,
+                                                                                                   scalar_t t, const vector_t& x,
+                                                                                                   const vector_t& u) {
+  problem.preComputationPtr->request(Request::Constraint + Request::Approximation, t, x, u);
+  return problem.equalityConstraintPtr->getLinearApproximation(t, x, u, *problem.preComputationPtr);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t PythonInterface::stateInputEqualityConstraintLagrangian(scalar_t t, Eigen::Ref<const vector_t> x, Eigen::Ref<const vector_t> u) {
+  std::lock_guard<std::mutex> lock(mutex_);
   vector_t zero_u = vector_t::Zero(u.rows());
 
-  const auto g = stateInputEqualityConstraintLinearApproximation(t, x, zero_u);
+  const auto g = stateInputEqualityConstraintLinearApproximation(problem_, t, x, zero_u);
   const matrix_t& Dm = g.dfdu;
   const vector_t& c = g.f;
 
-  const auto Phi = costQuadraticApproximation(t, x, zero_u);
+  const auto Phi = costQuadraticApproximation(problem_, t, x, zero_u);
   const matrix_t& R = Phi.dfduu;
   const vector_t& r = Phi.dfdu;
 
-  const matrix_t B = flowMapLinearApproximation(t, x, zero_u).dfdu;
+  const matrix_t B = problem_.dynamicsPtr->linearApproximation(t, x, zero_u).dfdu;
 
   matrix_t RinvChol;
   LinearAlgebra::computeInverseMatrixUUT(R, RinvChol);
   matrix_t DmDager, DdaggerT_R_Ddagger_Chol, RmInvConstrainedChol;
   ocs2::LinearAlgebra::computeConstraintProjection(Dm, RinvChol, DmDager, DdaggerT_R_Ddagger_Chol, RmInvConstrainedChol);
 
-  vector_t costate = valueFunctionStateDerivative(t, x);
+  vector_t costate = mpcMrtInterface_->getValueFunction(t, x).dfdx;
 
   return DmDager.transpose() * (R * DmDager * c - r - B.transpose() * costate);
 }
@@ -1,4 +1,8 @@
 
+#include <atomic>
+#include <cmath>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <ocs2_core/Types.h>
@@ -9,6 +13,7 @@
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
+#include <ocs2_python_interface/PythonBatchService.h>
 #include <ocs2_python_interface/PythonInterface.h>
 #include <ocs2_robotic_tools/common/RobotInterface.h>
 
@@ -70,3 +75,152 @@ class DummyPyBindings final : public PythonInterface {
 TEST(OCS2PyBindingsTest, createDummyPyBindings) {
   ocs2::pybindings_test::DummyPyBindings dummy;
 }
+
+TEST(OCS2PyBindingsTest, batchEvaluation) {
+  ocs2::pybindings_test::DummyPyBindings dummy;
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(2)}, {ocs2::vector_t::Zero(1)});
+  dummy.reset(targetTrajectories);
+  dummy.setObservation(0.0, ocs2::vector_t::Zero(2), ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+  dummy.setNumBatchThreads(3);
+
+  constexpr size_t N = 17;
+  const ocs2::vector_t t = ocs2::vector_t::LinSpaced(N, 0.0, 0.5);
+  const ocs2::PythonInterface::row_matrix_t x = ocs2::PythonInterface::row_matrix_t::Random(N, 2);
+  const ocs2::PythonInterface::row_matrix_t u = ocs2::PythonInterface::row_matrix_t::Random(N, 1);
+
+  using RowMajorMap = Eigen::Map<const ocs2::PythonInterface::row_matrix_t>;
+  const auto dxdt = dummy.flowMapBatch(t, x, u);
+  const auto dynamics = dummy.flowMapLinearApproximationBatch(t, x, u);
+  const auto L = dummy.costBatch(t, x, u);
+  const auto cost = dummy.costQuadraticApproximationBatch(t, x, u);
+  const auto V = dummy.valueFunctionBatch(t, x);
+  const auto dVdx = dummy.valueFunctionStateDerivativeBatch(t, x);
+
+  for (size_t i = 0; i < N; i++) {
+    const ocs2::vector_t xi = x.row(i).transpose();
+    const ocs2::vector_t ui = u.row(i).transpose();
+    EXPECT_TRUE(dxdt.row(i).transpose().isApprox(dummy.flowMap(t(i), xi, ui)));
+
+    const auto dynamicsApprox = dummy.flowMapLinearApproximation(t(i), xi, ui);
+    EXPECT_TRUE(dynamics.f.row(i).transpose().isApprox(dynamicsApprox.f));
+    EXPECT_TRUE(RowMajorMap(dynamics.dfdx.row(i).data(), 2, 2).isApprox(dynamicsApprox.dfdx));
+    EXPECT_TRUE(RowMajorMap(dynamics.dfdu.row(i).data(), 2, 1).isApprox(dynamicsApprox.dfdu));
+
+    EXPECT_DOUBLE_EQ(L(i), dummy.cost(t(i), xi, ui));
+    const auto costApprox = dummy.costQuadraticApproximation(t(i), xi, ui);
+    EXPECT_DOUBLE_EQ(cost.f(i), costApprox.f);
+    EXPECT_TRUE(cost.dfdx.row(i).transpose().isApprox(costApprox.dfdx));
+    EXPECT_TRUE(cost.dfdu.row(i).transpose().isApprox(costApprox.dfdu));
+    EXPECT_TRUE(RowMajorMap(cost.dfdxx.row(i).data(), 2, 2).isApprox(costApprox.dfdxx));
+    EXPECT_TRUE(RowMajorMap(cost.dfduu.row(i).data(), 1, 1).isApprox(costApprox.dfduu));
+
+    EXPECT_DOUBLE_EQ(V(i), dummy.valueFunction(t(i), xi));
+    EXPECT_TRUE(dVdx.row(i).transpose().isApprox(dummy.valueFunctionStateDerivative(t(i), xi)));
+  }
+}
+
+TEST(OCS2PyBindingsTest, rolloutBatch) {
+  ocs2::pybindings_test::DummyPyBindings dummy;
+  dummy.reset(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Ones(2)}, {ocs2::vector_t::Zero(1)}));
+  dummy.setObservation(0.0, ocs2::vector_t::Zero(2), ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+  dummy.setNumBatchThreads(2);
+
+  constexpr size_t M = 5;
+  const ocs2::PythonInterface::row_matrix_t x0 = ocs2::PythonInterface::row_matrix_t::Random(M, 2);
+  ocs2::vector_t t;
+  ocs2::matrix_t x, u;
+  std::tie(t, x, u) = dummy.rolloutBatch(0.0, x0, 0.5, 0.01);
+
+  const size_t K = t.size();
+  ASSERT_GT(K, 1);
+  EXPECT_NEAR(t(K - 1), 0.5, 1e-12);
+  ASSERT_EQ(x.rows(), K * 2);
+  ASSERT_EQ(x.cols(), M);
+  ASSERT_EQ(u.rows(), K * 1);
+  EXPECT_TRUE(x.topRows(2).isApprox(x0.transpose()));
+}
+
+TEST(OCS2PyBindingsTest, concurrentSolverAccess) {
+  ocs2::pybindings_test::DummyPyBindings dummy;
+  dummy.reset(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Ones(2)}, {ocs2::vector_t::Zero(1)}));
+  dummy.setObservation(0.0, ocs2::vector_t::Zero(2), ocs2::vector_t::Zero(1));
+  dummy.advanceMpc();
+  dummy.setNumBatchThreads(2);
+
+  constexpr size_t N = 8;
+  const ocs2::vector_t t = ocs2::vector_t::LinSpaced(N, 0.0, 0.5);
+  const ocs2::PythonInterface::row_matrix_t x = ocs2::PythonInterface::row_matrix_t::Random(N, 2);
+  const ocs2::PythonInterface::row_matrix_t u = ocs2::PythonInterface::row_matrix_t::Random(N, 1);
+
+  // the solver runs while another thread queries it, as with advanceMpc releasing the GIL
+  std::atomic_bool solving{true};
+  std::thread solverThread([&] {
+    for (int i = 0; i < 20; i++) {
+      dummy.setObservation(0.01 * i, ocs2::vector_t::Zero(2), ocs2::vector_t::Zero(1));
+      dummy.advanceMpc();
+    }
+    solving = false;
+  });
+
+  // the cost shares the pre-computation and the dynamics of the problem with the queries below
+  std::thread costThread([&] {
+    while (solving) {
+      EXPECT_TRUE(std::isfinite(dummy.cost(0.1, x.row(1).transpose(), u.row(1).transpose())));
+      EXPECT_TRUE(dummy.costQuadraticApproximation(0.1, x.row(1).transpose(), u.row(1).transpose()).dfdx.allFinite());
+    }
+  });
+
+  size_t numQueries = 0;
+  while (solving || numQueries == 0) {
+    const ocs2::vector_t xi = x.row(0).transpose();
+    const ocs2::vector_t ui = u.row(0).transpose();
+    EXPECT_TRUE(dummy.valueFunctionBatch(t, x).allFinite());
+    EXPECT_TRUE(dummy.costBatch(t, x, u).allFinite());
+    EXPECT_TRUE(std::isfinite(dummy.valueFunction(0.1, xi)));
+    EXPECT_TRUE(std::get<1>(dummy.getMpcSolutionArrays()).allFinite());
+    EXPECT_TRUE(dummy.flowMap(0.1, xi, ui).allFinite());
+    EXPECT_TRUE(dummy.flowMapLinearApproximation(0.1, xi, ui).dfdx.allFinite());
+    EXPECT_TRUE(dummy.stateInputEqualityConstraint(0.1, xi, ui).allFinite());
+    EXPECT_TRUE(dummy.stateInputEqualityConstraintLinearApproximation(0.1, xi, ui).f.allFinite());
+    numQueries++;
+  }
+  solverThread.join();
+  costThread.join();
+}
+
+TEST(OCS2PyBindingsTest, batchService) {
+  constexpr size_t numInstances = 3;
+  std::vector<std::unique_ptr<ocs2::pybindings_test::DummyPyBindings>> dummies;
+  ocs2::PythonBatchService service(2);
+  for (size_t i = 0; i < numInstances; i++) {
+    dummies.emplace_back(new ocs2::pybindings_test::DummyPyBindings);
+    dummies.back()->reset(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Constant(2, i)}, {ocs2::vector_t::Zero(1)}));
+    EXPECT_EQ(service.addInstance(*dummies.back()), i);
+  }
+  EXPECT_THROW(service.addInstance(*dummies.front()), std::runtime_error);
+  ASSERT_EQ(service.numInstances(), numInstances);
+
+  for (size_t iter = 0; iter < 2; iter++) {
+    for (auto& dummy : dummies) {
+      dummy->setObservation(0.01 * iter, ocs2::vector_t::Zero(2), ocs2::vector_t::Zero(1));
+    }
+    service.advanceMpc();
+    for (size_t i = 0; i < numInstances; i++) {
+      EXPECT_FALSE(service.getStatus(i).isSkipped);
+      const auto solution = dummies[i]->getMpcSolutionArrays();
+      ASSERT_GT(std::get<0>(solution).size(), 0);
+      EXPECT_NEAR(std::get<0>(solution)(0), 0.01 * iter, 1e-6);
+    }
+  }
+
+  // the instances are solved as if they were advanced one by one
+  ocs2::pybindings_test::DummyPyBindings reference;
+  reference.reset(ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Constant(2, 2)}, {ocs2::vector_t::Zero(1)}));
+  for (size_t iter = 0; iter < 2; iter++) {
+    reference.setObservation(0.01 * iter, ocs2::vector_t::Zero(2), ocs2::vector_t::Zero(1));
+    reference.advanceMpc();
+  }
+  EXPECT_TRUE(std::get<1>(dummies[2]->getMpcSolutionArrays()).isApprox(std::get<1>(reference.getMpcSolutionArrays())));
+}
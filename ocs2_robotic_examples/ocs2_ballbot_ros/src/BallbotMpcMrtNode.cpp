@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ros/package.h>
 
 #include <ocs2_core/thread_support/ExecuteAndSleep.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
@@ -143,6 +144,8 @@ int main(int argc, char** argv) {
     }
   });
   ocs2::setThreadPriority(ballbotInterface.ddpSettings().threadPriority_, mpcThread);
+  ocs2::setThreadAffinity(ballbotInterface.mpcSettings().mpcThreadAffinity_, mpcThread);
+  ocs2::setThisThreadAffinity(ballbotInterface.mpcSettings().mrtThreadAffinity_);
 
   /*
    * Main control loop.
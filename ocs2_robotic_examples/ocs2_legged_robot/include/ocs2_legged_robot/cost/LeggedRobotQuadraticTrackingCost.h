@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_centroidal_model/CentroidalModelInfo.h>
 #include <ocs2_core/cost/QuadraticStateCost.h>
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
 
 #include "ocs2_legged_robot/common/utils.h"
 #include "ocs2_legged_robot/reference_manager/SwitchedModelReferenceManager.h"
@@ -55,9 +56,10 @@ class LeggedRobotStateInputQuadraticCost final : public QuadraticStateInputCost
   LeggedRobotStateInputQuadraticCost(const LeggedRobotStateInputQuadraticCost& rhs) = default;
 
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
+                                                       const TargetTrajectories& targetTrajectories,
+                                                       const PreComputation& preComputation) const override {
     const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
-    const vector_t xNominal = targetTrajectories.getDesiredState(time);
+    const vector_t xNominal = getDesiredState(time, targetTrajectories, preComputation);
     const vector_t uNominal = weightCompensatingInput(info_, contactFlags);
     return {state - xNominal, input - uNominal};
   }
@@ -80,9 +82,10 @@ class LeggedRobotStateQuadraticCost final : public QuadraticStateCost {
  private:
   LeggedRobotStateQuadraticCost(const LeggedRobotStateQuadraticCost& rhs) = default;
 
-  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
+  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                             const PreComputation& preComputation) const override {
     const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
-    const vector_t xNominal = targetTrajectories.getDesiredState(time);
+    const vector_t xNominal = getDesiredState(time, targetTrajectories, preComputation);
     return state - xNominal;
   }
 
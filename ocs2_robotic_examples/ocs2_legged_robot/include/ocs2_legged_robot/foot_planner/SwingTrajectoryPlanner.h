@@ -57,7 +57,24 @@ class SwingTrajectoryPlanner {
 
   scalar_t getZpositionConstraint(size_t leg, scalar_t time) const;
 
+  /**
+   * Batch version of getZvelocityConstraint for all the feet. The active phase is looked up only once.
+   * @param [in] time: The query time.
+   * @return The swing z-velocity of each foot. Only the first numFeet entries are set.
+   */
+  feet_array_t<scalar_t> getZvelocityConstraints(scalar_t time) const;
+
+  /**
+   * Batch version of getZpositionConstraint for all the feet. The active phase is looked up only once.
+   * @param [in] time: The query time.
+   * @return The swing z-position of each foot. Only the first numFeet entries are set.
+   */
+  feet_array_t<scalar_t> getZpositionConstraints(scalar_t time) const;
+
  private:
+  /** Returns the spline of the given leg in the given phase from the phase-major table. */
+  const SplineCpg& getSpline(size_t leg, size_t phase) const { return feetHeightTrajectories_[phase * numFeet_ + leg]; }
+
   /**
    * Extracts for each leg the contact sequence over the motion phase sequence.
    * @param phaseIDsStock
@@ -103,8 +120,10 @@ class SwingTrajectoryPlanner {
   const Config config_;
   const size_t numFeet_;
 
-  feet_array_t<std::vector<SplineCpg>> feetHeightTrajectories_;
-  feet_array_t<std::vector<scalar_t>> feetHeightTrajectoriesEvents_;
+  // The swing splines of all feet in a contiguous, phase-major table: [phase * numFeet_ + leg].
+  // All the feet share the same event times, hence a single lookup serves a query for all of them.
+  std::vector<SplineCpg> feetHeightTrajectories_;
+  scalar_array_t feetHeightTrajectoriesEvents_;
 };
 
 SwingTrajectoryPlanner::Config loadSwingTrajectorySettings(const std::string& fileName,
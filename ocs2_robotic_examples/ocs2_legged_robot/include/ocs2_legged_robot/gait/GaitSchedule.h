@@ -49,6 +49,20 @@ class GaitSchedule {
    */
   ModeSchedule getModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime);
 
+  /**
+   * Incrementally updates the internal ModeSchedule such that it is defined in [lowerBoundTime, upperBoundTime]. The events
+   * before lowerBoundTime are retired and the mode sequence template is only tiled further when the current schedule does not
+   * cover upperBoundTime anymore. Therefore, while the time window slides within the current schedule, nothing is modified.
+   *
+   * @param [in] lowerBoundTime: The smallest time for which the ModeSchedule should be defined.
+   * @param [in] upperBoundTime: The greatest time for which the ModeSchedule should be defined.
+   * @return true if the ModeSchedule has been modified since the last call.
+   */
+  bool updateModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime);
+
+  /** Gets the current ModeSchedule without updating it. */
+  const ModeSchedule& getCurrentModeSchedule() const { return modeSchedule_; }
+
   /**
    * Used to insert a new user defined logic in the given time period.
    *
@@ -70,6 +84,7 @@ class GaitSchedule {
   ModeSchedule modeSchedule_;
   ModeSequenceTemplate modeSequenceTemplate_;
   scalar_t phaseTransitionStanceTime_;
+  bool isModified_ = true;
 };
 
 }  // namespace legged_robot
@@ -58,8 +58,12 @@ class SwitchedModelReferenceManager : public ReferenceManager {
   void modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState, TargetTrajectories& targetTrajectories,
                         ModeSchedule& modeSchedule) override;
 
+  void updateReplayedReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                const TargetTrajectories& targetTrajectories, const ModeSchedule& modeSchedule) override;
+
   std::shared_ptr<GaitSchedule> gaitSchedulePtr_;
   std::shared_ptr<SwingTrajectoryPlanner> swingTrajectoryPtr_;
+  bool isSwingTrajectoryReplayed_ = false;
 };
 
 }  // namespace legged_robot
@@ -0,0 +1,77 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <string>
+
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_mpc/MPC_ClosedLoopBenchmark.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+/**
+ * Monte-Carlo closed-loop benchmark of the legged robot MPC.
+ * Usage: legged_robot_mpc_benchmark [--output <file.json>] [--thresholds <file.info>] [--trials <number>] [--seed <number>]
+ */
+int main(int argc, char** argv) {
+  const std::string taskFile = ocs2::legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string referenceFile = ocs2::legged_robot::getPath() + "/config/command/reference.info";
+  const std::string urdfFile = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  LeggedRobotInterface interface(taskFile, urdfFile, referenceFile);
+
+  GaussNewtonDDP_MPC mpc(interface.mpcSettings(), interface.ddpSettings(), interface.getRollout(), interface.getOptimalControlProblem(),
+                         interface.getInitializer());
+  mpc.getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+
+  // perturb the base position and yaw, the state is {normalized centroidal momentum, base pose, joint positions}
+  const auto& info = interface.getCentroidalModelInfo();
+  const vector_t& initState = interface.getInitialState();
+  const TargetTrajectories targetTrajectories({0.0}, {initState}, {vector_t::Zero(info.inputDim)});
+  vector_t initStateNoise = vector_t::Zero(info.stateDim);
+  initStateNoise.segment<4>(6) << 0.02, 0.02, 0.02, 0.05;
+  vector_t targetStateNoise = vector_t::Zero(info.stateDim);
+  targetStateNoise.segment<4>(6) << 0.3, 0.3, 0.05, 0.3;
+
+  benchmark::ClosedLoopProblem problem(mpc, interface.getRollout());
+  problem.initState = initState;
+  problem.initStateNoise = initStateNoise;
+  problem.targetTrajectories = targetTrajectories;
+  problem.targetStateNoise = targetStateNoise;
+
+  // the gait schedule advances with the MPC time, hence it is restored for each trial which starts again at time zero
+  const auto gaitSchedulePtr = interface.getSwitchedModelReferenceManagerPtr()->getGaitSchedule();
+  const GaitSchedule initialGaitSchedule = *gaitSchedulePtr;
+  problem.resetTrial = [&]() { *gaitSchedulePtr = initialGaitSchedule; };
+
+  return benchmark::benchmarkMain(argc, argv, "legged_robot", problem);
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_mpc/MPC_Recorder.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+/**
+ * Reruns the legged robot MPC on the inputs of a recording made with recording::SolverRecorder, without ROS.
+ * Usage: legged_robot_mpc_replay recording.bin [output.csv]
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " recording.bin [output.csv]" << std::endl;
+    return 1;
+  }
+
+  // open the output file before the replay, such that a bad path fails early
+  std::ofstream file;
+  if (argc > 2) {
+    file.open(argv[2]);
+    if (!file.is_open()) {
+      std::cerr << "[LeggedRobotMpcReplay] Could not open " << argv[2] << std::endl;
+      return 1;
+    }
+  }
+
+  const std::string taskFile = ocs2::legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string referenceFile = ocs2::legged_robot::getPath() + "/config/command/reference.info";
+  const std::string urdfFile = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  LeggedRobotInterface interface(taskFile, urdfFile, referenceFile);
+
+  GaussNewtonDDP_MPC mpc(interface.mpcSettings(), interface.ddpSettings(), interface.getRollout(), interface.getOptimalControlProblem(),
+                         interface.getInitializer());
+  // the constraints read the contact flags and the swing trajectories from the reference manager of the interface
+  mpc.getSolverPtr()->setReferenceManager(interface.getReferenceManagerPtr());
+
+  const auto samples = recording::replayRecording(mpc, argv[1]);
+
+  std::ostream& stream = (argc > 2) ? file : std::cout;
+  stream << "call,solveTime,numIterations,replayedCost,recordedCost\n";
+  for (size_t i = 0; i < samples.solveTimes.size(); i++) {
+    stream << i << ',' << samples.solveTimes[i] << ',' << samples.numIterations[i] << ',' << samples.replayedCost[i] << ','
+           << samples.recordedCost[i] << '\n';
+  }
+
+  stream.flush();
+  if (stream.fail()) {
+    std::cerr << "[LeggedRobotMpcReplay] Could not write " << ((argc > 2) ? argv[2] : "the standard output") << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -67,19 +67,23 @@ void LeggedRobotPreComputation::request(RequestSet request, scalar_t t, const ve
     return;
   }
 
-  // lambda to set config for normal velocity constraints
-  auto eeNormalVelConConfig = [&](size_t footIndex) {
-    EndEffectorLinearConstraint::Config config;
-    config.b = (vector_t(1) << -swingTrajectoryPlannerPtr_->getZvelocityConstraint(footIndex, t)).finished();
-    config.Av = (matrix_t(1, 3) << 0.0, 0.0, 1.0).finished();
-    if (!numerics::almost_eq(settings_.positionErrorGain, 0.0)) {
-      config.b(0) -= settings_.positionErrorGain * swingTrajectoryPlannerPtr_->getZpositionConstraint(footIndex, t);
-      config.Ax = (matrix_t(1, 3) << 0.0, 0.0, settings_.positionErrorGain).finished();
-    }
-    return config;
-  };
-
   if (request.contains(Request::Constraint)) {
+    const bool usePositionError = !numerics::almost_eq(settings_.positionErrorGain, 0.0);
+    const auto zVelocities = swingTrajectoryPlannerPtr_->getZvelocityConstraints(t);
+    const auto zPositions = usePositionError ? swingTrajectoryPlannerPtr_->getZpositionConstraints(t) : feet_array_t<scalar_t>{};
+
+    // lambda to set config for normal velocity constraints
+    auto eeNormalVelConConfig = [&](size_t footIndex) {
+      EndEffectorLinearConstraint::Config config;
+      config.b = (vector_t(1) << -zVelocities[footIndex]).finished();
+      config.Av = (matrix_t(1, 3) << 0.0, 0.0, 1.0).finished();
+      if (usePositionError) {
+        config.b(0) -= settings_.positionErrorGain * zPositions[footIndex];
+        config.Ax = (matrix_t(1, 3) << 0.0, 0.0, settings_.positionErrorGain).finished();
+      }
+      return config;
+    };
+
     for (size_t i = 0; i < info_.numThreeDofContacts; i++) {
       eeNormalVelConConfigs_[i] = eeNormalVelConConfig(i);
     }
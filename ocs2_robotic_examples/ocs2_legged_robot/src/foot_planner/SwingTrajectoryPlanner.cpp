@@ -48,16 +48,40 @@ SwingTrajectoryPlanner::SwingTrajectoryPlanner(Config config, size_t numFeet) :
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t SwingTrajectoryPlanner::getZvelocityConstraint(size_t leg, scalar_t time) const {
-  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_[leg], time);
-  return feetHeightTrajectories_[leg][index].velocity(time);
+  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_, time);
+  return getSpline(leg, index).velocity(time);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t SwingTrajectoryPlanner::getZpositionConstraint(size_t leg, scalar_t time) const {
-  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_[leg], time);
-  return feetHeightTrajectories_[leg][index].position(time);
+  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_, time);
+  return getSpline(leg, index).position(time);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+feet_array_t<scalar_t> SwingTrajectoryPlanner::getZvelocityConstraints(scalar_t time) const {
+  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_, time);
+  feet_array_t<scalar_t> zVelocities{};
+  for (size_t leg = 0; leg < numFeet_; leg++) {
+    zVelocities[leg] = getSpline(leg, index).velocity(time);
+  }
+  return zVelocities;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+feet_array_t<scalar_t> SwingTrajectoryPlanner::getZpositionConstraints(scalar_t time) const {
+  const auto index = lookup::findIndexInTimeArray(feetHeightTrajectoriesEvents_, time);
+  feet_array_t<scalar_t> zPositions{};
+  for (size_t leg = 0; leg < numFeet_; leg++) {
+    zPositions[leg] = getSpline(leg, index).position(time);
+  }
+  return zPositions;
 }
 
 /******************************************************************************************************/
@@ -88,10 +112,10 @@ void SwingTrajectoryPlanner::update(const ModeSchedule& modeSchedule, const feet
     std::tie(startTimesIndices[leg], finalTimesIndices[leg]) = updateFootSchedule(eesContactFlagStocks[leg]);
   }
 
-  for (size_t j = 0; j < numFeet_; j++) {
-    feetHeightTrajectories_[j].clear();
-    feetHeightTrajectories_[j].reserve(modeSequence.size());
-    for (int p = 0; p < modeSequence.size(); ++p) {
+  feetHeightTrajectories_.clear();
+  feetHeightTrajectories_.reserve(modeSequence.size() * numFeet_);
+  for (int p = 0; p < modeSequence.size(); ++p) {
+    for (size_t j = 0; j < numFeet_; j++) {
       if (!eesContactFlagStocks[j][p]) {  // for a swing leg
         const int swingStartIndex = startTimesIndices[j][p];
         const int swingFinalIndex = finalTimesIndices[j][p];
@@ -105,16 +129,16 @@ void SwingTrajectoryPlanner::update(const ModeSchedule& modeSchedule, const feet
         const CubicSpline::Node liftOff{swingStartTime, liftOffHeightSequence[j][p], scaling * config_.liftOffVelocity};
         const CubicSpline::Node touchDown{swingFinalTime, touchDownHeightSequence[j][p], scaling * config_.touchDownVelocity};
         const scalar_t midHeight = std::min(liftOffHeightSequence[j][p], touchDownHeightSequence[j][p]) + scaling * config_.swingHeight;
-        feetHeightTrajectories_[j].emplace_back(liftOff, midHeight, touchDown);
+        feetHeightTrajectories_.emplace_back(liftOff, midHeight, touchDown);
       } else {  // for a stance leg
         // Note: setting the time here arbitrarily to 0.0 -> 1.0 makes the assert in CubicSpline fail
         const CubicSpline::Node liftOff{0.0, liftOffHeightSequence[j][p], 0.0};
         const CubicSpline::Node touchDown{1.0, liftOffHeightSequence[j][p], 0.0};
-        feetHeightTrajectories_[j].emplace_back(liftOff, liftOffHeightSequence[j][p], touchDown);
+        feetHeightTrajectories_.emplace_back(liftOff, liftOffHeightSequence[j][p], touchDown);
       }
     }
-    feetHeightTrajectoriesEvents_[j] = eventTimes;
   }
+  feetHeightTrajectoriesEvents_ = eventTimes;
 }
 
 /******************************************************************************************************/
@@ -44,6 +44,7 @@ GaitSchedule::GaitSchedule(ModeSchedule initModeSchedule, ModeSequenceTemplate i
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaitSchedule::insertModeSequenceTemplate(const ModeSequenceTemplate& modeSequenceTemplate, scalar_t startTime, scalar_t finalTime) {
+  isModified_ = true;
   modeSequenceTemplate_ = modeSequenceTemplate;
   auto& eventTimes = modeSchedule_.eventTimes;
   auto& modeSequence = modeSchedule_.modeSequence;
@@ -76,17 +77,39 @@ void GaitSchedule::insertModeSequenceTemplate(const ModeSequenceTemplate& modeSe
 /******************************************************************************************************/
 /******************************************************************************************************/
 ModeSchedule GaitSchedule::getModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime) {
+  updateModeSchedule(lowerBoundTime, upperBoundTime);
+  return modeSchedule_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool GaitSchedule::updateModeSchedule(scalar_t lowerBoundTime, scalar_t upperBoundTime) {
   auto& eventTimes = modeSchedule_.eventTimes;
   auto& modeSequence = modeSchedule_.modeSequence;
   const size_t index = std::lower_bound(eventTimes.begin(), eventTimes.end(), lowerBoundTime) - eventTimes.begin();
 
+  bool isModified = isModified_;
+  isModified_ = false;
+
   if (index > 0) {
-    // delete the old logic from index and set the default start phase to stance
-    eventTimes.erase(eventTimes.begin(), eventTimes.begin() + index - 1);  // keep the one before the last to make it stance
-    modeSequence.erase(modeSequence.begin(), modeSequence.begin() + index - 1);
+    // retire the old logic up to index and set the default start phase to stance
+    if (index > 1) {
+      eventTimes.erase(eventTimes.begin(), eventTimes.begin() + index - 1);  // keep the one before the last to make it stance
+      modeSequence.erase(modeSequence.begin(), modeSequence.begin() + index - 1);
+      isModified = true;
+    }
 
     // set the default initial phase
-    modeSequence.front() = ModeNumber::STANCE;
+    if (modeSequence.front() != ModeNumber::STANCE) {
+      modeSequence.front() = ModeNumber::STANCE;
+      isModified = true;
+    }
+  }
+
+  // the schedule already covers the upper bound and ends with the default stance phase
+  if (!eventTimes.empty() && eventTimes.back() >= upperBoundTime && modeSequence.back() == ModeNumber::STANCE) {
+    return isModified;
   }
 
   // Start tiling at time
@@ -98,7 +121,7 @@ ModeSchedule GaitSchedule::getModeSchedule(scalar_t lowerBoundTime, scalar_t upp
 
   // tile the template logic
   tileModeSequenceTemplate(tilingStartTime, upperBoundTime);
-  return modeSchedule_;
+  return true;
 }
 
 /******************************************************************************************************/
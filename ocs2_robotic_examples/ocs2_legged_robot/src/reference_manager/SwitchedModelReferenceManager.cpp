@@ -54,10 +54,27 @@ contact_flag_t SwitchedModelReferenceManager::getContactFlags(scalar_t time) con
 void SwitchedModelReferenceManager::modifyReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
                                                      TargetTrajectories& targetTrajectories, ModeSchedule& modeSchedule) {
   const auto timeHorizon = finalTime - initTime;
-  modeSchedule = gaitSchedulePtr_->getModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
+  const bool isModeScheduleModified = gaitSchedulePtr_->updateModeSchedule(initTime - timeHorizon, finalTime + timeHorizon);
+  modeSchedule = gaitSchedulePtr_->getCurrentModeSchedule();
 
+  // the swing trajectories only need to be re-planned if the gait has changed or they were planned for a replayed mode schedule
+  if (isModeScheduleModified || isSwingTrajectoryReplayed_) {
+    const scalar_t terrainHeight = 0.0;
+    swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+    isSwingTrajectoryReplayed_ = false;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SwitchedModelReferenceManager::updateReplayedReferences(scalar_t initTime, scalar_t finalTime, const vector_t& initState,
+                                                             const TargetTrajectories& targetTrajectories,
+                                                             const ModeSchedule& modeSchedule) {
+  // the gait schedule is bypassed, the swing trajectories follow the replayed mode schedule
   const scalar_t terrainHeight = 0.0;
   swingTrajectoryPtr_->update(modeSchedule, terrainHeight);
+  isSwingTrajectoryReplayed_ = true;
 }
 
 }  // namespace legged_robot
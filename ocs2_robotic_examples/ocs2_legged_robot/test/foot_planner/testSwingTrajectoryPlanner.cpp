@@ -0,0 +1,72 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/foot_planner/SwingTrajectoryPlanner.h"
+#include "ocs2_legged_robot/gait/MotionPhaseDefinition.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+TEST(TestSwingTrajectoryPlanner, batchQueries) {
+  constexpr size_t numFeet = 4;
+  SwingTrajectoryPlanner::Config config;
+  config.liftOffVelocity = 0.2;
+  config.touchDownVelocity = -0.4;
+  SwingTrajectoryPlanner swingTrajectoryPlanner(config, numFeet);
+
+  // trot gait
+  const ModeSchedule modeSchedule({0.3, 0.6, 0.9}, {ModeNumber::STANCE, ModeNumber::LF_RH, ModeNumber::RF_LH, ModeNumber::STANCE});
+  swingTrajectoryPlanner.update(modeSchedule, 0.0);
+
+  for (scalar_t t = -0.1; t < 1.1; t += 0.01) {
+    const auto zVelocities = swingTrajectoryPlanner.getZvelocityConstraints(t);
+    const auto zPositions = swingTrajectoryPlanner.getZpositionConstraints(t);
+    for (size_t leg = 0; leg < numFeet; leg++) {
+      EXPECT_DOUBLE_EQ(zVelocities[leg], swingTrajectoryPlanner.getZvelocityConstraint(leg, t));
+      EXPECT_DOUBLE_EQ(zPositions[leg], swingTrajectoryPlanner.getZpositionConstraint(leg, t));
+    }
+  }
+
+  // feet in stance stay on the terrain
+  const auto stancePositions = swingTrajectoryPlanner.getZpositionConstraints(0.1);
+  const auto stanceVelocities = swingTrajectoryPlanner.getZvelocityConstraints(0.1);
+  for (size_t leg = 0; leg < numFeet; leg++) {
+    EXPECT_DOUBLE_EQ(stancePositions[leg], 0.0);
+    EXPECT_DOUBLE_EQ(stanceVelocities[leg], 0.0);
+  }
+
+  // RF and LH swing in (0.3, 0.6), LF and RH stay in contact
+  const auto swingPositions = swingTrajectoryPlanner.getZpositionConstraints(0.45);
+  EXPECT_DOUBLE_EQ(swingPositions[0], 0.0);
+  EXPECT_GT(swingPositions[1], 0.0);
+  EXPECT_GT(swingPositions[2], 0.0);
+  EXPECT_DOUBLE_EQ(swingPositions[3], 0.0);
+}
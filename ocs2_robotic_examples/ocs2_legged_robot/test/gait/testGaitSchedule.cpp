@@ -0,0 +1,72 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_legged_robot/gait/GaitSchedule.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+class TestGaitSchedule : public ::testing::Test {
+ public:
+  TestGaitSchedule() {}
+
+  const ModeSchedule initModeSchedule{{0.5}, {ModeNumber::STANCE, ModeNumber::STANCE}};
+  const ModeSequenceTemplate trot{{0.0, 0.3, 0.6}, {ModeNumber::LF_RH, ModeNumber::RF_LH}};
+  const scalar_t phaseTransitionStanceTime = 0.4;
+};
+
+TEST_F(TestGaitSchedule, incrementalUpdate) {
+  GaitSchedule gaitSchedule(initModeSchedule, trot, phaseTransitionStanceTime);
+  gaitSchedule.insertModeSequenceTemplate(trot, 0.0, 2.0);
+
+  // the first call reports the inserted template
+  EXPECT_TRUE(gaitSchedule.updateModeSchedule(-1.0, 2.0));
+
+  // sliding the window without crossing an event or the end of the schedule keeps it unchanged
+  const auto modeSchedule = gaitSchedule.getCurrentModeSchedule();
+  EXPECT_FALSE(gaitSchedule.updateModeSchedule(-0.9, 2.0));
+  EXPECT_EQ(gaitSchedule.getCurrentModeSchedule().eventTimes, modeSchedule.eventTimes);
+  EXPECT_EQ(gaitSchedule.getCurrentModeSchedule().modeSequence, modeSchedule.modeSequence);
+
+  // extending the window beyond the end of the schedule tiles the template
+  EXPECT_TRUE(gaitSchedule.updateModeSchedule(-0.9, 4.0));
+  EXPECT_GE(gaitSchedule.getCurrentModeSchedule().eventTimes.back(), 4.0);
+  EXPECT_EQ(gaitSchedule.getCurrentModeSchedule().modeSequence.back(), ModeNumber::STANCE);
+  EXPECT_FALSE(gaitSchedule.updateModeSchedule(-0.9, 4.0));
+
+  // moving the lower bound over events retires them
+  EXPECT_TRUE(gaitSchedule.updateModeSchedule(1.0, 4.0));
+  const auto& eventTimes = gaitSchedule.getCurrentModeSchedule().eventTimes;
+  EXPECT_LT(eventTimes.front(), 1.0);
+  EXPECT_GE(eventTimes[1], 1.0);
+  EXPECT_EQ(gaitSchedule.getCurrentModeSchedule().modeSequence.front(), ModeNumber::STANCE);
+  EXPECT_FALSE(gaitSchedule.updateModeSchedule(1.0, 4.0));
+}
@@ -0,0 +1,141 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_mpc/MPC_Recorder.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/gait/ModeSequenceTemplate.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+
+const std::string recordingFile = "/tmp/ocs2_legged_robot_replay_test.rec";
+const std::string replayFile = "/tmp/ocs2_legged_robot_replay_test_replayed.rec";
+
+/** Reads the primal solutions of all the solver runs in a recording */
+std::vector<PrimalSolution> readPrimalSolutions(const std::string& fileName) {
+  std::vector<PrimalSolution> primalSolutions;
+  recording::RecordReader reader(fileName);
+  recording::Record record;
+  while (reader.readNext(record)) {
+    if (record.type == recording::RecordType::MpcOutput) {
+      primalSolutions.push_back(record.mpcOutput.primalSolution);
+    }
+  }
+  return primalSolutions;
+}
+
+}  // unnamed namespace
+
+TEST(testLeggedRobotMpcReplay, replayedSolutionMatchesRecording) {
+  const std::string taskFile = ocs2::legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string referenceFile = ocs2::legged_robot::getPath() + "/config/command/reference.info";
+  const std::string gaitFile = ocs2::legged_robot::getPath() + "/config/command/gait.info";
+  const std::string urdfFile = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  LeggedRobotInterface interface(taskFile, urdfFile, referenceFile);
+
+  const auto referenceManagerPtr = interface.getSwitchedModelReferenceManagerPtr();
+  const auto gaitSchedulePtr = referenceManagerPtr->getGaitSchedule();
+  const GaitSchedule initialGaitSchedule = *gaitSchedulePtr;
+
+  GaussNewtonDDP_MPC mpc(interface.mpcSettings(), interface.ddpSettings(), interface.getRollout(), interface.getOptimalControlProblem(),
+                         interface.getInitializer());
+  auto& solver = *mpc.getSolverPtr();
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // a trot, such that the solution depends on the contact flags and the swing trajectories of the gait planner
+  gaitSchedulePtr->insertModeSequenceTemplate(loadModeSequenceTemplate(gaitFile, "trot", false), 0.0, 2.0);
+  const vector_t initState = interface.getInitialState();
+  referenceManagerPtr->setTargetTrajectories(
+      TargetTrajectories({0.0}, {initState}, {vector_t::Zero(interface.getCentroidalModelInfo().inputDim)}));
+
+  // record a few closed-loop MPC runs
+  {
+    auto writerPtr = std::make_shared<recording::RecordWriter>(recordingFile);
+    solver.setSynchronizedModules({std::make_shared<recording::SolverRecorder>(writerPtr, solver)});
+    const scalar_t timeStep = 0.05;
+    vector_t state = initState;
+    for (size_t i = 0; i < 5; i++) {
+      const scalar_t time = i * timeStep;
+      mpc.run(time, state);
+      const auto primalSolution = solver.primalSolution(time + interface.mpcSettings().timeHorizon_);
+      state = LinearInterpolation::interpolate(time + timeStep, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+    }
+  }
+
+  // without the replay mode, the restored gait planner would stand still
+  *gaitSchedulePtr = initialGaitSchedule;
+
+  {
+    auto writerPtr = std::make_shared<recording::RecordWriter>(replayFile);
+    solver.setSynchronizedModules({std::make_shared<recording::SolverRecorder>(writerPtr, solver)});
+    const auto samples = recording::replayRecording(mpc, recordingFile);
+    ASSERT_EQ(samples.replayedCost.size(), 5);
+    for (size_t i = 0; i < samples.replayedCost.size(); i++) {
+      EXPECT_NEAR(samples.replayedCost[i], samples.recordedCost[i], 1e-6 * (1.0 + std::abs(samples.recordedCost[i])));
+    }
+    solver.setSynchronizedModules({});
+  }
+
+  const auto recordedSolutions = readPrimalSolutions(recordingFile);
+  const auto replayedSolutions = readPrimalSolutions(replayFile);
+  ASSERT_EQ(recordedSolutions.size(), 5);
+  ASSERT_EQ(replayedSolutions.size(), recordedSolutions.size());
+  for (size_t i = 0; i < recordedSolutions.size(); i++) {
+    const auto& recorded = recordedSolutions[i];
+    const auto& replayed = replayedSolutions[i];
+    EXPECT_EQ(replayed.modeSchedule_.eventTimes, recorded.modeSchedule_.eventTimes);
+    EXPECT_EQ(replayed.modeSchedule_.modeSequence, recorded.modeSchedule_.modeSequence);
+    ASSERT_EQ(replayed.timeTrajectory_.size(), recorded.timeTrajectory_.size());
+    for (size_t k = 0; k < recorded.timeTrajectory_.size(); k++) {
+      EXPECT_NEAR(replayed.timeTrajectory_[k], recorded.timeTrajectory_[k], 1e-9);
+      EXPECT_TRUE(replayed.stateTrajectory_[k].isApprox(recorded.stateTrajectory_[k], 1e-6)) << "run " << i << ", node " << k;
+      EXPECT_TRUE(replayed.inputTrajectory_[k].isApprox(recorded.inputTrajectory_[k], 1e-6)) << "run " << i << ", node " << k;
+    }
+  }
+
+  // after the replay, the mode schedule is generated by the (restored) gait planner again
+  mpc.run(0.0, initState);
+  for (const auto mode : referenceManagerPtr->getModeSchedule().modeSequence) {
+    EXPECT_EQ(mode, static_cast<size_t>(ModeNumber::STANCE));
+  }
+}
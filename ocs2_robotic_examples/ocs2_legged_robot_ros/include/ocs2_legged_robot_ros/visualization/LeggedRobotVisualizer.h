@@ -29,9 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <robot_state_publisher/robot_state_publisher.h>
 #include <ros/node_handle.h>
 #include <tf/transform_broadcaster.h>
+#include <visualization_msgs/MarkerArray.h>
 
 #include <ocs2_centroidal_model/CentroidalModelInfo.h>
 #include <ocs2_core/Types.h>
@@ -54,6 +59,7 @@ class LeggedRobotVisualizer : public DummyObserver {
   scalar_t copMarkerDiameter_ = 0.03;         // Size of the sphere at the center of pressure
   scalar_t supportPolygonLineWidth_ = 0.005;  // LineThickness for the support polygon
   scalar_t trajectoryLineWidth_ = 0.01;       // LineThickness for trajectories
+  scalar_t trajectoryResolution_ = 0.0;       // Minimum time between published trajectory points, 0.0 publishes every node
   std::vector<Color> feetColorMap_ = {Color::blue, Color::orange, Color::yellow, Color::purple};  // Colors for markers per feet
 
   /**
@@ -61,17 +67,23 @@ class LeggedRobotVisualizer : public DummyObserver {
    * @param pinocchioInterface
    * @param n
    * @param maxUpdateFrequency : maximum publish frequency measured in MPC time.
+   * @param publishInSeparateThread : if true, update() only hands over the latest frame to a publisher thread. Frames that arrive
+   *                                  before the previous one is published replace it.
    */
   LeggedRobotVisualizer(PinocchioInterface pinocchioInterface, CentroidalModelInfo centroidalModelInfo,
                         const PinocchioEndEffectorKinematics& endEffectorKinematics, ros::NodeHandle& nodeHandle,
-                        scalar_t maxUpdateFrequency = 100.0);
+                        scalar_t maxUpdateFrequency = 100.0, bool publishInSeparateThread = false);
 
-  ~LeggedRobotVisualizer() override = default;
+  ~LeggedRobotVisualizer() override;
 
   void update(const SystemObservation& observation, const PrimalSolution& primalSolution, const CommandData& command) override;
 
   void launchVisualizerNode(ros::NodeHandle& nodeHandle);
 
+  /*
+   * The publish methods below may be called while the publisher thread is running. They share the kinematics and the message buffers
+   * with it, hence each call waits until the thread has published its current frame.
+   */
   void publishTrajectory(const std::vector<SystemObservation>& system_observation_array, scalar_t speed = 1.0);
 
   void publishObservation(ros::Time timeStamp, const SystemObservation& observation);
@@ -81,13 +93,35 @@ class LeggedRobotVisualizer : public DummyObserver {
   void publishOptimizedStateTrajectory(ros::Time timeStamp, const scalar_array_t& mpcTimeTrajectory,
                                        const vector_array_t& mpcStateTrajectory, const ModeSchedule& modeSchedule);
 
+  /** Number of frames that were replaced by a newer frame before the publisher thread picked them up. */
+  size_t getNumDroppedFrames() const;
+
  private:
+  /** Data needed to publish one update */
+  struct Frame {
+    SystemObservation observation;
+    scalar_array_t timeTrajectory;
+    vector_array_t stateTrajectory;
+    ModeSchedule modeSchedule;
+    TargetTrajectories targetTrajectories;
+  };
+
   LeggedRobotVisualizer(const LeggedRobotVisualizer&) = delete;
+  void publishFrame(const SystemObservation& observation, const scalar_array_t& mpcTimeTrajectory, const vector_array_t& mpcStateTrajectory,
+                    const ModeSchedule& modeSchedule, const TargetTrajectories& targetTrajectories);
+  void publisherWorker();
+  void shutdownPublisherWorker();
   void publishJointTransforms(ros::Time timeStamp, const vector_t& jointAngles) const;
   void publishBaseTransform(ros::Time timeStamp, const vector_t& basePose);
   void publishCartesianMarkers(ros::Time timeStamp, const contact_flag_t& contactFlags, const std::vector<vector3_t>& feetPositions,
                                const std::vector<vector3_t>& feetForces) const;
 
+  /** Implementations of the public publish methods, the caller must hold publishMutex_ */
+  void publishObservationImpl(ros::Time timeStamp, const SystemObservation& observation);
+  void publishDesiredTrajectoryImpl(ros::Time timeStamp, const TargetTrajectories& targetTrajectories);
+  void publishOptimizedStateTrajectoryImpl(ros::Time timeStamp, const scalar_array_t& mpcTimeTrajectory,
+                                           const vector_array_t& mpcStateTrajectory, const ModeSchedule& modeSchedule);
+
   PinocchioInterface pinocchioInterface_;
   const CentroidalModelInfo centroidalModelInfo_;
   std::unique_ptr<PinocchioEndEffectorKinematics> endEffectorKinematicsPtr_;
@@ -104,6 +138,25 @@ class LeggedRobotVisualizer : public DummyObserver {
 
   scalar_t lastTime_;
   scalar_t minPublishTimeDifference_;
+
+  // Guards the kinematics and the message buffers, which the publisher thread and the public publish methods share
+  std::mutex publishMutex_;
+
+  // Message buffers, reused between updates
+  std::vector<size_t> decimatedIndices_;
+  visualization_msgs::Marker desiredBaseLineMsg_;
+  std::vector<visualization_msgs::Marker> desiredFeetLineMsgs_;
+  visualization_msgs::MarkerArray optimizedStateMarkerArray_;
+
+  // Publisher thread, fed through a single frame buffer that always holds the latest update
+  std::thread publisherWorker_;
+  mutable std::mutex bufferMutex_;
+  std::condition_variable frameReady_;
+  bool terminateThread_ = false;
+  bool isFrameAvailable_ = false;
+  size_t numDroppedFrames_ = 0;
+  std::unique_ptr<Frame> bufferFramePtr_;
+  std::unique_ptr<Frame> publisherFramePtr_;
 };
 
 }  // namespace legged_robot
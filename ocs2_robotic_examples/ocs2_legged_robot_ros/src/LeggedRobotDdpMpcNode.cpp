@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_legged_robot/LeggedRobotInterface.h>
+#include <ocs2_mpc/MPC_Recorder.h>
 #include <ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h>
 #include <ocs2_ros_interfaces/synchronized_module/RosReferenceManager.h>
 
@@ -69,6 +70,13 @@ int main(int argc, char** argv) {
   mpc.getSolverPtr()->setReferenceManager(rosReferenceManagerPtr);
   mpc.getSolverPtr()->addSynchronizedModule(gaitReceiverPtr);
 
+  // Optionally record the inputs and outputs of every MPC call for an offline replay
+  std::string recordingFile;
+  if (nodeHandle.getParam("/mpcRecordingFile", recordingFile) && !recordingFile.empty()) {
+    auto recordWriterPtr = std::make_shared<recording::RecordWriter>(recordingFile);
+    mpc.getSolverPtr()->addSynchronizedModule(std::make_shared<recording::SolverRecorder>(recordWriterPtr, *mpc.getSolverPtr()));
+  }
+
   // Launch MPC ROS node
   MPC_ROS_Interface mpcNode(mpc, robotName);
   mpcNode.launchNodes(nodeHandle);
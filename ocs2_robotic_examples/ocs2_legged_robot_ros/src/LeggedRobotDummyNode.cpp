@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ros/package.h>
 
 #include <ocs2_centroidal_model/CentroidalModelPinocchioMapping.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 #include <ocs2_legged_robot/LeggedRobotInterface.h>
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematics.h>
 #include <ocs2_ros_interfaces/mrt/MRT_ROS_Dummy_Loop.h>
@@ -65,8 +66,9 @@ int main(int argc, char** argv) {
   CentroidalModelPinocchioMapping pinocchioMapping(interface.getCentroidalModelInfo());
   PinocchioEndEffectorKinematics endEffectorKinematics(interface.getPinocchioInterface(), pinocchioMapping,
                                                        interface.modelSettings().contactNames3DoF);
-  std::shared_ptr<LeggedRobotVisualizer> leggedRobotVisualizer(
-      new LeggedRobotVisualizer(interface.getPinocchioInterface(), interface.getCentroidalModelInfo(), endEffectorKinematics, nodeHandle));
+  // Publish in a separate thread such that visualization does not slow down the MRT loop
+  std::shared_ptr<LeggedRobotVisualizer> leggedRobotVisualizer(new LeggedRobotVisualizer(
+      interface.getPinocchioInterface(), interface.getCentroidalModelInfo(), endEffectorKinematics, nodeHandle, 100.0, true));
 
   // Dummy legged robot
   MRT_ROS_Dummy_Loop leggedRobotDummySimulator(mrt, interface.mpcSettings().mrtDesiredFrequency_,
@@ -83,6 +85,7 @@ int main(int argc, char** argv) {
   TargetTrajectories initTargetTrajectories({0.0}, {initObservation.state}, {initObservation.input});
 
   // run dummy
+  setThisThreadAffinity(interface.mpcSettings().mrtThreadAffinity_);
   leggedRobotDummySimulator.run(initObservation, initTargetTrajectories);
 
   // Successful exit
@@ -45,7 +45,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Additional messages not in the helpers file
 #include <geometry_msgs/PoseArray.h>
-#include <visualization_msgs/MarkerArray.h>
 
 // URDF related
 #include <urdf/model.h>
@@ -54,21 +53,60 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace legged_robot {
 
+namespace {
+
+/** Selects the nodes of a trajectory that are at least the given resolution apart in time. The last node is always selected. */
+void decimateTrajectory(const scalar_array_t& timeTrajectory, scalar_t resolution, std::vector<size_t>& indices) {
+  indices.clear();
+  if (timeTrajectory.empty()) {
+    return;
+  }
+  indices.push_back(0);
+  for (size_t k = 1; k < timeTrajectory.size(); k++) {
+    if (timeTrajectory[k] - timeTrajectory[indices.back()] >= resolution || k + 1 == timeTrajectory.size()) {
+      indices.push_back(k);
+    }
+  }
+}
+
+/** Resets a line marker while keeping the memory of its point buffer */
+void resetLineMsg(visualization_msgs::Marker& line, Color color, double lineWidth) {
+  std::vector<geometry_msgs::Point> points = std::move(line.points);
+  points.clear();
+  line = getLineMsg(std::move(points), color, lineWidth);
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 LeggedRobotVisualizer::LeggedRobotVisualizer(PinocchioInterface pinocchioInterface, CentroidalModelInfo centroidalModelInfo,
                                              const PinocchioEndEffectorKinematics& endEffectorKinematics, ros::NodeHandle& nodeHandle,
-                                             scalar_t maxUpdateFrequency)
+                                             scalar_t maxUpdateFrequency, bool publishInSeparateThread)
     : pinocchioInterface_(std::move(pinocchioInterface)),
       centroidalModelInfo_(std::move(centroidalModelInfo)),
       endEffectorKinematicsPtr_(endEffectorKinematics.clone()),
       lastTime_(std::numeric_limits<scalar_t>::lowest()),
-      minPublishTimeDifference_(1.0 / maxUpdateFrequency) {
+      minPublishTimeDifference_(1.0 / maxUpdateFrequency),
+      desiredFeetLineMsgs_(centroidalModelInfo_.numThreeDofContacts),
+      bufferFramePtr_(new Frame),
+      publisherFramePtr_(new Frame) {
   endEffectorKinematicsPtr_->setPinocchioInterface(pinocchioInterface_);
   launchVisualizerNode(nodeHandle);
+
+  if (publishInSeparateThread) {
+    publisherWorker_ = std::thread(&LeggedRobotVisualizer::publisherWorker, this);
+  }
 };
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LeggedRobotVisualizer::~LeggedRobotVisualizer() {
+  shutdownPublisherWorker();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -100,24 +138,100 @@ void LeggedRobotVisualizer::launchVisualizerNode(ros::NodeHandle& nodeHandle) {
 /******************************************************************************************************/
 void LeggedRobotVisualizer::update(const SystemObservation& observation, const PrimalSolution& primalSolution, const CommandData& command) {
   if (observation.time - lastTime_ > minPublishTimeDifference_) {
-    const auto& model = pinocchioInterface_.getModel();
-    auto& data = pinocchioInterface_.getData();
-    pinocchio::forwardKinematics(model, data, centroidal_model::getGeneralizedCoordinates(observation.state, centroidalModelInfo_));
-    pinocchio::updateFramePlacements(model, data);
+    if (publisherWorker_.joinable()) {
+      // Hand over the frame, copy-assignment reuses the memory of the buffer
+      std::unique_lock<std::mutex> lk(bufferMutex_);
+      if (isFrameAvailable_) {
+        ++numDroppedFrames_;
+      }
+      bufferFramePtr_->observation = observation;
+      bufferFramePtr_->timeTrajectory = primalSolution.timeTrajectory_;
+      bufferFramePtr_->stateTrajectory = primalSolution.stateTrajectory_;
+      bufferFramePtr_->modeSchedule = primalSolution.modeSchedule_;
+      bufferFramePtr_->targetTrajectories = command.mpcTargetTrajectories_;
+      isFrameAvailable_ = true;
+      lk.unlock();
+      frameReady_.notify_one();
 
-    const auto timeStamp = ros::Time::now();
-    publishObservation(timeStamp, observation);
-    publishDesiredTrajectory(timeStamp, command.mpcTargetTrajectories_);
-    publishOptimizedStateTrajectory(timeStamp, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_,
-                                    primalSolution.modeSchedule_);
+    } else {
+      publishFrame(observation, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_, primalSolution.modeSchedule_,
+                   command.mpcTargetTrajectories_);
+    }
     lastTime_ = observation.time;
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotVisualizer::publishFrame(const SystemObservation& observation, const scalar_array_t& mpcTimeTrajectory,
+                                         const vector_array_t& mpcStateTrajectory, const ModeSchedule& modeSchedule,
+                                         const TargetTrajectories& targetTrajectories) {
+  std::lock_guard<std::mutex> lock(publishMutex_);
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+  pinocchio::forwardKinematics(model, data, centroidal_model::getGeneralizedCoordinates(observation.state, centroidalModelInfo_));
+  pinocchio::updateFramePlacements(model, data);
+
+  const auto timeStamp = ros::Time::now();
+  publishObservationImpl(timeStamp, observation);
+  publishDesiredTrajectoryImpl(timeStamp, targetTrajectories);
+  publishOptimizedStateTrajectoryImpl(timeStamp, mpcTimeTrajectory, mpcStateTrajectory, modeSchedule);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotVisualizer::publisherWorker() {
+  while (true) {
+    std::unique_lock<std::mutex> lk(bufferMutex_);
+    frameReady_.wait(lk, [&] { return isFrameAvailable_ || terminateThread_; });
+    if (terminateThread_) {
+      break;
+    }
+    publisherFramePtr_.swap(bufferFramePtr_);
+    isFrameAvailable_ = false;
+    lk.unlock();
+
+    const auto& frame = *publisherFramePtr_;
+    publishFrame(frame.observation, frame.timeTrajectory, frame.stateTrajectory, frame.modeSchedule, frame.targetTrajectories);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotVisualizer::shutdownPublisherWorker() {
+  std::unique_lock<std::mutex> lk(bufferMutex_);
+  terminateThread_ = true;
+  lk.unlock();
+  frameReady_.notify_all();
+
+  if (publisherWorker_.joinable()) {
+    publisherWorker_.join();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t LeggedRobotVisualizer::getNumDroppedFrames() const {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  return numDroppedFrames_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LeggedRobotVisualizer::publishObservation(ros::Time timeStamp, const SystemObservation& observation) {
+  std::lock_guard<std::mutex> lock(publishMutex_);
+  publishObservationImpl(timeStamp, observation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotVisualizer::publishObservationImpl(ros::Time timeStamp, const SystemObservation& observation) {
   // Extract components from state
   const auto basePose = centroidal_model::getBasePose(observation.state, centroidalModelInfo_);
   const auto qJoints = centroidal_model::getJointAngles(observation.state, centroidalModelInfo_);
@@ -215,35 +329,29 @@ void LeggedRobotVisualizer::publishCartesianMarkers(ros::Time timeStamp, const c
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LeggedRobotVisualizer::publishDesiredTrajectory(ros::Time timeStamp, const TargetTrajectories& targetTrajectories) {
-  const auto& stateTrajectory = targetTrajectories.stateTrajectory;
-  const auto& inputTrajectory = targetTrajectories.inputTrajectory;
+  std::lock_guard<std::mutex> lock(publishMutex_);
+  publishDesiredTrajectoryImpl(timeStamp, targetTrajectories);
+}
 
-  // Reserve com messages
-  std::vector<geometry_msgs::Point> desiredBasePositionMsg;
-  desiredBasePositionMsg.reserve(stateTrajectory.size());
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotVisualizer::publishDesiredTrajectoryImpl(ros::Time timeStamp, const TargetTrajectories& targetTrajectories) {
+  const auto& stateTrajectory = targetTrajectories.stateTrajectory;
 
-  // Reserve feet messages
-  feet_array_t<std::vector<geometry_msgs::Point>> desiredFeetPositionMsgs;
+  // Reset message buffers
+  resetLineMsg(desiredBaseLineMsg_, Color::green, trajectoryLineWidth_);
   for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-    desiredFeetPositionMsgs[i].reserve(stateTrajectory.size());
+    resetLineMsg(desiredFeetLineMsgs_[i], feetColorMap_[i], trajectoryLineWidth_);
   }
 
-  for (size_t j = 0; j < stateTrajectory.size(); j++) {
-    const auto state = stateTrajectory.at(j);
-    vector_t input(centroidalModelInfo_.inputDim);
-    if (j < inputTrajectory.size()) {
-      input = inputTrajectory.at(j);
-    } else {
-      input.setZero();
-    }
+  decimateTrajectory(targetTrajectories.timeTrajectory, trajectoryResolution_, decimatedIndices_);
+  for (const auto j : decimatedIndices_) {
+    const auto& state = stateTrajectory[j];
 
-    // Construct base pose msg
+    // Fill base position msg
     const auto basePose = centroidal_model::getBasePose(state, centroidalModelInfo_);
-    geometry_msgs::Pose pose;
-    pose.position = getPointMsg(basePose.head<3>());
-
-    // Fill message containers
-    desiredBasePositionMsg.push_back(pose.position);
+    desiredBaseLineMsg_.points.push_back(getPointMsg(basePose.head<3>()));
 
     // Fill feet msgs
     const auto& model = pinocchioInterface_.getModel();
@@ -253,24 +361,20 @@ void LeggedRobotVisualizer::publishDesiredTrajectory(ros::Time timeStamp, const
 
     const auto feetPositions = endEffectorKinematicsPtr_->getPosition(state);
     for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-      geometry_msgs::Pose footPose;
-      footPose.position = getPointMsg(feetPositions[i]);
-      desiredFeetPositionMsgs[i].push_back(footPose.position);
+      desiredFeetLineMsgs_[i].points.push_back(getPointMsg(feetPositions[i]));
     }
   }
 
   // Headers
-  auto comLineMsg = getLineMsg(std::move(desiredBasePositionMsg), Color::green, trajectoryLineWidth_);
-  comLineMsg.header = getHeaderMsg(frameId_, timeStamp);
-  comLineMsg.id = 0;
+  desiredBaseLineMsg_.header = getHeaderMsg(frameId_, timeStamp);
+  desiredBaseLineMsg_.id = 0;
 
   // Publish
-  costDesiredBasePositionPublisher_.publish(comLineMsg);
+  costDesiredBasePositionPublisher_.publish(desiredBaseLineMsg_);
   for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-    auto footLineMsg = getLineMsg(std::move(desiredFeetPositionMsgs[i]), feetColorMap_[i], trajectoryLineWidth_);
-    footLineMsg.header = getHeaderMsg(frameId_, timeStamp);
-    footLineMsg.id = 0;
-    costDesiredFeetPositionPublishers_[i].publish(footLineMsg);
+    desiredFeetLineMsgs_[i].header = getHeaderMsg(frameId_, timeStamp);
+    desiredFeetLineMsgs_[i].id = 0;
+    costDesiredFeetPositionPublishers_[i].publish(desiredFeetLineMsgs_[i]);
   }
 }
 
@@ -279,26 +383,40 @@ void LeggedRobotVisualizer::publishDesiredTrajectory(ros::Time timeStamp, const
 /******************************************************************************************************/
 void LeggedRobotVisualizer::publishOptimizedStateTrajectory(ros::Time timeStamp, const scalar_array_t& mpcTimeTrajectory,
                                                             const vector_array_t& mpcStateTrajectory, const ModeSchedule& modeSchedule) {
+  std::lock_guard<std::mutex> lock(publishMutex_);
+  publishOptimizedStateTrajectoryImpl(timeStamp, mpcTimeTrajectory, mpcStateTrajectory, modeSchedule);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LeggedRobotVisualizer::publishOptimizedStateTrajectoryImpl(ros::Time timeStamp, const scalar_array_t& mpcTimeTrajectory,
+                                                                const vector_array_t& mpcStateTrajectory,
+                                                                const ModeSchedule& modeSchedule) {
   if (mpcTimeTrajectory.empty() || mpcStateTrajectory.empty()) {
     return;  // Nothing to publish
   }
 
-  // Reserve Feet msg
-  feet_array_t<std::vector<geometry_msgs::Point>> feetMsgs;
-  std::for_each(feetMsgs.begin(), feetMsgs.end(), [&](std::vector<geometry_msgs::Point>& v) { v.reserve(mpcStateTrajectory.size()); });
-
-  // Reserve Com Msg
-  std::vector<geometry_msgs::Point> mpcComPositionMsgs;
-  mpcComPositionMsgs.reserve(mpcStateTrajectory.size());
+  // Reset message buffers: 1 trajectory per foot + 1 for the com trajectory + 1 for the future footholds
+  const size_t numContacts = centroidalModelInfo_.numThreeDofContacts;
+  auto& markers = optimizedStateMarkerArray_.markers;
+  markers.resize(numContacts + 2);
+  for (size_t i = 0; i < numContacts; i++) {
+    resetLineMsg(markers[i], feetColorMap_[i], trajectoryLineWidth_);
+    markers[i].ns = "EE Trajectories";
+  }
+  auto& comLineMsg = markers[numContacts];
+  resetLineMsg(comLineMsg, Color::red, trajectoryLineWidth_);
+  comLineMsg.ns = "CoM Trajectory";
 
   // Extract Com and Feet from state
-  std::for_each(mpcStateTrajectory.begin(), mpcStateTrajectory.end(), [&](const vector_t& state) {
+  decimateTrajectory(mpcTimeTrajectory, trajectoryResolution_, decimatedIndices_);
+  for (const auto j : decimatedIndices_) {
+    const auto& state = mpcStateTrajectory[j];
     const auto basePose = centroidal_model::getBasePose(state, centroidalModelInfo_);
 
-    // Fill com position and pose msgs
-    geometry_msgs::Pose pose;
-    pose.position = getPointMsg(basePose.head<3>());
-    mpcComPositionMsgs.push_back(pose.position);
+    // Fill com position msgs
+    comLineMsg.points.push_back(getPointMsg(basePose.head<3>()));
 
     // Fill feet msgs
     const auto& model = pinocchioInterface_.getModel();
@@ -307,31 +425,21 @@ void LeggedRobotVisualizer::publishOptimizedStateTrajectory(ros::Time timeStamp,
     pinocchio::updateFramePlacements(model, data);
 
     const auto feetPositions = endEffectorKinematicsPtr_->getPosition(state);
-    for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-      const auto position = getPointMsg(feetPositions[i]);
-      feetMsgs[i].push_back(position);
+    for (size_t i = 0; i < numContacts; i++) {
+      markers[i].points.push_back(getPointMsg(feetPositions[i]));
     }
-  });
-
-  // Convert feet msgs to Array message
-  visualization_msgs::MarkerArray markerArray;
-  markerArray.markers.reserve(centroidalModelInfo_.numThreeDofContacts +
-                              2);  // 1 trajectory per foot + 1 for the future footholds + 1 for the com trajectory
-  for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
-    markerArray.markers.emplace_back(getLineMsg(std::move(feetMsgs[i]), feetColorMap_[i], trajectoryLineWidth_));
-    markerArray.markers.back().ns = "EE Trajectories";
   }
-  markerArray.markers.emplace_back(getLineMsg(std::move(mpcComPositionMsgs), Color::red, trajectoryLineWidth_));
-  markerArray.markers.back().ns = "CoM Trajectory";
 
   // Future footholds
-  visualization_msgs::Marker sphereList;
+  auto& sphereList = markers.back();
   sphereList.type = visualization_msgs::Marker::SPHERE_LIST;
   sphereList.scale.x = footMarkerDiameter_;
   sphereList.scale.y = footMarkerDiameter_;
   sphereList.scale.z = footMarkerDiameter_;
   sphereList.ns = "Future footholds";
   sphereList.pose.orientation = getOrientationMsg({1., 0., 0., 0.});
+  sphereList.points.clear();
+  sphereList.colors.clear();
   const auto& eventTimes = modeSchedule.eventTimes;
   const auto& subsystemSequence = modeSchedule.modeSequence;
   const auto tStart = mpcTimeTrajectory.front();
@@ -348,7 +456,7 @@ void LeggedRobotVisualizer::publishOptimizedStateTrajectory(ros::Time timeStamp,
       pinocchio::updateFramePlacements(model, data);
 
       const auto feetPosition = endEffectorKinematicsPtr_->getPosition(postEventState);
-      for (size_t i = 0; i < centroidalModelInfo_.numThreeDofContacts; i++) {
+      for (size_t i = 0; i < numContacts; i++) {
         if (!preEventContactFlags[i] && postEventContactFlags[i]) {  // If a foot lands, a marker is added at that location.
           sphereList.points.emplace_back(getPointMsg(feetPosition[i]));
           sphereList.colors.push_back(getColor(feetColorMap_[i]));
@@ -356,13 +464,12 @@ void LeggedRobotVisualizer::publishOptimizedStateTrajectory(ros::Time timeStamp,
       }
     }
   }
-  markerArray.markers.push_back(std::move(sphereList));
 
   // Add headers and Id
-  assignHeader(markerArray.markers.begin(), markerArray.markers.end(), getHeaderMsg(frameId_, timeStamp));
-  assignIncreasingId(markerArray.markers.begin(), markerArray.markers.end());
+  assignHeader(markers.begin(), markers.end(), getHeaderMsg(frameId_, timeStamp));
+  assignIncreasingId(markers.begin(), markers.end());
 
-  stateOptimizedPublisher_.publish(markerArray);
+  stateOptimizedPublisher_.publish(optimizedStateMarkerArray_);
 }
 
 }  // namespace legged_robot
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
 
 namespace ocs2 {
 namespace mobile_manipulator {
@@ -45,8 +46,9 @@ class QuadraticInputCost final : public QuadraticStateInputCost {
   QuadraticInputCost* clone() const override { return new QuadraticInputCost(*this); }
 
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
-    const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
+                                                       const TargetTrajectories& targetTrajectories,
+                                                       const PreComputation& preComputation) const override {
+    const vector_t inputDeviation = input - getDesiredInput(time, targetTrajectories, preComputation);
     return {vector_t::Zero(stateDim_), inputDeviation};
   }
 
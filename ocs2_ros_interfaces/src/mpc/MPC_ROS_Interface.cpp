@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h"
 
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
+
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
 namespace ocs2 {
@@ -317,6 +319,9 @@ void MPC_ROS_Interface::shutdownNode() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_ROS_Interface::spin() {
+  // the MPC runs in the observation callback, i.e. in this thread
+  setThisThreadAffinity(mpc_.settings().mpcThreadAffinity_);
+
   ROS_INFO_STREAM("Start spinning now ...");
   // Equivalent to ros::spin() + check if master is alive
   while (::ros::ok() && ::ros::master::check()) {
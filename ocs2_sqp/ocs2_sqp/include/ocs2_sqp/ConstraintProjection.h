@@ -59,4 +59,65 @@ VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLin
  */
 VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLinearApproximation& constraint);
 
+/**
+ * Workspace for repeated constraint projections. It owns the decomposition of D and the matrices derived from it, such that
+ * consecutive calls with constraints of equal size do not allocate. Each thread should use its own instance.
+ *
+ * The projection is computed as
+ *  Pu = null(D), Px = -D^+ * C, Pe = -D^+ * e
+ *
+ * where D^+ is a right inverse of D. When factorization reuse is enabled and D is identical to the one of the previous call, only
+ * the products with C and e are evaluated and the decomposition is skipped.
+ */
+class ConstraintProjector {
+ public:
+  enum class Method { LU, QR };
+
+  /**
+   * Constructor
+   *
+   * @param [in] method : Decomposition used to compute the projection.
+   * @param [in] reuseFactorization : Skip the decomposition if D did not change since the previous call.
+   */
+  explicit ConstraintProjector(Method method = Method::LU, bool reuseFactorization = false);
+
+  /**
+   * Computes the projection of the given constraint.
+   *
+   * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+   * @param [out] projection : Px = dfdx, Pu = dfdu, Pe = f; The memory of the output is reused.
+   */
+  void computeProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projection);
+
+  /**
+   * Computes the projection of the given constraint and directly applies the change of input variables to the dynamics and cost.
+   *
+   * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+   * @param [in, out] dynamics : Linear dynamics that are projected in-place.
+   * @param [in, out] cost : Quadratic cost that is projected in-place.
+   * @param [out] projection : Px = dfdx, Pu = dfdu, Pe = f;
+   */
+  void projectLinearQuadratic(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& dynamics,
+                              ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& projection);
+
+  /** Number of calls in which the decomposition of D was reused. */
+  size_t getNumReusedFactorizations() const { return numReusedFactorizations_; }
+
+ private:
+  bool isFactorizationValid(const matrix_t& D) const;
+  void factorize(const matrix_t& D);
+
+  Method method_;
+  bool reuseFactorization_;
+  bool hasFactorization_ = false;
+  size_t numReusedFactorizations_ = 0;
+
+  Eigen::FullPivLU<matrix_t> lu_;
+  Eigen::HouseholderQR<matrix_t> qr_;
+  matrix_t Q_;
+  matrix_t lastD_;
+  matrix_t nullSpace_;        // Pu
+  matrix_t negRightInverse_;  // -D^+
+};
+
 }  // namespace ocs2
\ No newline at end of file
@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_sqp/TimeDiscretization.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Decides which inputs are tied to the input of the previous node. A node is blocked if it starts at least startTime after the start of
+ * the horizon, both it and the previous node have an input of the same size, and the block it belongs to has less than blockSize nodes.
+ * Event nodes have no input and therefore always end a block.
+ *
+ * @param time : The time discretization.
+ * @param cost : Quadratic approximation of the cost, used to read the input size of each node.
+ * @param startTime : Time from the start of the horizon after which inputs are blocked.
+ * @param blockSize : Maximum number of consecutive nodes that share one input. 1 disables move-blocking.
+ * @return For each of the N stages, true if the input of the node is tied to the input of the previous node.
+ */
+std::vector<bool> getMoveBlockingPattern(const std::vector<AnnotatedTime>& time,
+                                         const std::vector<ScalarFunctionQuadraticApproximation>& cost, scalar_t startTime,
+                                         size_t blockSize);
+
+/**
+ * Transforms the LQ problem into a problem with less decision variables by tying the blocked inputs to the previous input.
+ * The held input is carried in the state: the state of a blocked node becomes [x; u], with zero input, and the node that starts a
+ * block passes its input on through the dynamics. The carried input is the input increment of the LQ problem, therefore the
+ * difference of the nominal inputs is added on its way, such that the full step ties the nominal inputs as well.
+ *
+ * @param [in] isBlocked : The move-blocking pattern of getMoveBlockingPattern.
+ * @param [in] inputs : The nominal inputs around which the LQ problem is approximated. If nullptr, only the increments are tied.
+ * @param [in] dynamics : Linearized approximation of the discrete dynamics.
+ * @param [in] cost : Quadratic approximation of the cost.
+ * @param [in] constraints : Linearized approximation of constraints. Can be nullptr.
+ * @param [out] blockedDynamics : Dynamics of the move-blocked problem.
+ * @param [out] blockedCost : Cost of the move-blocked problem.
+ * @param [out] blockedConstraints : Constraints of the move-blocked problem. Only set if constraints are given.
+ */
+void blockInputs(const std::vector<bool>& isBlocked, const vector_array_t* inputs,
+                 const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                 const std::vector<VectorFunctionLinearApproximation>* constraints,
+                 std::vector<VectorFunctionLinearApproximation>& blockedDynamics,
+                 std::vector<ScalarFunctionQuadraticApproximation>& blockedCost,
+                 std::vector<VectorFunctionLinearApproximation>* blockedConstraints);
+
+/**
+ * Maps the solution of the move-blocked problem back to per-node states and inputs.
+ *
+ * @param [in] isBlocked : The move-blocking pattern of getMoveBlockingPattern.
+ * @param [in] cost : Quadratic approximation of the cost of the original problem, used to read the state size of each node.
+ * @param [in, out] stateTrajectory : Solution state trajectory of the move-blocked problem, replaced by the original states.
+ * @param [in, out] inputTrajectory : Solution input trajectory of the move-blocked problem, replaced by the original inputs.
+ */
+void expandBlockedSolution(const std::vector<bool>& isBlocked, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                           vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
+/**
+ * Minimizes the cost-to-go V([x; u]) of a blocked node over the held input u.
+ *
+ * @param [in] costToGo : Cost-to-go of the move-blocked problem at a blocked node.
+ * @param [in] stateDim : Size of the original state x.
+ * @return Cost-to-go as a function of x only.
+ */
+ScalarFunctionQuadraticApproximation minimizeOverBlockedInput(const ScalarFunctionQuadraticApproximation& costToGo, int stateDim);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
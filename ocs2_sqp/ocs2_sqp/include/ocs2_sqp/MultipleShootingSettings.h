@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <vector>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
@@ -61,13 +64,22 @@ struct Settings {
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;                                          // user-defined time discretization at the start of the horizon
+  scalar_t dtGrowthFactor = 1.0;                               // ratio between consecutive time steps, 1.0 gives a uniform discretization
+  scalar_t dtMax = std::numeric_limits<scalar_t>::infinity();  // upper bound on the growing time step
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
+  // Move-blocking: inputs of consecutive nodes in the later horizon share one decision variable in the QP subproblem.
+  // With projectStateInputEqualityConstraints, the projected inputs are tied instead of the inputs. The feedback of a blocked node
+  // approximates the Riccati feedback of the node that starts its block, applied to the own state and projection of the node.
+  scalar_t moveBlockingStartTime = 0.0;  // time from the start of the horizon after which inputs are blocked
+  size_t moveBlockingBlockSize = 1;      // maximum number of nodes that share one input, 1 disables move-blocking
+
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
   scalar_t inequalityConstraintDelta = 1e-6;
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
+  bool reuseConstraintProjection = false;            // Skip the decomposition of D if it is identical to the one of the previous node
 
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
@@ -77,6 +89,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  std::vector<int> threadAffinity;   // CPUs of the nThreads - 1 pool workers, loaded from a list, see parseCpuList. Empty for no pinning.
+  bool adaptiveThreadCount = false;  // Reduce the number of active threads while the LQ approximation does not slow down
 };
 
 /**
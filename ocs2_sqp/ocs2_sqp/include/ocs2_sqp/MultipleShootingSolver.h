@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/initialization/Initializer.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/reference/SampledTargetTrajectories.h>
+#include <ocs2_core/thread_support/AdaptiveThreadCount.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
@@ -39,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <hpipm_catkin/HpipmInterface.h>
 
+#include "ocs2_sqp/ConstraintProjection.h"
 #include "ocs2_sqp/MultipleShootingSettings.h"
 #include "ocs2_sqp/MultipleShootingSolverStatus.h"
 #include "ocs2_sqp/TimeDiscretization.h"
@@ -64,7 +67,7 @@ class MultipleShootingSolver : public SolverBase {
 
   scalar_t getFinalTime() const override { return primalSolution_.timeTrajectory_.back(); };
 
-  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override { *primalSolutionPtr = primalSolution_; }
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override;
 
   const DualSolution& getDualSolution() const override {
     throw std::runtime_error("[MultipleShootingSolver] getDualSolution() not available yet.");
@@ -117,7 +120,7 @@ class MultipleShootingSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
-  /** Run a task in parallel with settings.nThreads */
+  /** Run a task in parallel with settings.nThreads, or fewer if the thread count is adapted */
   void runParallel(std::function<void(int)> taskFunction);
 
   /** Get profiling information as a string */
@@ -141,7 +144,7 @@ class MultipleShootingSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0, const vector_array_t& u);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
@@ -169,10 +172,13 @@ class MultipleShootingSolver : public SolverBase {
   DynamicsDiscretizer discretizer_;
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
+  std::vector<ConstraintProjector> constraintProjectors_;
   std::unique_ptr<Initializer> initializerPtr_;
+  SampledTargetTrajectories sampledTargetTrajectories_;  // view of the reference manager's target trajectories, sampled on the nodes
 
   // Threading
   ThreadPool threadPool_;
+  AdaptiveThreadCount threadCount_;
 
   // Solution
   PrimalSolution primalSolution_;
@@ -189,6 +195,13 @@ class MultipleShootingSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> constraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
 
+  // Move-blocked LQ approximation, which is solved instead of the above if any input is blocked
+  std::vector<bool> isBlockedNode_;
+  bool useMoveBlocking_ = false;
+  std::vector<VectorFunctionLinearApproximation> blockedDynamics_;
+  std::vector<ScalarFunctionQuadraticApproximation> blockedCost_;
+  std::vector<VectorFunctionLinearApproximation> blockedConstraints_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
 
+#include "ocs2_sqp/ConstraintProjection.h"
+
 namespace ocs2 {
 namespace multiple_shooting {
 
@@ -65,6 +67,23 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * Compute the multiple shooting transcription for a single intermediate node, using a persistent projection workspace.
+ *
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param sensitivityDiscretizer : Integrator to use for creating the discrete dynamics.
+ * @param constraintProjectorPtr : Workspace to project the state-input equality constraints with. Pass nullptr to keep the constraints.
+ * @param t : Start of the discrete interval
+ * @param dt : Duration of the interval
+ * @param x : State at start of the interval
+ * @param x_next : State at the end of the interval
+ * @param u : Input, taken to be constant across the interval.
+ * @return multiple shooting transcription for this node.
+ */
+Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
+                                    DynamicsSensitivityDiscretizer& sensitivityDiscretizer, ConstraintProjector* constraintProjectorPtr,
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
+
 /**
  * Compute only the performance index for a single intermediate node.
  * Corresponds to the performance index returned by "setupIntermediateNode"
@@ -60,6 +60,9 @@ scalar_t getIntervalEnd(const AnnotatedTime& end);
 /** Computes the interval duration that respects interpolation rules around event times */
 scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& end);
 
+/** Computes the times at which the nodes of a time discretization are evaluated, i.e. the interval starts */
+scalar_array_t getNodeTimes(const std::vector<AnnotatedTime>& timeDiscretization);
+
 /**
  * Decides on time discretization along the horizon. Tries to makes step of dt, but will also ensure that eventtimes are part of the
  * discretization.
@@ -76,4 +79,24 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * Decides on a non-uniform time discretization along the horizon. The desired step grows linearly with the time since initTime,
+ *    dt(t) = min(dt + (dtGrowthFactor - 1) * (t - initTime), dtMax),
+ * such that without events consecutive steps grow geometrically by dtGrowthFactor until they reach dtMax. Since the step only depends on
+ * the time, the grid restarts consistently after each event. With dtGrowthFactor = 1 the discretization is uniform.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : desired discretization step at the start of the horizon.
+ * @param dtGrowthFactor : ratio between consecutive discretization steps. Needs to be at least 1.
+ * @param dtMax : maximum discretization step.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtGrowthFactor,
+                                                        scalar_t dtMax, const scalar_array_t& eventTimes,
+                                                        scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
 }  // namespace ocs2
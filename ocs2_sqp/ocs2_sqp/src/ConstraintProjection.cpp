@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/ConstraintProjection.h"
 
+#include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
+
 namespace ocs2 {
 
 VectorFunctionLinearApproximation qrConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
@@ -64,4 +66,61 @@ VectorFunctionLinearApproximation luConstraintProjection(const VectorFunctionLin
   return projectionTerms;
 }
 
-}  // namespace ocs2
\ No newline at end of file
+ConstraintProjector::ConstraintProjector(Method method, bool reuseFactorization)
+    : method_(method), reuseFactorization_(reuseFactorization) {}
+
+void ConstraintProjector::computeProjection(const VectorFunctionLinearApproximation& constraint,
+                                            VectorFunctionLinearApproximation& projection) {
+  if (isFactorizationValid(constraint.dfdu)) {
+    ++numReusedFactorizations_;
+  } else {
+    factorize(constraint.dfdu);
+  }
+
+  projection.dfdu = nullSpace_;
+  projection.dfdx.noalias() = negRightInverse_ * constraint.dfdx;
+  projection.f.noalias() = negRightInverse_ * constraint.f;
+}
+
+void ConstraintProjector::projectLinearQuadratic(const VectorFunctionLinearApproximation& constraint,
+                                                 VectorFunctionLinearApproximation& dynamics, ScalarFunctionQuadraticApproximation& cost,
+                                                 VectorFunctionLinearApproximation& projection) {
+  computeProjection(constraint, projection);
+  changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
+  changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
+}
+
+bool ConstraintProjector::isFactorizationValid(const matrix_t& D) const {
+  // An exact comparison is cheap compared to the decomposition, and constant constraint Jacobians are reproduced bit-wise.
+  return reuseFactorization_ && hasFactorization_ && lastD_.rows() == D.rows() && lastD_.cols() == D.cols() && lastD_ == D;
+}
+
+void ConstraintProjector::factorize(const matrix_t& D) {
+  const auto numConstraints = D.rows();
+  const auto numInputs = D.cols();
+
+  switch (method_) {
+    case Method::LU: {
+      lu_.compute(D);
+      nullSpace_ = lu_.kernel();
+      negRightInverse_ = -lu_.solve(matrix_t::Identity(numConstraints, numConstraints));
+      break;
+    }
+    case Method::QR: {
+      qr_.compute(D.transpose());
+      Q_ = qr_.householderQ();
+      nullSpace_ = Q_.rightCols(numInputs - numConstraints);
+      // -D^+ = -Q1 * inv(R^T)
+      const auto RT = qr_.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>().transpose();
+      negRightInverse_ = -Q_.leftCols(numConstraints) * RT.solve(matrix_t::Identity(numConstraints, numConstraints));
+      break;
+    }
+  }
+
+  if (reuseFactorization_) {
+    lastD_ = D;
+  }
+  hasFactorization_ = true;
+}
+
+}  // namespace ocs2
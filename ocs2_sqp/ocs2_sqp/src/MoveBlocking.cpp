@@ -0,0 +1,184 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sqp/MoveBlocking.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+std::vector<bool> getMoveBlockingPattern(const std::vector<AnnotatedTime>& time,
+                                         const std::vector<ScalarFunctionQuadraticApproximation>& cost, scalar_t startTime,
+                                         size_t blockSize) {
+  const int N = static_cast<int>(time.size()) - 1;
+  std::vector<bool> isBlocked(N, false);
+  if (blockSize < 2) {
+    return isBlocked;
+  }
+
+  // The first node is never blocked, its state is not a decision variable.
+  size_t numNodesInBlock = 1;
+  for (int i = 1; i < N; i++) {
+    const auto numInputs = cost[i].dfdu.size();
+    const bool sameInputSize = numInputs > 0 && numInputs == cost[i - 1].dfdu.size();
+    const bool afterStartTime = time[i].time - time.front().time >= startTime;
+    if (sameInputSize && afterStartTime && numNodesInBlock < blockSize) {
+      isBlocked[i] = true;
+      ++numNodesInBlock;
+    } else {
+      numNodesInBlock = 1;
+    }
+  }
+
+  return isBlocked;
+}
+
+void blockInputs(const std::vector<bool>& isBlocked, const vector_array_t* inputs,
+                 const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                 const std::vector<VectorFunctionLinearApproximation>* constraints,
+                 std::vector<VectorFunctionLinearApproximation>& blockedDynamics,
+                 std::vector<ScalarFunctionQuadraticApproximation>& blockedCost,
+                 std::vector<VectorFunctionLinearApproximation>* blockedConstraints) {
+  const int N = static_cast<int>(dynamics.size());
+  blockedDynamics.resize(N);
+  blockedCost.resize(N + 1);
+  if (constraints != nullptr) {
+    blockedConstraints->resize(N + 1);
+  }
+
+  for (int i = 0; i < N; i++) {
+    const auto& A = dynamics[i].dfdx;
+    const auto& B = dynamics[i].dfdu;
+    const int nx = A.cols();
+    const int nu = B.cols();
+    const int nxNext = A.rows();
+    // Input held from node i to the next node
+    const bool carryInput = (i + 1 < N) && isBlocked[i + 1];
+    const int nxBlockedNext = carryInput ? nxNext + nu : nxNext;
+
+    auto& blockedDynamicsNode = blockedDynamics[i];
+    blockedDynamicsNode.f.setZero(nxBlockedNext);
+    blockedDynamicsNode.f.head(nxNext) = dynamics[i].f;
+    if (carryInput && inputs != nullptr) {
+      // du_next = du + u - u_next, such that u_next + du_next = u + du
+      blockedDynamicsNode.f.tail(nu) = (*inputs)[i] - (*inputs)[i + 1];
+    }
+
+    if (isBlocked[i]) {
+      // The state is [x; u] and there is no input: x_next = A x + B u + b, u_next = u
+      blockedDynamicsNode.dfdx.setZero(nxBlockedNext, nx + nu);
+      blockedDynamicsNode.dfdx.topLeftCorner(nxNext, nx) = A;
+      blockedDynamicsNode.dfdx.topRightCorner(nxNext, nu) = B;
+      if (carryInput) {
+        blockedDynamicsNode.dfdx.bottomRightCorner(nu, nu).setIdentity();
+      }
+      blockedDynamicsNode.dfdu.setZero(nxBlockedNext, 0);
+
+      // Cost in [x; u]
+      auto& blockedCostNode = blockedCost[i];
+      blockedCostNode.dfdxx.resize(nx + nu, nx + nu);
+      blockedCostNode.dfdxx.topLeftCorner(nx, nx) = cost[i].dfdxx;
+      blockedCostNode.dfdxx.bottomLeftCorner(nu, nx) = cost[i].dfdux;
+      blockedCostNode.dfdxx.topRightCorner(nx, nu) = cost[i].dfdux.transpose();
+      blockedCostNode.dfdxx.bottomRightCorner(nu, nu) = cost[i].dfduu;
+      blockedCostNode.dfdx.resize(nx + nu);
+      blockedCostNode.dfdx << cost[i].dfdx, cost[i].dfdu;
+      blockedCostNode.dfduu.resize(0, 0);
+      blockedCostNode.dfdux.resize(0, nx + nu);
+      blockedCostNode.dfdu.resize(0);
+      blockedCostNode.f = cost[i].f;
+
+      // Constraints in [x; u]
+      if (constraints != nullptr) {
+        const auto& constraintsNode = (*constraints)[i];
+        auto& blockedConstraintsNode = (*blockedConstraints)[i];
+        blockedConstraintsNode.f = constraintsNode.f;
+        blockedConstraintsNode.dfdx.resize(constraintsNode.f.size(), nx + nu);
+        blockedConstraintsNode.dfdx << constraintsNode.dfdx, constraintsNode.dfdu;
+        blockedConstraintsNode.dfdu.setZero(constraintsNode.f.size(), 0);
+      }
+    } else {
+      // Regular node, which passes its input on if the next node is blocked
+      blockedDynamicsNode.dfdx.setZero(nxBlockedNext, nx);
+      blockedDynamicsNode.dfdx.topRows(nxNext) = A;
+      blockedDynamicsNode.dfdu.setZero(nxBlockedNext, nu);
+      blockedDynamicsNode.dfdu.topRows(nxNext) = B;
+      if (carryInput) {
+        blockedDynamicsNode.dfdu.bottomRows(nu).setIdentity();
+      }
+      blockedCost[i] = cost[i];
+      if (constraints != nullptr) {
+        (*blockedConstraints)[i] = (*constraints)[i];
+      }
+    }
+  }
+
+  // Terminal node is never blocked
+  blockedCost[N] = cost[N];
+  if (constraints != nullptr) {
+    (*blockedConstraints)[N] = (*constraints)[N];
+  }
+}
+
+void expandBlockedSolution(const std::vector<bool>& isBlocked, const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                           vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  for (size_t i = 0; i < isBlocked.size(); i++) {
+    if (isBlocked[i]) {
+      const int nx = cost[i].dfdx.size();
+      const int nu = stateTrajectory[i].size() - nx;
+      inputTrajectory[i] = stateTrajectory[i].tail(nu);
+      stateTrajectory[i].conservativeResize(nx);
+    }
+  }
+}
+
+ScalarFunctionQuadraticApproximation minimizeOverBlockedInput(const ScalarFunctionQuadraticApproximation& costToGo, int stateDim) {
+  const int nu = costToGo.dfdx.size() - stateDim;
+  const auto Vxx = costToGo.dfdxx.topLeftCorner(stateDim, stateDim);
+  const auto Vux = costToGo.dfdxx.bottomLeftCorner(nu, stateDim);
+  const matrix_t Vuu = costToGo.dfdxx.bottomRightCorner(nu, nu);
+  const auto vx = costToGo.dfdx.head(stateDim);
+  const auto vu = costToGo.dfdx.tail(nu);
+
+  // u* = -Vuu^{-1} (Vux x + vu)
+  const Eigen::LDLT<matrix_t> VuuLdlt(Vuu);
+  const matrix_t VuuInvVux = VuuLdlt.solve(Vux);
+  const vector_t VuuInvvu = VuuLdlt.solve(vu);
+
+  ScalarFunctionQuadraticApproximation minimizedCostToGo;
+  minimizedCostToGo.dfdxx = Vxx;
+  minimizedCostToGo.dfdxx.noalias() -= Vux.transpose() * VuuInvVux;
+  minimizedCostToGo.dfdx = vx;
+  minimizedCostToGo.dfdx.noalias() -= Vux.transpose() * VuuInvvu;
+  minimizedCostToGo.f = costToGo.f - 0.5 * vu.dot(VuuInvvu);
+  return minimizedCostToGo;
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/property_tree/ptree.hpp>
 
 #include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/thread_support/SetThreadAffinity.h>
 
 namespace ocs2 {
 namespace multiple_shooting {
@@ -58,19 +59,28 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
+  loadData::loadPtreeValue(pt, settings.moveBlockingStartTime, fieldName + ".moveBlockingStartTime", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingBlockSize, fieldName + ".moveBlockingBlockSize", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
+  loadData::loadPtreeValue(pt, settings.reuseConstraintProjection, fieldName + ".reuseConstraintProjection", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  std::string threadAffinity;
+  loadData::loadPtreeValue(pt, threadAffinity, fieldName + ".threadAffinity", verbose);
+  settings.threadAffinity = parseCpuList(threadAffinity);
+  loadData::loadPtreeValue(pt, settings.adaptiveThreadCount, fieldName + ".adaptiveThreadCount", verbose);
 
   if (verbose) {
     std::cerr << settings.hpipmSettings;
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 
@@ -36,6 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/penalties/penalties/RelaxedBarrierPenalty.h>
 
+#include "ocs2_sqp/MoveBlocking.h"
 #include "ocs2_sqp/MultipleShootingInitialization.h"
 #include "ocs2_sqp/MultipleShootingTranscription.h"
 
@@ -46,17 +48,19 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
     : SolverBase(),
       settings_(std::move(settings)),
       hpipmInterface_(hpipm_interface::OcpSize(), settings.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority, settings_.threadAffinity),
+      threadCount_(settings_.nThreads) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
-  // Dynamics discretization
+  // Dynamics discretization (uses the generated discrete flow map of SystemDynamicsBaseAD models if available)
   discretizer_ = selectDynamicsDiscretization(settings.integratorType);
   sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings.integratorType);
 
   // Clone objects to have one for each worker
   for (int w = 0; w < settings.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
+    constraintProjectors_.emplace_back(ConstraintProjector::Method::LU, settings.reuseConstraintProjection);
   }
 
   // Operating points
@@ -86,6 +90,9 @@ void MultipleShootingSolver::reset() {
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+
+  // restart the thread count adaptation
+  threadCount_.reset();
 }
 
 std::string MultipleShootingSolver::getBenchmarkingInformation() const {
@@ -122,6 +129,11 @@ const std::vector<PerformanceIndex>& MultipleShootingSolver::getIterationsLog()
   }
 }
 
+void MultipleShootingSolver::getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const {
+  // Only copy the part of the solution that is requested, reusing the memory of the destination
+  getTimeSlicedPrimalSolution(primalSolution_, finalTime, *primalSolutionPtr);
+}
+
 ScalarFunctionQuadraticApproximation MultipleShootingSolver::getValueFunction(scalar_t time, const vector_t& state) const {
   if (valueFunction_.empty()) {
     throw std::runtime_error("[MultipleShootingSolver] Value function is empty! Is createValueFunction true and did the solver run?");
@@ -152,16 +164,19 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization =
+      timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax, eventTimes);
 
   // Initialize the state and input
   vector_array_t x, u;
   initializeStateInputTrajectories(initState, timeDiscretization, x, u);
 
-  // Initialize references
+  // Initialize references, pre-sampled on the nodes such that the cost terms do not interpolate them in every iteration
+  const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+  sampledTargetTrajectories_.update(targetTrajectories, getNodeTimes(timeDiscretization));
   for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.preComputationPtr->setSampledTargetTrajectoriesPtr(&sampledTargetTrajectories_);
   }
 
   // Bookkeeping
@@ -177,11 +192,14 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     linearQuadraticApproximationTimer_.startTimer();
     const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
     linearQuadraticApproximationTimer_.endTimer();
+    if (settings_.adaptiveThreadCount) {
+      threadCount_.update(linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds());
+    }
 
     // Solve QP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto deltaSolution = getOCPSolution(delta_x0, u);
     extractValueFunction(timeDiscretization, x);
     solveQpTimer_.endTimer();
 
@@ -199,6 +217,11 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     ++totalNumIterations_;
   }
 
+  // Detach the sampled references, the reference manager swaps the next target trajectories into the same object
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    ocpDefinition.preComputationPtr->setSampledTargetTrajectoriesPtr(nullptr);
+  }
+
   computeControllerTimer_.startTimer();
   setPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   computeControllerTimer_.endTimer();
@@ -214,7 +237,7 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
 }
 
 void MultipleShootingSolver::runParallel(std::function<void(int)> taskFunction) {
-  threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
+  threadPool_.runParallel(std::move(taskFunction), threadCount_.get());
 }
 
 void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& initState,
@@ -265,25 +288,39 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
   }
 }
 
-MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0) {
+MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0, const vector_array_t& u) {
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
   hpipm_status status;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, &constraints_));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, &constraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  // without constraints, or when using projection, we have an unconstrained QP.
+  const bool hasQpConstraints = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+
+  // Solve the move-blocked QP if any inputs are tied together
+  auto& qpDynamics = useMoveBlocking_ ? blockedDynamics_ : dynamics_;
+  auto& qpCost = useMoveBlocking_ ? blockedCost_ : cost_;
+  auto* qpConstraints = hasQpConstraints ? (useMoveBlocking_ ? &blockedConstraints_ : &constraints_) : nullptr;
+  if (useMoveBlocking_) {
+    // The projected inputs have no nominal value, hence only their increments are tied
+    const bool hasProjectedInputs = hasStateInputConstraints && settings_.projectStateInputEqualityConstraints;
+    const auto* nominalInputs = hasProjectedInputs ? nullptr : &u;
+    multiple_shooting::blockInputs(isBlockedNode_, nominalInputs, dynamics_, cost_, hasQpConstraints ? &constraints_ : nullptr,
+                                   blockedDynamics_, blockedCost_, qpConstraints);
   }
 
+  hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(qpDynamics, qpCost, qpConstraints));
+  status = hpipmInterface_.solve(delta_x0, qpDynamics, qpCost, qpConstraints, deltaXSol, deltaUSol, settings_.printSolverStatus);
+
   if (status != hpipm_status::SUCCESS) {
     throw std::runtime_error("[MultipleShootingSolver] Failed to solve QP");
   }
 
+  if (useMoveBlocking_) {
+    multiple_shooting::expandBlockedSolution(isBlockedNode_, cost_, deltaXSol, deltaUSol);
+  }
+
   // To determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
   solution.armijoDescentMetric = 0.0;
   for (int i = 0; i < cost_.size(); i++) {
@@ -312,7 +349,17 @@ MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolu
 
 void MultipleShootingSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    if (useMoveBlocking_) {
+      valueFunction_ = hpipmInterface_.getRiccatiCostToGo(blockedDynamics_[0], blockedCost_[0]);
+      // The held input is optimal for the cost-to-go of the node that starts the block
+      for (int i = 0; i < isBlockedNode_.size(); ++i) {
+        if (isBlockedNode_[i]) {
+          valueFunction_[i] = multiple_shooting::minimizeOverBlockedInput(valueFunction_[i], x[i].size());
+        }
+      }
+    } else {
+      valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    }
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -338,7 +385,17 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
     // see doc/LQR_full.pdf for detailed derivation for feedback terms
     uff = u;  // Copy and adapt in loop
     controllerGain.reserve(time.size());
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices = useMoveBlocking_ ? hpipmInterface_.getRiccatiFeedback(blockedDynamics_[0], blockedCost_[0])
+                                                : hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    if (useMoveBlocking_) {
+      // The blocked inputs have no feedback in the QP, reuse the Riccati feedback of the node that starts the block.
+      // It is mapped through the projection of the blocked node itself below.
+      for (int i = 1; i < isBlockedNode_.size(); i++) {
+        if (isBlockedNode_[i]) {
+          KMatrices[i] = KMatrices[i - 1];
+        }
+      }
+    }
     for (int i = 0; (i + 1) < time.size(); i++) {
       if (time[i].event == AnnotatedTime::Event::PreEvent && i > 0) {
         uff[i] = uff[i - 1];
@@ -398,7 +455,7 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-    const bool projection = settings_.projectStateInputEqualityConstraints;
+    ConstraintProjector* projectorPtr = settings_.projectStateInputEqualityConstraints ? &constraintProjectors_[workerId] : nullptr;
 
     int i = timeIndex++;
     while (i < N) {
@@ -415,7 +472,7 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
         auto result =
-            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1], u[i]);
+            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projectorPtr, ti, dt, x[i], x[i + 1], u[i]);
         workerPerformance += result.performance;
         dynamics_[i] = std::move(result.dynamics);
         cost_[i] = std::move(result.cost);
@@ -439,6 +496,10 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
   };
   runParallel(std::move(parallelTask));
 
+  // Tie inputs in the later horizon together
+  isBlockedNode_ = multiple_shooting::getMoveBlockingPattern(time, cost_, settings_.moveBlockingStartTime, settings_.moveBlockingBlockSize);
+  useMoveBlocking_ = std::any_of(isBlockedNode_.begin(), isBlockedNode_.end(), [](bool isBlocked) { return isBlocked; });
+
   // Account for init state in performance
   performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
@@ -29,17 +29,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingTranscription.h"
 
-#include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
-#include "ocs2_sqp/ConstraintProjection.h"
-
 namespace ocs2 {
 namespace multiple_shooting {
 
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
+  if (projectStateInputEqualityConstraints) {
+    ConstraintProjector constraintProjector;
+    return setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, &constraintProjector, t, dt, x, x_next, u);
+  } else {
+    return setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, nullptr, t, dt, x, x_next, u);
+  }
+}
+
+Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
+                                    DynamicsSensitivityDiscretizer& sensitivityDiscretizer, ConstraintProjector* constraintProjectorPtr,
+                                    scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
   // Results and short-hand notation
   Transcription transcription;
   auto& dynamics = transcription.dynamics;
@@ -69,14 +77,10 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
     constraints = optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
     if (constraints.f.size() > 0) {
       performance.equalityConstraintsSSE = dt * constraints.f.squaredNorm();
-      if (projectStateInputEqualityConstraints) {  // Handle equality constraints using projection.
-        // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
-        projection = luConstraintProjection(constraints);
+      if (constraintProjectorPtr != nullptr) {  // Handle equality constraints using projection.
+        // Projection stored instead of constraint, dynamics and cost are adapted in the same pass
+        constraintProjectorPtr->projectLinearQuadratic(constraints, dynamics, cost, projection);
         constraints = VectorFunctionLinearApproximation();
-
-        // Adapt dynamics and cost
-        changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-        changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
       }
     }
   }
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/TimeDiscretization.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
@@ -57,9 +60,24 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
   return getIntervalEnd(end) - getIntervalStart(start);
 }
 
+scalar_array_t getNodeTimes(const std::vector<AnnotatedTime>& timeDiscretization) {
+  scalar_array_t nodeTimes;
+  nodeTimes.reserve(timeDiscretization.size());
+  std::transform(timeDiscretization.cbegin(), timeDiscretization.cend(), std::back_inserter(nodeTimes),
+                 [](const AnnotatedTime& annotatedTime) { return getIntervalStart(annotatedTime); });
+  return nodeTimes;
+}
+
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
+  return timeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, dt, eventTimes, dt_min);
+}
+
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtGrowthFactor,
+                                                        scalar_t dtMax, const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(dt > 0);
+  assert(dtGrowthFactor >= 1.0);
+  assert(dtMax >= dt);
   assert(finalTime > initTime);
   std::vector<AnnotatedTime> timeDiscretization;
 
@@ -70,7 +88,8 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   // Fill iteratively with pre event, post events are added later
   AnnotatedTime nextNode = timeDiscretization.back();
   while (timeDiscretization.back().time < finalTime) {
-    nextNode.time = nextNode.time + dt;
+    const scalar_t desiredDt = std::min(dt + (dtGrowthFactor - 1.0) * (nextNode.time - initTime), dtMax);
+    nextNode.time = nextNode.time + desiredDt;
     nextNode.event = AnnotatedTime::Event::None;
 
     // Check if an event has passed
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "ocs2_sqp/TimeDiscretization.h"
 
 using namespace ocs2;
@@ -127,4 +129,73 @@ TEST(test_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+
+TEST(test_discretization, growingSteps) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.5;
+  scalar_t dt = 0.01;
+  scalar_t dtGrowthFactor = 1.1;
+  scalar_t dtMax = 0.1;
+  scalar_array_t eventTimes{};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, dt, dtGrowthFactor, dtMax, eventTimes);
+  ASSERT_EQ(time.front().time, initTime);
+  ASSERT_EQ(time.back().time, finalTime);
+  ASSERT_DOUBLE_EQ(time[1].time - time[0].time, dt);
+  ASSERT_DOUBLE_EQ(time[2].time - time[1].time, dtGrowthFactor * dt);
+
+  // Steps grow geometrically until they are capped by dtMax, only the last step can be shorter
+  for (size_t i = 1; i + 2 < time.size(); i++) {
+    const scalar_t previousDt = time[i].time - time[i - 1].time;
+    const scalar_t currentDt = time[i + 1].time - time[i].time;
+    ASSERT_NEAR(currentDt, std::min(dtGrowthFactor * previousDt, dtMax), 1e-12);
+  }
+
+  // Less nodes than the uniform discretization
+  const auto uniformTime = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  ASSERT_LT(2 * time.size(), uniformTime.size());
+}
+
+TEST(test_discretization, growingStepsWithEvents) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_t dt = 0.01;
+  scalar_t dtGrowthFactor = 1.2;
+  scalar_t dtMax = 0.2;
+  scalar_array_t eventTimes{0.05, 0.5, 0.51};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, dt, dtGrowthFactor, dtMax, eventTimes);
+
+  // All events are part of the discretization
+  for (const auto eventTime : eventTimes) {
+    const auto preEventItr = std::find_if(time.begin(), time.end(), [&](const AnnotatedTime& t) { return t.time == eventTime; });
+    ASSERT_NE(preEventItr, time.end());
+    ASSERT_EQ(preEventItr->event, AnnotatedTime::Event::PreEvent);
+    ASSERT_EQ(std::next(preEventItr)->time, eventTime);
+    ASSERT_EQ(std::next(preEventItr)->event, AnnotatedTime::Event::PostEvent);
+  }
+
+  // The step after an event only depends on the event time
+  for (size_t i = 0; i + 1 < time.size(); i++) {
+    if (time[i].event == AnnotatedTime::Event::PostEvent && time[i + 1].event == AnnotatedTime::Event::None && i + 2 < time.size()) {
+      const scalar_t desiredDt = std::min(dt + (dtGrowthFactor - 1.0) * (time[i].time - initTime), dtMax);
+      ASSERT_NEAR(time[i + 1].time - time[i].time, desiredDt, 1e-12);
+    }
+  }
+}
+
+TEST(test_discretization, unitGrowthIsUniform) {
+  scalar_t initTime = 3.0;
+  scalar_t finalTime = 4.0;
+  scalar_t dt = 0.1;
+  scalar_array_t eventTimes{3.25, 3.4, 3.8999999999999999999, 4.02, 4.5};
+
+  const auto uniformTime = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  const auto time = timeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, 1.0, eventTimes);
+  ASSERT_EQ(time.size(), uniformTime.size());
+  for (size_t i = 0; i < time.size(); i++) {
+    ASSERT_EQ(time[i].time, uniformTime[i].time);
+    ASSERT_EQ(time[i].event, uniformTime[i].event);
+  }
+}
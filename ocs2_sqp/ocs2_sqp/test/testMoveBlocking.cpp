@@ -0,0 +1,248 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/MoveBlocking.h"
+#include "ocs2_sqp/MultipleShootingSolver.h"
+
+#include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+using namespace ocs2;
+
+namespace {
+
+scalar_t evaluate(const ScalarFunctionQuadraticApproximation& cost, const vector_t& x, const vector_t& u) {
+  scalar_t value = cost.f + cost.dfdx.dot(x) + 0.5 * x.dot(cost.dfdxx * x);
+  if (u.size() > 0) {
+    value += cost.dfdu.dot(u) + 0.5 * u.dot(cost.dfduu * u) + u.dot(cost.dfdux * x);
+  }
+  return value;
+}
+
+/** Initializes a time-varying input, which is not blocked */
+class SinusoidalInitializer final : public Initializer {
+ public:
+  explicit SinusoidalInitializer(size_t inputDim) : inputDim_(inputDim) {}
+  SinusoidalInitializer* clone() const override { return new SinusoidalInitializer(*this); }
+
+  void compute(scalar_t time, const vector_t& state, scalar_t nextTime, vector_t& input, vector_t& nextState) override {
+    input.setConstant(inputDim_, std::sin(10.0 * time));
+    nextState = state;
+  }
+
+ private:
+  SinusoidalInitializer(const SinusoidalInitializer& rhs) = default;
+
+  size_t inputDim_;
+};
+
+class MoveBlockingTest : public testing::Test {
+ protected:
+  static constexpr int nx = 3;
+  static constexpr int nu = 2;
+
+  MoveBlockingTest() {
+    // 9 nodes with an event at the 5th node
+    for (int i = 0; i < 9; i++) {
+      time.emplace_back(0.1 * i);
+    }
+    time[4].event = AnnotatedTime::Event::PreEvent;
+    time.insert(time.begin() + 5, AnnotatedTime(time[4].time, AnnotatedTime::Event::PostEvent));
+
+    const int N = static_cast<int>(time.size()) - 1;
+    for (int i = 0; i < N; i++) {
+      const int numInputs = (time[i].event == AnnotatedTime::Event::PreEvent) ? 0 : nu;
+      dynamics.push_back(getRandomDynamics(nx, numInputs));
+      cost.push_back(getRandomCost(nx, numInputs));
+      constraints.push_back(getRandomConstraints(nx, numInputs, 1));
+    }
+    cost.push_back(getRandomCost(nx, 0));
+    constraints.push_back(getRandomConstraints(nx, 0, 1));
+  }
+
+  std::vector<AnnotatedTime> time;
+  std::vector<VectorFunctionLinearApproximation> dynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> cost;
+  std::vector<VectorFunctionLinearApproximation> constraints;
+};
+
+constexpr int MoveBlockingTest::nx;
+constexpr int MoveBlockingTest::nu;
+
+}  // namespace
+
+TEST_F(MoveBlockingTest, pattern) {
+  // Nodes: 0, 1, 2, 3, 4 (event), 5, 6, 7, 8 and terminal node 9
+  const auto noBlocking = multiple_shooting::getMoveBlockingPattern(time, cost, 0.0, 1);
+  EXPECT_EQ(noBlocking, std::vector<bool>(9, false));
+
+  const auto isBlocked = multiple_shooting::getMoveBlockingPattern(time, cost, 0.0, 3);
+  const std::vector<bool> expected{false, true, true, false, false, false, true, true, false};
+  EXPECT_EQ(isBlocked, expected);
+
+  // Node times: 0.0, 0.1, 0.2, 0.3, 0.4 (event), 0.4, 0.5, 0.6, 0.7
+  const auto isBlockedLater = multiple_shooting::getMoveBlockingPattern(time, cost, 0.55, 2);
+  const std::vector<bool> expectedLater{false, false, false, false, false, false, false, true, false};
+  EXPECT_EQ(isBlockedLater, expectedLater);
+}
+
+TEST_F(MoveBlockingTest, equivalentProblem) {
+  const auto isBlocked = multiple_shooting::getMoveBlockingPattern(time, cost, 0.0, 3);
+  std::vector<VectorFunctionLinearApproximation> blockedDynamics;
+  std::vector<ScalarFunctionQuadraticApproximation> blockedCost;
+  std::vector<VectorFunctionLinearApproximation> blockedConstraints;
+  // Nominal inputs, which are not blocked
+  const int N = static_cast<int>(time.size()) - 1;
+  vector_array_t nominalU;
+  for (int i = 0; i < N; i++) {
+    nominalU.push_back(vector_t::Random(cost[i].dfdu.size()));
+  }
+  multiple_shooting::blockInputs(isBlocked, &nominalU, dynamics, cost, &constraints, blockedDynamics, blockedCost,
+                                 &blockedConstraints);
+
+  // Simulate the blocked problem with random inputs
+  vector_array_t blockedX{vector_t::Random(nx)};
+  vector_array_t blockedU;
+  scalar_t blockedCostValue = 0.0;
+  vector_array_t blockedConstraintValues;
+  for (int i = 0; i < N; i++) {
+    blockedU.push_back(vector_t::Random(blockedDynamics[i].dfdu.cols()));
+    blockedX.push_back(blockedDynamics[i].dfdx * blockedX[i] + blockedDynamics[i].dfdu * blockedU[i] + blockedDynamics[i].f);
+    blockedCostValue += evaluate(blockedCost[i], blockedX[i], blockedU[i]);
+    blockedConstraintValues.push_back(blockedConstraints[i].dfdx * blockedX[i] + blockedConstraints[i].dfdu * blockedU[i] +
+                                      blockedConstraints[i].f);
+  }
+  blockedCostValue += evaluate(blockedCost[N], blockedX[N], vector_t());
+
+  // Blocked nodes have no input
+  for (int i = 0; i < N; i++) {
+    EXPECT_EQ(blockedU[i].size(), isBlocked[i] ? 0 : cost[i].dfdu.size());
+  }
+
+  // Expanded solution is feasible for the original problem, with the same cost and constraints
+  vector_array_t x = blockedX;
+  vector_array_t u = blockedU;
+  multiple_shooting::expandBlockedSolution(isBlocked, cost, x, u);
+  scalar_t costValue = 0.0;
+  for (int i = 0; i < N; i++) {
+    ASSERT_EQ(x[i].size(), nx);
+    ASSERT_EQ(u[i].size(), cost[i].dfdu.size());
+    if (isBlocked[i]) {
+      // The full step ties the inputs, not only the increments
+      EXPECT_TRUE((nominalU[i] + u[i]).isApprox(nominalU[i - 1] + u[i - 1]));
+    }
+    const vector_t xNext = dynamics[i].dfdx * x[i] + dynamics[i].dfdu * u[i] + dynamics[i].f;
+    EXPECT_TRUE(xNext.isApprox(x[i + 1]));
+    costValue += evaluate(cost[i], x[i], u[i]);
+    const vector_t constraintValue = constraints[i].dfdx * x[i] + constraints[i].dfdu * u[i] + constraints[i].f;
+    EXPECT_TRUE(constraintValue.isApprox(blockedConstraintValues[i]));
+  }
+  costValue += evaluate(cost[N], x[N], vector_t());
+  EXPECT_NEAR(costValue, blockedCostValue, 1e-9);
+}
+
+TEST(MoveBlocking, minimizeOverBlockedInput) {
+  const int nx = 3;
+  const int nu = 2;
+  const auto randomCost = getRandomCost(nx + nu, 0);
+  ScalarFunctionQuadraticApproximation costToGo;
+  costToGo.dfdxx = randomCost.dfdxx + matrix_t::Identity(nx + nu, nx + nu);
+  costToGo.dfdx = randomCost.dfdx;
+  costToGo.f = randomCost.f;
+
+  const auto minimizedCostToGo = multiple_shooting::minimizeOverBlockedInput(costToGo, nx);
+
+  // The minimizer has zero gradient with respect to the held input
+  const vector_t x = vector_t::Random(nx);
+  const matrix_t Vuu = costToGo.dfdxx.bottomRightCorner(nu, nu);
+  const vector_t uOpt = -Vuu.ldlt().solve(costToGo.dfdxx.bottomLeftCorner(nu, nx) * x + costToGo.dfdx.tail(nu));
+  vector_t xu(nx + nu);
+  xu << x, uOpt;
+
+  const scalar_t expectedValue = evaluate(costToGo, xu, vector_t());
+  EXPECT_NEAR(evaluate(minimizedCostToGo, x, vector_t()), expectedValue, 1e-9);
+  for (int i = 0; i < 5; i++) {
+    xu.tail(nu) = uOpt + 1e-3 * vector_t::Random(nu);
+    EXPECT_GT(evaluate(costToGo, xu, vector_t()), expectedValue);
+  }
+}
+
+TEST(MoveBlocking, solverTiesTheInputs) {
+  const int nx = 3;
+  const int nu = 2;
+  const size_t blockSize = 3;
+
+  OptimalControlProblem problem;
+  problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+  const auto cost = getRandomCost(nx, nu);
+  problem.costPtr->add("intermediateCost", getOcs2Cost(cost));
+  problem.finalCostPtr->add("finalCost", getOcs2StateCost(cost));
+
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Ones(nx)}, {vector_t::Ones(nu)});
+  std::shared_ptr<ReferenceManager> referenceManagerPtr(new ReferenceManager(targetTrajectories));
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  multiple_shooting::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.moveBlockingStartTime = 0.32;  // between two nodes
+  settings.moveBlockingBlockSize = blockSize;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  // The initial guess is not blocked
+  MultipleShootingSolver solver(settings, problem, SinusoidalInitializer(nu));
+  solver.setReferenceManager(referenceManagerPtr);
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  solver.run(startTime, vector_t::Ones(nx), finalTime);
+
+  // The inputs within each block are equal, the last input is a copy of the previous one
+  const auto primalSolution = solver.primalSolution(finalTime);
+  const auto& time = primalSolution.timeTrajectory_;
+  const auto& input = primalSolution.inputTrajectory_;
+  size_t numNodesInBlock = 1;
+  size_t numBlockedNodes = 0;
+  for (size_t i = 1; i + 1 < time.size(); i++) {
+    if (time[i] - startTime >= settings.moveBlockingStartTime && numNodesInBlock < blockSize) {
+      EXPECT_TRUE(input[i].isApprox(input[i - 1], 1e-6)) << "at node " << i;
+      ++numNodesInBlock;
+      ++numBlockedNodes;
+    } else {
+      numNodesInBlock = 1;
+    }
+  }
+  EXPECT_GT(numBlockedNodes, 0);
+}
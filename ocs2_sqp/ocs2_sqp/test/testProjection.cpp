@@ -61,4 +61,41 @@ TEST(test_projection, testProjectionLU) {
 
   // D * Pe cancels the e term
   ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
-}
\ No newline at end of file
+}
+TEST(test_projection, testProjectorMatchesProjection) {
+  const auto constraint = ocs2::getRandomConstraints(30, 20, 10);
+
+  for (const auto method : {ocs2::ConstraintProjector::Method::LU, ocs2::ConstraintProjector::Method::QR}) {
+    ocs2::ConstraintProjector projector(method);
+    ocs2::VectorFunctionLinearApproximation projection;
+    projector.computeProjection(constraint, projection);
+
+    ASSERT_TRUE((constraint.dfdu * projection.dfdu).isZero());
+    ASSERT_TRUE((constraint.dfdx + constraint.dfdu * projection.dfdx).isZero());
+    ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
+  }
+}
+
+TEST(test_projection, testProjectorReuse) {
+  auto constraint = ocs2::getRandomConstraints(30, 20, 10);
+
+  ocs2::ConstraintProjector projector(ocs2::ConstraintProjector::Method::LU, true);
+  ocs2::VectorFunctionLinearApproximation projection;
+  projector.computeProjection(constraint, projection);
+  ASSERT_EQ(projector.getNumReusedFactorizations(), 0);
+
+  // Same D, different C and e: the factorization is reused and the projection is still exact
+  constraint.dfdx.setRandom();
+  constraint.f.setRandom();
+  projector.computeProjection(constraint, projection);
+  ASSERT_EQ(projector.getNumReusedFactorizations(), 1);
+  ASSERT_TRUE((constraint.dfdx + constraint.dfdu * projection.dfdx).isZero());
+  ASSERT_TRUE((constraint.f + constraint.dfdu * projection.f).isZero());
+
+  // Changed D: a new factorization is computed
+  constraint.dfdu.setRandom();
+  projector.computeProjection(constraint, projection);
+  ASSERT_EQ(projector.getNumReusedFactorizations(), 1);
+  ASSERT_TRUE((constraint.dfdu * projection.dfdu).isZero());
+  ASSERT_TRUE((constraint.dfdx + constraint.dfdu * projection.dfdx).isZero());
+}